@@ -517,10 +517,14 @@ def _get_common_lib_ext(include_dirs, share_lib_dir):
     libgpilog_sources = [os.path.join(share_lib_dir, "gpi_log", "gpi_logging.cpp")]
     if os.name == "nt":
         libgpilog_sources += ["libgpilog.rc"]
+    libgpilog_libraries = []
+    if sys.platform.startswith(("linux", "darwin", "cygwin", "msys")):
+        libgpilog_libraries.append("pthread")  # std::thread
     libgpilog = Extension(
         os.path.join("cocotb", "libs", "libgpilog"),
         define_macros=[("GPILOG_EXPORTS", "")] + _extra_defines,
         include_dirs=include_dirs,
+        libraries=libgpilog_libraries,
         sources=libgpilog_sources,
     )
 
@@ -575,9 +579,14 @@ def _get_common_lib_ext(include_dirs, share_lib_dir):
     libgpi_sources = [
         os.path.join(share_lib_dir, "gpi", "GpiCbHdl.cpp"),
         os.path.join(share_lib_dir, "gpi", "GpiCommon.cpp"),
+        os.path.join(share_lib_dir, "gpi", "GpiProfiler.cpp"),
+        os.path.join(share_lib_dir, "gpi", "GpiWorkerPool.cpp"),
     ]
     if os.name == "nt":
         libgpi_sources += ["libgpi.rc"]
+    libgpi_libraries = ["cocotbutils", "gpilog", "embed"]
+    if sys.platform.startswith(("linux", "darwin", "cygwin", "msys")):
+        libgpi_libraries.append("pthread")  # std::thread
     libgpi = Extension(
         os.path.join("cocotb", "libs", "libgpi"),
         define_macros=[
@@ -587,10 +596,27 @@ def _get_common_lib_ext(include_dirs, share_lib_dir):
         ]
         + _extra_defines,
         include_dirs=include_dirs,
-        libraries=["cocotbutils", "gpilog", "embed"],
+        libraries=libgpi_libraries,
         sources=libgpi_sources,
     )
 
+    #
+    #  libcocotbshmbridge
+    #
+    libs_posix = []
+    if os.name != "nt":
+        libshmbridge_libraries = ["gpi", "gpilog"]
+        if sys.platform == "linux":
+            libshmbridge_libraries.append("rt")  # shm_open, shm_unlink
+        libshmbridge = Extension(
+            os.path.join("cocotb", "libs", "libcocotbshmbridge"),
+            define_macros=_extra_defines,
+            include_dirs=include_dirs,
+            libraries=libshmbridge_libraries,
+            sources=[os.path.join(share_lib_dir, "shm_bridge", "ShmBridge.cpp")],
+        )
+        libs_posix.append(libshmbridge)
+
     #
     #  simulator
     #
@@ -611,7 +637,15 @@ def _get_common_lib_ext(include_dirs, share_lib_dir):
     # The libraries in this list are compiled in order of their appearance.
     # If there is a linking dependency on one library to another,
     # the linked library must be built first.
-    return [libgpilog, libpygpilog, libcocotbutils, libembed, libgpi, libcocotb, libsim]
+    return [
+        libgpilog,
+        libpygpilog,
+        libcocotbutils,
+        libembed,
+        libgpi,
+        libcocotb,
+        libsim,
+    ] + libs_posix
 
 
 def _get_vpi_lib_ext(
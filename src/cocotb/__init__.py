@@ -45,7 +45,11 @@ import cocotb.triggers
 from cocotb._scheduler import Scheduler
 from cocotb._utils import DocEnum
 from cocotb.logging import default_config
-from cocotb.regression import RegressionManager, RegressionMode
+from cocotb.regression import (
+    RegressionManager,
+    RegressionMode,
+    _read_test_durations,
+)
 from cocotb.result import TestSuccess
 
 from ._version import __version__
@@ -134,6 +138,7 @@ sim_phase: SimPhase = SimPhase.NORMAL
 
 def _setup_logging() -> None:
     default_config()
+    cocotb.logging._setup_gpi_log_level_sync()
     global log
     log = py_logging.getLogger(__name__)
 
@@ -522,3 +527,13 @@ def _setup_regression_manager() -> None:
     elif test_filter_str:
         regression_manager.add_filters(test_filter_str)
         regression_manager.set_mode(RegressionMode.TESTCASE)
+
+    # select the shard of the tests run by this simulation
+    shard_count_str = os.getenv("COCOTB_SHARD_COUNT", "").strip()
+    if shard_count_str:
+        durations_file = os.getenv("COCOTB_SHARD_DURATIONS", "").strip()
+        regression_manager.set_shard(
+            index=int(os.getenv("COCOTB_SHARD_INDEX", "0")),
+            count=int(shard_count_str),
+            durations=_read_test_durations(durations_file) if durations_file else {},
+        )
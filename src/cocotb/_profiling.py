@@ -4,14 +4,15 @@
 
 
 # Debug mode controlled by environment variables
-import cProfile
 import os
-import pstats
-from typing import Union
+from typing import TYPE_CHECKING, Union
 
 from cocotb._py_compat import nullcontext
 
-_profile: Union[cProfile.Profile, None]
+if TYPE_CHECKING:
+    import cProfile
+
+_profile: Union["cProfile.Profile", None]
 
 
 class _profiling_context:
@@ -25,6 +26,10 @@ class _profiling_context:
 
 
 if "COCOTB_ENABLE_PROFILING" in os.environ:
+    # Only imported when profiling, to keep them out of the startup time
+    import cProfile
+    import pstats
+
     _profile = cProfile.Profile()
 
     def finalize() -> None:
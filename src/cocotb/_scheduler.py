@@ -38,11 +38,11 @@ import logging
 import os
 import threading
 from collections import OrderedDict
-from typing import Any, Callable, Dict
+from typing import Any, Callable, Dict, List
 
 import cocotb
 import cocotb._write_scheduler
-from cocotb import _outcomes, _py_compat
+from cocotb import _outcomes, _py_compat, simulator
 from cocotb._exceptions import InternalError
 from cocotb._profiling import profiling_context
 from cocotb.task import Task
@@ -60,6 +60,11 @@ from cocotb.triggers import (
 # make any calls by testing a boolean flag first
 _debug = "COCOTB_SCHEDULER_DEBUG" in os.environ
 
+_batch_triggers = bool(int(os.environ.get("COCOTB_BATCH_TRIGGERS", "0")))
+
+# Triggers and tasks are profiled along with the GPI, see GPI_PROFILE_FILE
+_profile = simulator.is_profile_enabled()
+
 
 class external_state:
     INIT = 0
@@ -237,6 +242,9 @@ class Scheduler:
 
         self._current_task = None
 
+        if _batch_triggers:
+            simulator.set_callback_batching(self._sim_react, self._sim_react_batch)
+
     def _handle_termination(self) -> None:
         """
         Handle a termination that causes us to move onto the next test.
@@ -275,7 +283,33 @@ class Scheduler:
             if trigger is self._read_write:
                 cocotb._write_scheduler.apply_scheduled_writes()
 
-            self._react(trigger)
+            if _profile:
+                simulator.profile_begin(str(trigger), "trigger")
+                try:
+                    self._react(trigger)
+                finally:
+                    simulator.profile_end()
+            else:
+                self._react(trigger)
+            self._event_loop()
+
+    def _sim_react_batch(self, triggers: List[Trigger]) -> None:
+        """Called when several edge triggers fire together, see :envvar:`COCOTB_BATCH_TRIGGERS`.
+
+        The tasks waiting on all of the triggers are queued before the event loop is
+        entered once for the whole batch.
+        """
+        with profiling_context:
+            cocotb.sim_phase = cocotb.SimPhase.NORMAL
+            for trigger in triggers:
+                if _profile:
+                    simulator.profile_begin(str(trigger), "trigger")
+                    try:
+                        self._react(trigger)
+                    finally:
+                        simulator.profile_end()
+                else:
+                    self._react(trigger)
             self._event_loop()
 
     def _react(self, trigger: Trigger) -> None:
@@ -333,7 +367,16 @@ class Scheduler:
 
             if _debug:
                 self.log.debug(f"Scheduling task {task}")
-            self._resume_task(task, outcome)
+            if _profile:
+                simulator.profile_begin(
+                    f"{task.__name__} {task._coro.__qualname__}", "task"
+                )
+                try:
+                    self._resume_task(task, outcome)
+                finally:
+                    simulator.profile_end()
+            else:
+                self._resume_task(task, outcome)
             if _debug:
                 self.log.debug(f"Scheduled task {task}")
 
@@ -2,22 +2,20 @@
 # Licensed under the Revised BSD License, see LICENSE for details.
 # SPDX-License-Identifier: BSD-3-Clause
 import os
-from collections import OrderedDict
-from typing import Any, Callable, Dict, Sequence, Tuple, Union
+from typing import Any, Callable, Sequence, Union
 
 import cocotb
 import cocotb.handle
 import cocotb.task
+from cocotb import simulator
 from cocotb.triggers import Event, ReadWrite
 
 trust_inertial = bool(int(os.environ.get("COCOTB_TRUST_INERTIAL_WRITES", "0")))
 
-# A dictionary of pending (write_func, args), keyed by handle.
-# Writes are applied oldest to newest (least recently used).
-# Only the last scheduled write to a particular handle in a timestep is performed.
-_write_calls: Dict[
-    cocotb.handle.SimHandleBase, Tuple[Callable[..., None], Sequence[Any]]
-] = OrderedDict()
+# Pending writes are queued in the GPI, keyed by handle, by the queue_* method of
+# the gpi_sim_hdl passed along with each write function.
+# Only the last scheduled write to a particular handle in a timestep is performed,
+# and writes are applied oldest to newest (least recently used).
 
 # TODO don't use a task to force ReadWrite, just prime an empty callback
 
@@ -44,14 +42,12 @@ def stop_write_scheduler() -> None:
     if _write_task is not None:
         _write_task.kill()
         _write_task = None
-    _write_calls.clear()
+    simulator.clear_queued_writes()
     _writes_pending.clear()
 
 
 def apply_scheduled_writes() -> None:
-    while _write_calls:
-        _, (func, args) = _write_calls.popitem(last=False)
-        func(*args)
+    simulator.apply_queued_writes()
     _writes_pending.clear()
 
 
@@ -60,6 +56,7 @@ if trust_inertial:
     def schedule_write(
         handle: cocotb.handle.SimHandleBase,
         write_func: Callable[..., None],
+        queue_func: Callable[..., None],
         args: Sequence[Any],
     ) -> None:
         write_func(*args)
@@ -68,9 +65,14 @@ else:
     def schedule_write(
         handle: cocotb.handle.SimHandleBase,
         write_func: Callable[..., None],
+        queue_func: Callable[..., None],
         args: Sequence[Any],
     ) -> None:
-        """Queue *write_func* to be called on the next ``ReadWrite`` trigger."""
+        """Queue a write to be done on the next ``ReadWrite`` trigger.
+
+        The write is done by *write_func* straight away in the ``ReadWrite`` phase,
+        and otherwise queued in the GPI by *queue_func*, which takes the same *args*.
+        """
         if cocotb.sim_phase == cocotb.SimPhase.READ_WRITE:
             write_func(*args)
         elif cocotb.sim_phase == cocotb.SimPhase.READ_ONLY:
@@ -78,7 +80,5 @@ else:
                 f"Write to object {handle._name} was scheduled during a read-only sync phase."
             )
         else:
-            if handle in _write_calls:
-                del _write_calls[handle]
-            _write_calls[handle] = (write_func, args)
+            queue_func(*args)
             _writes_pending.set()
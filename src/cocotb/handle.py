@@ -54,12 +54,33 @@ from cocotb._utils import cached_method
 from cocotb.types import Array, Logic, LogicArray, Range
 
 
+#: Type of the function scheduling the writes of a handle, called as
+#: ``schedule_write(handle, write_func, queue_func, args)`` with the ``set_*`` and
+#: matching ``queue_*`` methods of its ``gpi_sim_hdl``.
+_ScheduleWriteT = Callable[
+    [
+        "ValueObjectBase[Any, Any]",
+        Callable[..., None],
+        Callable[..., None],
+        Sequence[Any],
+    ],
+    None,
+]
+
+
 def _write_now(
-    _: "ValueObjectBase[Any, Any]", f: Callable[..., None], args: Any
+    _: "ValueObjectBase[Any, Any]",
+    f: Callable[..., None],
+    queue_f: Callable[..., None],
+    args: Any,
 ) -> None:
     f(*args)
 
 
+# number of child names fetched from the simulator at once when discovering keys
+_DISCOVER_BATCH_SIZE = 256
+
+
 class _Limits(enum.IntEnum):
     SIGNED_NBIT = 1
     UNSIGNED_NBIT = 2
@@ -228,15 +249,18 @@ class HierarchyObjectBase(SimHandleBase, Generic[KeyType]):
     def __init__(self, handle: simulator.gpi_sim_hdl, path: Optional[str]) -> None:
         super().__init__(handle, path)
         self._sub_handles: Dict[KeyType, SimHandleBase] = {}
+        # keys of all child objects, including those without a handle yet
+        self._sub_keys: Dict[KeyType, None] = {}
         self._discovered = False
+        self._keys_discovered = False
 
     def _keys(self) -> Iterable[KeyType]:
         """Iterate over the keys (name or index) of the child objects.
 
         :meta public:
         """
-        self._discover_all()
-        return self._sub_handles.keys()
+        self._discover_keys()
+        return self._sub_keys.keys()
 
     def _values(self) -> Iterable[SimHandleBase]:
         """Iterate over the child objects.
@@ -291,7 +315,51 @@ class HierarchyObjectBase(SimHandleBase, Generic[KeyType]):
             # add to cache
             self._sub_handles[key] = hdl
 
+        self._sub_keys = dict.fromkeys(self._sub_handles)
         self._discovered = True
+        self._keys_discovered = True
+
+    def _discover_keys(self) -> None:
+        """Like :meth:`_discover_all`, but only discover the keys of the children.
+
+        The handles of the children are only created when they are accessed,
+        which makes listing the children of large scopes much cheaper.
+        If the type of a child is not known without creating its handle,
+        all the children are discovered with :meth:`_discover_all` instead,
+        so only the keys of children which can be created are listed.
+        """
+        if self._keys_discovered:
+            return
+
+        iterator = self._handle.iterate(simulator.OBJECTS)
+        while True:
+            names = iterator.next_names(_DISCOVER_BATCH_SIZE)
+
+            for name, type_ in names:
+                if type_ == simulator.UNKNOWN:
+                    self._discover_all()
+                    return
+
+                # skip objects that could not be constructed by SimHandle()
+                if type_ not in _type2cls:
+                    continue
+
+                # translate HDL name into a consistent key name
+                try:
+                    key = self._sub_handle_key(name)
+                except ValueError:
+                    self._log.exception(
+                        "Unable to translate handle >%s< to a valid _sub_handle key",
+                        name,
+                    )
+                    continue
+
+                self._sub_keys[key] = None
+
+            if len(names) < _DISCOVER_BATCH_SIZE:
+                break
+
+        self._keys_discovered = True
 
     def __getitem__(self, key: KeyType) -> SimHandleBase:
         # try to use cached value
@@ -308,6 +376,7 @@ class HierarchyObjectBase(SimHandleBase, Generic[KeyType]):
         # if successful, construct and cache
         sub_handle = SimHandle(new_handle, self._child_path(key))
         self._sub_handles[key] = sub_handle
+        self._sub_keys[key] = None
 
         return sub_handle
 
@@ -351,12 +420,11 @@ class HierarchyObjectBase(SimHandleBase, Generic[KeyType]):
         return iter(self._values())
 
     def __len__(self) -> int:
-        self._discover_all()
-        return len(self._sub_handles)
+        self._discover_keys()
+        return len(self._sub_keys)
 
     def __dir__(self) -> Iterable[str]:
         """Permits IPython tab completion and debuggers to work."""
-        self._discover_all()
         return set(super().__dir__()) | {str(k) for k in self._keys()}
 
 
@@ -715,9 +783,7 @@ class ValueObjectBase(SimHandleBase, Generic[ValuePropertyT, ValueSetT]):
         self,
         value: ValueSetT,
         action: _GPISetAction,
-        schedule_write: Callable[
-            ["ValueObjectBase[Any, Any]", Callable[..., None], Sequence[Any]], None
-        ],
+        schedule_write: _ScheduleWriteT,
     ) -> None:
         """Schedule a write of the given value to a simulator object.
 
@@ -727,7 +793,8 @@ class ValueObjectBase(SimHandleBase, Generic[ValuePropertyT, ValueSetT]):
         Args:
             value: A value used to set the handle.
             action: Whether to deposit, force, or release the value on the handle.
-            schedule_write: A function which takes ``(handle, callback, args)`` to schedule the writes.
+            schedule_write: A function which takes
+                ``(handle, write_func, queue_func, args)`` to schedule the writes.
         """
 
 
@@ -819,9 +886,7 @@ class ArrayObject(
         self,
         value: Union[Array[ElemValueT], Sequence[ElemValueT]],
         action: _GPISetAction,
-        schedule_write: Callable[
-            [ValueObjectBase[Any, Any], Callable[..., None], Sequence[Any]], None
-        ],
+        schedule_write: _ScheduleWriteT,
     ) -> None:
         if len(value) != len(self):
             raise ValueError(
@@ -877,9 +942,7 @@ class LogicObject(
         self,
         value: Union[LogicArray, Logic, int, str],
         action: _GPISetAction,
-        schedule_write: Callable[
-            [ValueObjectBase[Any, Any], Callable[..., None], Sequence[Any]], None
-        ],
+        schedule_write: _ScheduleWriteT,
     ) -> None:
         value_: str
         if isinstance(value, int):
@@ -887,25 +950,18 @@ class LogicObject(
             if min_val <= value <= max_val:
                 if len(self) <= 32:
                     schedule_write(
-                        self, self._handle.set_signal_val_int, (action, value)
+                        self,
+                        self._handle.set_signal_val_int,
+                        self._handle.queue_signal_val_int,
+                        (action, value),
                     )
                     return
 
-                # LogicArray used for checking
-                if value < 0:
-                    value_ = str(
-                        LogicArray.from_signed(
-                            value,
-                            Range(len(self) - 1, "downto", 0),
-                        )
-                    )
-                else:
-                    value_ = str(
-                        LogicArray.from_unsigned(
-                            value,
-                            Range(len(self) - 1, "downto", 0),
-                        )
-                    )
+                # masking gives the two's complement of negative values
+                self._set_packed_value(
+                    value & ((1 << len(self)) - 1), action, schedule_write
+                )
+                return
             else:
                 raise OverflowError(
                     f"Int value ({value!r}) out of range for assignment of {len(self)!r}-bit signal ({self._name!r})"
@@ -920,6 +976,9 @@ class LogicObject(
                 raise ValueError(
                     f"cannot assign value of length {len(value)} to handle of length {len(self)}"
                 )
+            if value._value_as_int is not None:
+                self._set_packed_value(value._value_as_int, action, schedule_write)
+                return
             value_ = str(value)
 
         elif isinstance(value, Logic):
@@ -934,7 +993,27 @@ class LogicObject(
                 f"Unsupported type for value assignment: {type(value)} ({value!r})"
             )
 
-        schedule_write(self, self._handle.set_signal_val_binstr, (action, value_))
+        schedule_write(
+            self,
+            self._handle.set_signal_val_binstr,
+            self._handle.queue_signal_val_binstr,
+            (action, value_),
+        )
+
+    def _set_packed_value(
+        self,
+        value: int,
+        action: _GPISetAction,
+        schedule_write: _ScheduleWriteT,
+    ) -> None:
+        # Writes a non-negative int with no X or Z bits, which is packed
+        # straight into the reused C buffer
+        schedule_write(
+            self,
+            self._handle.set_signal_val_bytes,
+            self._handle.queue_signal_val_bytes,
+            (action, len(self), value),
+        )
 
     @property
     def value(self) -> LogicArray:
@@ -966,13 +1045,20 @@ class LogicObject(
             Convert the dictionary to an integer before assignment using
             ``sum(v << (d['bits'] * i) for i, v in enumerate(d['values']))`` instead.
         """
-        binstr = self._handle.get_signal_val_binstr()
-        return LogicArray._from_handle(binstr)
+        # an int if there are no X or Z bits, otherwise the binary string
+        value = self._logic_accessor()
+        if isinstance(value, int):
+            return LogicArray._from_handle_int(value, len(self))
+        return LogicArray._from_handle(value)
 
     @value.setter
     def value(self, value: LogicArray) -> None:
         self.set(value)
 
+    @cached_property
+    def _logic_accessor(self) -> simulator.GpiValueAccessor:
+        return self._handle.get_accessor(simulator.ACCESS_LOGIC)
+
     @deprecated(
         "`int(handle)` casts have been deprecated. Use `int(handle.value)` instead."
     )
@@ -1005,16 +1091,19 @@ class RealObject(ValueObjectBase[float, float]):
         self,
         value: float,
         action: _GPISetAction,
-        schedule_write: Callable[
-            [ValueObjectBase[Any, Any], Callable[..., None], Sequence[Any]], None
-        ],
+        schedule_write: _ScheduleWriteT,
     ) -> None:
         if not isinstance(value, (float, int)):
             raise TypeError(
                 f"Unsupported type for real value assignment: {type(value)} ({value!r})"
             )
 
-        schedule_write(self, self._handle.set_signal_val_real, (action, value))
+        schedule_write(
+            self,
+            self._handle.set_signal_val_real,
+            self._handle.queue_signal_val_real,
+            (action, value),
+        )
 
     @property
     def value(self) -> float:
@@ -1055,9 +1144,7 @@ class EnumObject(ValueObjectBase[int, int]):
         self,
         value: int,
         action: _GPISetAction,
-        schedule_write: Callable[
-            [ValueObjectBase[Any, Any], Callable[..., None], Sequence[Any]], None
-        ],
+        schedule_write: _ScheduleWriteT,
     ) -> None:
         if not isinstance(value, int):
             raise TypeError(
@@ -1066,7 +1153,12 @@ class EnumObject(ValueObjectBase[int, int]):
 
         min_val, max_val = _value_limits(32, _Limits.UNSIGNED_NBIT)
         if min_val <= value <= max_val:
-            schedule_write(self, self._handle.set_signal_val_int, (action, value))
+            schedule_write(
+                self,
+                self._handle.set_signal_val_int,
+                self._handle.queue_signal_val_int,
+                (action, value),
+            )
         else:
             raise OverflowError(
                 f"Int value ({value!r}) out of range for assignment of enum signal ({self._name!r})"
@@ -1128,9 +1220,7 @@ class IntegerObject(ValueObjectBase[int, int]):
         self,
         value: int,
         action: _GPISetAction,
-        schedule_write: Callable[
-            [ValueObjectBase[Any, Any], Callable[..., None], Sequence[Any]], None
-        ],
+        schedule_write: _ScheduleWriteT,
     ) -> None:
         if not isinstance(value, int):
             raise TypeError(
@@ -1139,7 +1229,12 @@ class IntegerObject(ValueObjectBase[int, int]):
 
         min_val, max_val = _value_limits(32, _Limits.SIGNED_NBIT)
         if min_val <= value <= max_val:
-            schedule_write(self, self._handle.set_signal_val_int, (action, value))
+            schedule_write(
+                self,
+                self._handle.set_signal_val_int,
+                self._handle.queue_signal_val_int,
+                (action, value),
+            )
         else:
             raise OverflowError(
                 f"Int value ({value!r}) out of range for assignment of integer signal ({self._name!r})"
@@ -1189,16 +1284,19 @@ class StringObject(
         self,
         value: bytes,
         action: _GPISetAction,
-        schedule_write: Callable[
-            [ValueObjectBase[Any, Any], Callable[..., None], Sequence[Any]], None
-        ],
+        schedule_write: _ScheduleWriteT,
     ) -> None:
         if not isinstance(value, bytes):
             raise TypeError(
                 f"Unsupported type for string value assignment: {type(value)} ({value!r})"
             )
 
-        schedule_write(self, self._handle.set_signal_val_str, (action, value))
+        schedule_write(
+            self,
+            self._handle.set_signal_val_str,
+            self._handle.queue_signal_val_str,
+            (action, value),
+        )
 
     @property
     def value(self) -> bytes:
@@ -113,13 +113,62 @@ def default_config():
     logging.getLogger("gpi").setLevel(level)
 
 
+def _gpi_log_level() -> int:
+    """The lowest level at which the ``gpi`` logger is enabled."""
+    return max(
+        logging.getLogger("gpi").getEffectiveLevel(),
+        logging.root.manager.disable + 1,
+    )
+
+
+def _update_gpi_log_level() -> None:
+    # The GPI keeps a copy of the level of the ``gpi`` logger to drop
+    # disabled messages without calling into Python.
+    simulator.log_level(_gpi_log_level())
+
+
 class SimBaseLog(logging.getLoggerClass()):
     """This class only exists for backwards compatibility"""
 
     def setLevel(self, level: typing.Union[int, str]) -> None:
         super().setLevel(level)
-        if self.name == "gpi":
-            simulator.log_level(self.getEffectiveLevel())
+        # The level of any logger can be inherited by ``gpi``, so always update it
+        _update_gpi_log_level()
+
+
+class _SimRootLogger(logging.RootLogger):
+    """The root logger, which ``gpi`` inherits its level from if it has none."""
+
+    def setLevel(self, level: typing.Union[int, str]) -> None:
+        super().setLevel(level)
+        _update_gpi_log_level()
+
+
+class _SimManager(logging.Manager):
+    """The logging manager, whose :attr:`disable` is set by :func:`logging.disable`."""
+
+    @property
+    def disable(self) -> int:
+        return self.__dict__.get("disable", 0)
+
+    @disable.setter
+    def disable(self, level: int) -> None:
+        self.__dict__["disable"] = level
+        _update_gpi_log_level()
+
+
+def _setup_gpi_log_level_sync() -> None:
+    """Keep the copy of the ``gpi`` log level in the GPI up to date.
+
+    The level is that of the ``gpi`` logger, inherited from the root logger if it
+    has none, unless :func:`logging.disable` disables it.
+    The cocotb loggers are :class:`SimBaseLog`, and the root logger and the logging
+    manager are turned into subclasses telling the GPI when those change.
+    Handlers and filters are applied by Python, so don't affect the level.
+    """
+    logging.root.__class__ = _SimRootLogger
+    logging.Logger.manager.__class__ = _SimManager
+    _update_gpi_log_level()
 
 
 # this used to be a class, hence the unusual capitalization
@@ -149,8 +198,9 @@ class SimTimeContextFilter(logging.Filter):
     def filter(self, record):
         try:
             record.created_sim_time = get_sim_time()
-        except RecursionError:
-            # get_sim_time may try to log - if that happens, we can't
+        except RuntimeError:
+            # get_sim_time may try to log, or be called from a thread other
+            # than the one running cocotb - if that happens, we can't
             # attach a simulator time to this message.
             record.created_sim_time = None
         return True
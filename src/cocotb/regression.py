@@ -32,11 +32,12 @@ import hashlib
 import inspect
 import logging
 import os
-import pdb
 import random
 import re
 import time
 import warnings
+import xml.etree.ElementTree as ET
+from contextlib import suppress
 from enum import auto
 from importlib import import_module
 from itertools import product
@@ -47,6 +48,7 @@ from typing import (
     Dict,
     Generic,
     List,
+    Mapping,
     Optional,
     Sequence,
     Type,
@@ -195,6 +197,27 @@ class Test:
         self.fullname = f"{self.module}.{self.name}"
 
 
+def _read_test_durations(results_file: str) -> Dict[str, float]:
+    """Read the wall time of the tests recorded in an xUnit results file.
+
+    Tests which were skipped are left out.
+    If *results_file* does not exist, no durations are returned.
+    """
+    try:
+        tree = ET.parse(results_file)
+    except FileNotFoundError:
+        return {}
+    durations: Dict[str, float] = {}
+    for testcase in tree.iter("testcase"):
+        wall_time_s = testcase.get("time")
+        if wall_time_s is None or testcase.find("skipped") is not None:
+            continue
+        with suppress(ValueError):
+            name = f"{testcase.get('classname')}.{testcase.get('name')}"
+            durations[name] = float(wall_time_s)
+    return durations
+
+
 def _format_doc(docstring: Union[str, None]) -> str:
     if docstring is None:
         return ""
@@ -224,6 +247,7 @@ class RegressionManager:
     Tests are added using :meth:`register_test` or :meth:`discover_tests`.
     Inclusion filters for tests can be added using :meth:`add_filters`.
     The "mode" of the regression can be controlled using :meth:`set_mode`.
+    A share of the tests to run in parallel with other simulations can be selected using :meth:`set_shard`.
     These methods can be called in any order any number of times before :meth:`start_regression` is called,
     and should not be called again after that.
 
@@ -260,7 +284,11 @@ class RegressionManager:
         self._test_queue: List[Test] = []
         self._filters: List[re.Pattern[str]] = []
         self._mode = RegressionMode.REGRESSION
+        self._shard_index = 0
+        self._shard_count = 1
+        self._shard_durations: Mapping[str, float] = {}
         self._included: List[bool]
+        self._in_shard: List[bool]
         self._sim_failure: Union[SimFailure, None] = None
 
         # Setup XUnit
@@ -328,6 +356,37 @@ class RegressionManager:
         """
         self._mode = mode
 
+    def set_shard(
+        self, index: int, count: int, durations: Mapping[str, float] = {}
+    ) -> None:
+        """Only run one of *count* shares of the tests.
+
+        The included tests are split into *count* shards of about the same duration,
+        so the regression can be run by *count* simulations in parallel, each with a different *index*.
+        Tests are balanced using their *durations* in seconds, by full test name,
+        and those without one are assumed to take as long as the average test.
+        The split only depends on the tests and *durations*, so is the same in each simulation.
+
+        Tests excluded by the filters are only recorded by the shard with *index* 0.
+        Should be called before :meth:`start_regression` is called.
+
+        Args:
+            index: The shard to run, from 0 to *count* - 1.
+            count: The number of shards.
+            durations: The duration of the tests in an earlier run,
+                as read from its results file with :envvar:`COCOTB_SHARD_DURATIONS`.
+
+        Raises:
+            ValueError: If *index* is not a shard of *count*.
+
+        .. versionadded:: 2.0
+        """
+        if count < 1 or not 0 <= index < count:
+            raise ValueError(f"Shard {index} is not one of {count} shards")
+        self._shard_index = index
+        self._shard_count = count
+        self._shard_durations = durations
+
     def register_test(self, test: Test) -> None:
         """Register a test with the :class:`RegressionManager`.
 
@@ -384,9 +443,14 @@ class RegressionManager:
         else:
             self._included = [True] * len(self._test_queue)
 
+        self._in_shard = self._split_shards()
+
         # compute counts
         self.count = 1
-        self.total_tests = sum(self._included)
+        self.total_tests = sum(
+            included and in_shard
+            for included, in_shard in zip(self._included, self._in_shard)
+        )
         if self.total_tests == 0:
             self.log.warning(
                 "No tests left after filtering with: %s",
@@ -398,6 +462,46 @@ class RegressionManager:
         self._first_test = True
         self._execute()
 
+    def _split_shards(self) -> List[bool]:
+        """Mark the tests of the shard set by :meth:`set_shard`."""
+        if self._shard_count == 1:
+            return [True] * len(self._test_queue)
+
+        known = [
+            self._shard_durations[test.fullname]
+            for test in self._test_queue
+            if test.fullname in self._shard_durations
+        ]
+        default = sum(known) / len(known) if known else 1.0
+
+        # Longest tests first, each to the shard with the least work so far.
+        # Ties are broken by position so every shard computes the same split.
+        durations = [
+            self._shard_durations.get(test.fullname, default)
+            for test in self._test_queue
+        ]
+        order = sorted(
+            (i for i, included in enumerate(self._included) if included),
+            key=lambda i: (-durations[i], i),
+        )
+        loads = [0.0] * self._shard_count
+        in_shard = [
+            not included and self._shard_index == 0 for included in self._included
+        ]
+        for i in order:
+            shard = min(range(self._shard_count), key=lambda s: (loads[s], s))
+            loads[shard] += durations[i]
+            in_shard[i] = shard == self._shard_index
+
+        self.log.info(
+            "Running shard %d of %d, with an estimated %.2f of %.2f seconds of tests",
+            self._shard_index,
+            self._shard_count,
+            loads[self._shard_index],
+            sum(loads),
+        )
+        return in_shard
+
     def _execute(self) -> None:
         """Run the main regression loop.
 
@@ -409,6 +513,10 @@ class RegressionManager:
             self._test = self._test_queue.pop(0)
             included = self._included.pop(0)
 
+            # if the test is run by another shard, leave it for that one to record
+            if not self._in_shard.pop(0):
+                continue
+
             # if the test is not included, record and continue
             if not included:
                 self._record_test_excluded()
@@ -579,6 +687,8 @@ class RegressionManager:
             )
 
             if _pdb_on_exception:
+                import pdb
+
                 pdb.post_mortem(result.__traceback__)
 
         # continue test loop, assuming sim failure or not
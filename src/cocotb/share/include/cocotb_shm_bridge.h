@@ -0,0 +1,156 @@
+// Copyright cocotb contributors
+// Licensed under the Revised BSD License, see LICENSE for details.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef COCOTB_SHM_BRIDGE_H_
+#define COCOTB_SHM_BRIDGE_H_
+
+/*
+Shared memory of the cocotb shared-memory transactor bridge
+============================================================
+
+The bridge is loaded into the simulator through GPI_EXTRA, and exchanges
+transactions with an external process through two single-producer
+single-consumer rings of fixed size slots in a POSIX shared memory object:
+
+* to_sim, written by the external process. On each rising edge of the clock
+  the bridge takes at most one transaction, and drives its payload onto the
+  GPI_SHM_BRIDGE_DRIVE signals in the read-write phase of that time step.
+* from_sim, written by the bridge. On each rising edge the values of the
+  GPI_SHM_BRIDGE_SAMPLE signals before the edge are written to it, as well as
+  the responses to exception transactions.
+
+A payload holds, for each signal in order, (n_bits + 31) / 32 pairs of aval,
+bval 32-bit words, least significant first, as in gpi_vecval_t. It is driven
+from and sampled into the slot in place.
+
+Transactions flagged with COCOTB_SHM_TXN_EXCEPTION are not driven, but passed
+to the exception handler set from Python, and its response written to from_sim
+with the same flag. They carry any payload the two sides agree on.
+
+The bridge creates the object, and removes it at the end of the simulation.
+It fails if the object exists and the process in its `sim_pid` is alive, so
+two simulations can't share a name. The external process opens it, waits for
+`ready` to be set, and then should set `peer_pid` to its process id.
+
+When from_sim is full, the bridge waits for the external process to make
+space, and ends the simulation if the process in `peer_pid` exits or no
+space is made within GPI_SHM_BRIDGE_TIMEOUT seconds.
+
+This header only depends on the C standard library, so it can be used by the
+external process, and uses the GCC and Clang atomic builtins.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define COCOTB_SHM_BRIDGE_MAGIC UINT64_C(0x676469726268736d) /* "mshbridg" */
+#define COCOTB_SHM_BRIDGE_VERSION 1
+
+#define COCOTB_SHM_TXN_EXCEPTION 1u
+
+typedef struct cocotb_shm_slot_s {
+    uint64_t time;     // Simulation time the values were sampled, from_sim only
+    uint32_t flags;    // COCOTB_SHM_TXN_* flags
+    uint32_t n_words;  // Number of 32-bit words of the payload
+} cocotb_shm_slot_t;
+
+// Each index is only written by one side, and kept on its own cache line
+typedef struct cocotb_shm_ring_s {
+    uint64_t head;  // Next slot to write, written by the producer
+    uint8_t pad0[56];
+    uint64_t tail;  // Next slot to read, written by the consumer
+    uint8_t pad1[56];
+} cocotb_shm_ring_t;
+
+// Followed by the to_sim slots, then the from_sim slots
+typedef struct cocotb_shm_header_s {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t num_slots;
+    uint32_t slot_size;  // In bytes, including the slot header
+    uint32_t ready;      // Set to 1 by the bridge once initialized
+    uint32_t sim_pid;    // Process id of the simulator, set by the bridge
+    uint32_t peer_pid;   // Process id of the external process, or 0
+    uint8_t pad[32];
+    cocotb_shm_ring_t to_sim;
+    cocotb_shm_ring_t from_sim;
+} cocotb_shm_header_t;
+
+static inline size_t cocotb_shm_size(uint32_t num_slots, uint32_t slot_size) {
+    return sizeof(cocotb_shm_header_t) + 2 * (size_t)num_slots * slot_size;
+}
+
+static inline cocotb_shm_slot_t *cocotb_shm_slot(cocotb_shm_header_t *hdr,
+                                                 cocotb_shm_ring_t *ring,
+                                                 uint64_t index) {
+    char *slots = (char *)(hdr + 1);
+    if (ring == &hdr->from_sim) {
+        slots += (size_t)hdr->num_slots * hdr->slot_size;
+    }
+    return (cocotb_shm_slot_t *)(slots + (size_t)(index % hdr->num_slots) *
+                                             hdr->slot_size);
+}
+
+static inline uint32_t *cocotb_shm_payload(cocotb_shm_slot_t *slot) {
+    return (uint32_t *)(slot + 1);
+}
+
+// Maximum number of payload words of a slot
+static inline uint32_t cocotb_shm_max_words(const cocotb_shm_header_t *hdr) {
+    return (uint32_t)((hdr->slot_size - sizeof(cocotb_shm_slot_t)) / 4);
+}
+
+// Producer: get the next free slot, or NULL if the ring is full
+static inline cocotb_shm_slot_t *cocotb_shm_reserve(cocotb_shm_header_t *hdr,
+                                                    cocotb_shm_ring_t *ring) {
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (head - tail >= hdr->num_slots) {
+        return NULL;
+    }
+    return cocotb_shm_slot(hdr, ring, head);
+}
+
+// Producer: publish the slot returned by cocotb_shm_reserve()
+static inline void cocotb_shm_commit(cocotb_shm_ring_t *ring) {
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+// Consumer: get the oldest published slot, or NULL if the ring is empty
+static inline cocotb_shm_slot_t *cocotb_shm_peek(cocotb_shm_header_t *hdr,
+                                                 cocotb_shm_ring_t *ring) {
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    if (tail == head) {
+        return NULL;
+    }
+    return cocotb_shm_slot(hdr, ring, tail);
+}
+
+// Consumer: free the slot returned by cocotb_shm_peek()
+static inline void cocotb_shm_release(cocotb_shm_ring_t *ring) {
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+// Statistics of the bridge, see cocotbshmbridge_get_stats()
+typedef struct cocotb_shm_bridge_stats_s {
+    uint64_t driven;      // Transactions driven
+    uint64_t sampled;     // Samples written
+    uint64_t exceptions;  // Exception transactions handled
+    uint64_t full_waits;  // Edges which waited for space in from_sim
+    uint64_t errors;      // Transactions dropped
+} cocotb_shm_bridge_stats_t;
+
+// Handler of exception transactions. Gets the payload of the transaction, and
+// writes the payload of the response, of at most `max_words` words, to
+// `response`. Returns the number of words of the response, or -1 not to
+// respond.
+typedef int (*cocotb_shm_exception_handler_t)(const uint32_t *payload,
+                                              uint32_t n_words,
+                                              uint32_t *response,
+                                              uint32_t max_words);
+
+#endif /* COCOTB_SHM_BRIDGE_H_ */
@@ -81,9 +81,11 @@ imitate a callback.
 class GpiObjHdl;
 class GpiCbHdl;
 class GpiIterator;
+class GpiWorkItem;
 typedef GpiObjHdl *gpi_sim_hdl;
 typedef GpiCbHdl *gpi_cb_hdl;
 typedef GpiIterator *gpi_iterator_hdl;
+typedef GpiWorkItem *gpi_work_hdl;
 #else
 /* In C, we declare some incomplete struct types that we never complete.
  * The names of these are irrelevant, but for simplicity they match the C++
@@ -92,9 +94,11 @@ typedef GpiIterator *gpi_iterator_hdl;
 struct GpiObjHdl;
 struct GpiCbHdl;
 struct GpiIterator;
+struct GpiWorkItem;
 typedef struct GpiObjHdl *gpi_sim_hdl;
 typedef struct GpiCbHdl *gpi_cb_hdl;
 typedef struct GpiIterator *gpi_iterator_hdl;
+typedef struct GpiWorkItem *gpi_work_hdl;
 #endif
 
 #ifdef __cplusplus
@@ -113,8 +117,18 @@ GPI_EXPORT bool gpi_has_registered_impl(void);
 // Stop the simulator
 GPI_EXPORT void gpi_sim_end(void);
 
+// Register functions for a library loaded through GPI_EXTRA to call once the
+// design is elaborated, before the tests start, and once the simulation ends.
+// Either may be NULL. Hooks are called in the order they were registered.
+GPI_EXPORT void gpi_register_sim_hooks(void (*start)(void *),
+                                       void (*end)(void *), void *data);
+
 // Returns simulation time as two uints. Units are default sim units
 GPI_EXPORT void gpi_get_sim_time(uint32_t *high, uint32_t *low);
+// Returns simulation time in default sim units as a single 64-bit value.
+// Time can't advance while a callback runs, so the simulator is asked at most
+// once per callback and the result is cached until the callback returns.
+GPI_EXPORT uint64_t gpi_get_sim_time64(void);
 GPI_EXPORT void gpi_get_sim_precision(int32_t *precision);
 
 /**
@@ -131,6 +145,116 @@ GPI_EXPORT const char *gpi_get_simulator_product(void);
  */
 GPI_EXPORT const char *gpi_get_simulator_version(void);
 
+/**
+ * Starts or stops dumping waveforms to the trace the simulator was started
+ * with
+ *
+ * @param enable 1 to start dumping, 0 to stop
+ * @return 0 on success, nonzero if the simulator cannot control its trace
+ */
+GPI_EXPORT int gpi_set_trace_enabled(int enable);
+
+/**
+ * Requests the simulator to save a checkpoint of its state at the end of the
+ * current time step
+ *
+ * A simulation started from the checkpoint continues from the saved state at
+ * the saved time, but without any of the callbacks that were registered.
+ *
+ * @param path File to save the checkpoint to
+ * @return 0 on success, nonzero if the simulator cannot save checkpoints
+ */
+GPI_EXPORT int gpi_save_checkpoint(const char *path);
+
+// Statistics of the store of unique object handles
+typedef struct gpi_handle_store_stats_s {
+    uint64_t handles;   // Number of unique handles stored
+    uint64_t capacity;  // Number of slots in the store
+    uint64_t lookups;   // Number of handles checked against the store
+    uint64_t hits;      // Number of lookups that found an existing handle
+    uint64_t probes;    // Number of collisions while probing the store
+} gpi_handle_store_stats_t;
+
+/**
+ * Fills in statistics about the store of unique object handles
+ *
+ * All fields are zero if the GPI was built without SINGLETON_HANDLES.
+ */
+GPI_EXPORT void gpi_get_handle_store_stats(gpi_handle_store_stats_t *stats);
+
+// Statistics of the pool recycling callback objects
+typedef struct gpi_cb_pool_stats_s {
+    uint64_t allocations;  // Number of callback objects created
+    uint64_t reused;       // Number of allocations served from the pool
+    uint64_t cached;       // Number of freed objects currently in the pool
+    uint64_t types;        // Number of distinct callback object sizes seen
+    uint64_t capacity;     // Maximum number of freed objects kept per type
+} gpi_cb_pool_stats_t;
+
+/**
+ * Fills in statistics about the callback object pool
+ */
+GPI_EXPORT void gpi_get_cb_pool_stats(gpi_cb_pool_stats_t *stats);
+
+// Number of buckets of the callback latency histogram of gpi_stats_t
+#define GPI_STATS_LATENCY_BUCKETS 16
+
+// Statistics of the calls made through the GPI, counted while enabled
+typedef struct gpi_stats_s {
+    uint64_t value_gets;        // Number of signal values read
+    uint64_t value_sets;        // Number of signal values written
+    uint64_t handle_lookups;    // Number of handles looked up by name or index
+    uint64_t native_lookups;    // Number of names looked up in implementations
+    uint64_t iterations;        // Number of objects returned by iterators
+    uint64_t cb_registrations;  // Number of callbacks registered or re-armed
+    uint64_t cb_runs;           // Number of callbacks run by the simulator
+    uint64_t user_ns;     // Time spent in callbacks, in the GPI user (Python)
+    uint64_t simulator_ns;  // Time spent in the simulator since enabled
+    // Callback run times: bucket 0 counts those under 1 us, bucket i those
+    // under 2^i us, and the last bucket all longer ones
+    uint64_t cb_latency[GPI_STATS_LATENCY_BUCKETS];
+} gpi_stats_t;
+
+/**
+ * Starts or stops counting gpi_stats_t, which is started at startup when the
+ * GPI_STATS environment variable is set
+ */
+GPI_EXPORT void gpi_set_stats_enabled(int enable);
+
+/**
+ * Fills in the statistics of the calls made through the GPI
+ *
+ * The counters are not synchronized, as like the rest of the GPI the counted
+ * functions may only be called from the thread running the simulator.
+ *
+ * @return 1 if they are being counted, 0 otherwise
+ */
+GPI_EXPORT int gpi_get_stats(gpi_stats_t *stats);
+
+/**
+ * Returns 1 if the simulation is being profiled to the Chrome trace event file
+ * set with the GPI_PROFILE_FILE environment variable, 0 otherwise
+ */
+GPI_EXPORT int gpi_profile_is_enabled(void);
+
+/**
+ * Begins a slice of the profile, nested in the slices already begun, such as
+ * those of the callback being run. Does nothing if not profiling.
+ */
+GPI_EXPORT void gpi_profile_begin(const char *name, const char *category);
+
+/**
+ * Ends the slice last begun with gpi_profile_begin()
+ */
+GPI_EXPORT void gpi_profile_end(void);
+
+/**
+ * Sets the maximum number of freed callback objects kept for re-use, per
+ * callback type. Objects above that are returned to the heap.
+ * 0 disables pooling.
+ */
+GPI_EXPORT void gpi_set_cb_pool_capacity(size_t capacity);
+
 // Functions for extracting a gpi_sim_hdl to an object
 // Returns a handle to the root simulation object.
 GPI_EXPORT gpi_sim_hdl gpi_get_root_handle(const char *name);
@@ -187,6 +311,17 @@ GPI_EXPORT gpi_iterator_hdl gpi_iterate(gpi_sim_hdl base,
 // Returns NULL when there are no more objects
 GPI_EXPORT gpi_sim_hdl gpi_next(gpi_iterator_hdl iterator);
 
+// Like gpi_next(), but returns the name of the next object instead of a
+// handle, so the handle can be created later, and only if it is needed, with
+// gpi_get_handle_by_name() on the iterated object.
+// Where possible the handle is not created here. *type* is set to the type of
+// the object, or GPI_UNKNOWN if that is not known without creating it.
+// The name is only valid until the next call, and the same name can be
+// returned more than once, e.g. for each entry of a generate loop.
+// Returns NULL when there are no more objects
+GPI_EXPORT const char *gpi_next_name(gpi_iterator_hdl iterator,
+                                     gpi_objtype_t *type);
+
 // Returns the number of objects in the collection of the handle
 GPI_EXPORT int gpi_get_num_elems(gpi_sim_hdl gpi_sim_hdl);
 
@@ -211,6 +346,35 @@ GPI_EXPORT long gpi_get_signal_value_long(gpi_sim_hdl gpi_hdl);
 GPI_EXPORT const char *gpi_get_signal_name_str(gpi_sim_hdl gpi_hdl);
 GPI_EXPORT const char *gpi_get_signal_type_str(gpi_sim_hdl gpi_hdl);
 
+// A word of a packed 4-state value, laid out like the VPI s_vpi_vecval.
+// Each bit is encoded by its aval/bval pair:
+// 0 = (0, 0), 1 = (1, 0), Z = (0, 1), X = (1, 1)
+typedef struct gpi_vecval_s {
+    uint32_t aval;
+    uint32_t bval;
+} gpi_vecval_t;
+
+// Reads the value of a logic object as packed 4-state words, with bit 0 of
+// word 0 being the right-most bit of the value.
+// Returns the number of bits in the value. The value is only written if `buf`
+// holds at least that many bits, so passing NULL queries the size.
+// Returns -1 if the value can't be read this way, e.g. if it holds states
+// other than 0, 1, X and Z.
+GPI_EXPORT int gpi_get_signal_value_bytes(gpi_sim_hdl gpi_hdl,
+                                          gpi_vecval_t *buf, int n_words);
+
+// Reads the values of the `count` elements of an array of logic objects at
+// indices `first`, `first + 1`, ... as packed 4-state words. Each element
+// takes (n_bits + 31) / 32 consecutive words, laid out as for
+// gpi_get_signal_value_bytes().
+// Returns the number of bits of each element. The values are only written if
+// `buf` holds `n_words` words, at least the words of all the elements, so
+// passing NULL queries the element size.
+// Returns -1 on failure, e.g. if the elements are not logic objects.
+GPI_EXPORT int gpi_get_array_values(gpi_sim_hdl gpi_hdl, int32_t first,
+                                    int count, gpi_vecval_t *buf,
+                                    int n_words);
+
 // Returns one of the types defined above e.g. gpiMemory etc.
 GPI_EXPORT gpi_objtype_t gpi_get_object_type(gpi_sim_hdl gpi_hdl);
 
@@ -236,6 +400,65 @@ GPI_EXPORT void gpi_set_signal_value_str(
     gpi_sim_hdl gpi_hdl, const char *str,
     gpi_set_action_t action);  // String of ASCII char(s)
 
+// Sets the value of a logic object from packed 4-state words, laid out as for
+// gpi_get_signal_value_bytes. `n_bits` must be the number of bits in the
+// object and `buf` must hold at least that many bits.
+GPI_EXPORT void gpi_set_signal_value_vector(gpi_sim_hdl gpi_hdl,
+                                            const gpi_vecval_t *buf,
+                                            int n_bits,
+                                            gpi_set_action_t action);
+
+// Deferred writes. Each of these queues the write of a value as done by the
+// gpi_set_signal_value_* function of the same name, replacing any write still
+// queued for the same handle, to be applied by gpi_apply_queued_writes().
+GPI_EXPORT void gpi_queue_signal_value_real(gpi_sim_hdl gpi_hdl, double value,
+                                            gpi_set_action_t action);
+GPI_EXPORT void gpi_queue_signal_value_int(gpi_sim_hdl gpi_hdl, int32_t value,
+                                           gpi_set_action_t action);
+GPI_EXPORT void gpi_queue_signal_value_binstr(gpi_sim_hdl gpi_hdl,
+                                              const char *str,
+                                              gpi_set_action_t action);
+GPI_EXPORT void gpi_queue_signal_value_str(gpi_sim_hdl gpi_hdl, const char *str,
+                                           gpi_set_action_t action);
+GPI_EXPORT void gpi_queue_signal_value_vector(gpi_sim_hdl gpi_hdl,
+                                              const gpi_vecval_t *buf,
+                                              int n_bits,
+                                              gpi_set_action_t action);
+
+// Apply the queued writes, in the order they were last queued, and empty the
+// queue. Returns the number of writes applied.
+GPI_EXPORT int gpi_apply_queued_writes(void);
+
+// Discard the queued writes
+GPI_EXPORT void gpi_clear_queued_writes(void);
+
+// Get the number of queued writes
+GPI_EXPORT int gpi_get_num_queued_writes(void);
+
+// Writes the elements of an array read by gpi_get_array_values() from packed
+// 4-state words. `n_bits` must be the number of bits of each element.
+// Returns 0 on success, -1 on failure.
+GPI_EXPORT int gpi_set_array_values(gpi_sim_hdl gpi_hdl, int32_t first,
+                                    int count, const gpi_vecval_t *buf,
+                                    int n_bits, gpi_set_action_t action);
+
+// Loads `count` elements of an array of logic objects, starting at index
+// `first`, from a raw image in the file at `path`. The image starts `offset`
+// bytes into the file, and holds each element in (n_bits + 7) / 8 bytes,
+// least significant byte first.
+// The file is streamed into the array in chunks, without copying it whole.
+// Returns 0 on success, -1 on failure.
+GPI_EXPORT int gpi_load_array_from_file(gpi_sim_hdl gpi_hdl, const char *path,
+                                        uint64_t offset, int32_t first,
+                                        int count, gpi_set_action_t action);
+
+// Writes `count` elements of an array of logic objects, starting at index
+// `first`, to the file at `path` as a raw image laid out as read by
+// gpi_load_array_from_file(). X and Z bits are written as 0.
+// Returns 0 on success, -1 on failure.
+GPI_EXPORT int gpi_dump_array_to_file(gpi_sim_hdl gpi_hdl, const char *path,
+                                      int32_t first, int count);
+
 typedef enum gpi_edge {
     GPI_RISING,
     GPI_FALLING,
@@ -266,11 +489,63 @@ gpi_register_readwrite_callback(int (*gpi_function)(void *), void *gpi_cb_data);
 // For implementers of GPI the provided macro GPI_RET(x) is provided
 GPI_EXPORT void gpi_deregister_callback(gpi_cb_hdl gpi_hdl);
 
+// Opt-in coalescing of callbacks. If set, *begin* and *end* are called
+// around each group of callbacks the GPI delivers together from a single
+// simulator callback, so the callbacks of a group can be deferred and handled
+// at once from *end*. Pass NULL to disable.
+GPI_EXPORT void gpi_set_callback_batch_handlers(void (*begin)(void *),
+                                                void (*end)(void *),
+                                                void *data);
+
+// Re-arm a timed callback to fire again *time* steps from now, re-using the
+// handle rather than allocating a new one.
+// Only valid from within the callback function of *cb_hdl* itself.
+// Returns 0 on success, nonzero if the handle could not be re-armed, in which
+// case the caller should register a new timed callback instead.
+GPI_EXPORT int gpi_rearm_timed_callback(gpi_cb_hdl cb_hdl, uint64_t time);
+
+// Keep a value change callback registered once its function returns, so it is
+// called again on the next change, re-using the handle.
+// Only valid from within the callback function of *cb_hdl* itself.
+// Returns 0 on success, nonzero if the handle is not being called.
+GPI_EXPORT int gpi_rearm_value_change_callback(gpi_cb_hdl cb_hdl);
+
+// Get the value a value change callback was delivered with, packed as by
+// gpi_get_signal_value_bytes(), without reading the signal again.
+// Only valid from within the callback function of *cb_hdl* itself.
+// Returns the number of bits of the value, or -1 if the simulator did not
+// deliver a value with the callback and the signal has to be read instead.
+GPI_EXPORT int gpi_get_callback_value(gpi_cb_hdl cb_hdl, gpi_vecval_t *buf,
+                                      int n_words);
+
 // Because the internal structures may be different for different
 // implementations of GPI we provide a convenience function to extract the
 // callback data
 GPI_EXPORT void *gpi_get_callback_data(gpi_cb_hdl gpi_hdl);
 
+// Worker pool for computations which don't access the simulator, such as
+// reference models, so they can run on other cores while the simulator runs.
+// The pool is started on the first submission with GPI_WORKER_THREADS
+// threads, by default one less than the number of cores, and is stopped once
+// the simulation ends, after the work already submitted has run.
+
+// Run *func(data)* on a thread of the worker pool. *func* must not call any
+// other GPI function. Returns a handle to pass to gpi_release_work() once done
+// with it, or NULL if the pool could not be started.
+GPI_EXPORT gpi_work_hdl gpi_submit_work(void (*func)(void *), void *data);
+
+// Returns 1 if the function of *work_hdl* has returned, 0 otherwise
+GPI_EXPORT int gpi_work_done(gpi_work_hdl work_hdl);
+
+// Block until the function of *work_hdl* has returned
+GPI_EXPORT void gpi_wait_work(gpi_work_hdl work_hdl);
+
+// Release *work_hdl*. The function still runs if it has not yet returned.
+GPI_EXPORT void gpi_release_work(gpi_work_hdl work_hdl);
+
+// Get the number of threads of the worker pool, 0 if not started
+GPI_EXPORT int gpi_get_num_worker_threads(void);
+
 #ifdef __cplusplus
 }
 #endif
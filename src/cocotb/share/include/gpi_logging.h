@@ -38,6 +38,7 @@
 #endif
 
 #include <cstdarg>
+#include <cstdint>
 
 #ifdef __cplusplus
 extern "C" {
@@ -66,10 +67,16 @@ enum gpi_log_levels {
 
 /** Logs a message at the given log level using the current log handler.
     Automatically populates arguments using information in the called context.
+    The arguments are not evaluated if the level is disabled.
     @param level The level at which to log the message
  */
-#define LOG_(level, ...) \
-    gpi_log("gpi", level, __FILE__, __func__, __LINE__, __VA_ARGS__);
+#define LOG_(level, ...)                                                 \
+    do {                                                                 \
+        if (gpi_log_enabled(level)) {                                    \
+            gpi_log(gpi_logger_name, level, __FILE__, __func__, __LINE__, \
+                    __VA_ARGS__);                                        \
+        }                                                                \
+    } while (0)
 
 /** Logs a message at TRACE log level using the current log handler.
     Automatically populates arguments using information in the called context.
@@ -116,6 +123,29 @@ typedef void(gpi_log_handler_type)(void *userdata, const char *name, int level,
                                    const char *pathname, const char *funcname,
                                    long lineno, const char *msg, va_list args);
 
+/** Name of the "gpi" logger.
+    Messages logged with this name are recognized by comparing the pointer, so
+    only they are dropped below the minimum level without calling the handler.
+ */
+GPILOG_EXPORT extern const char gpi_logger_name[];
+
+/** Check if a message at the given level to the "gpi" logger would be logged.
+    The level is cached by the GPI and kept up to date by the log handler, so
+    this check is cheap enough to make before formatting any message.
+    @param level     Level of the message
+    @return          Nonzero if messages at that level are enabled
+ */
+GPILOG_EXPORT int gpi_log_enabled(int level);
+
+/** Set the minimum level of messages to the "gpi" logger passed to the
+    current log handler.
+    Log handlers call this whenever their configuration changes. Setting or
+    clearing the log handler resets it, to log everything for a custom handler
+    or to the level of the native logger.
+    @param level     Logging level
+ */
+GPILOG_EXPORT void gpi_set_log_min_level(int level);
+
 /** Log a message using the currently registered log handler.
     User is expected to populate all arguments to this function.
     @param name      Name of the logger
@@ -197,6 +227,38 @@ GPILOG_EXPORT void gpi_native_logger_vlog(const char *name, int level,
                                           const char *funcname, long lineno,
                                           const char *msg, va_list args);
 
+/** Type of a function giving the current simulation time.
+    @param time       Location to return the time in simulation steps
+    @param precision  Location to return the simulation precision, as a power
+                      of 10 in seconds
+    @return `0` if there is no simulation time yet, else non-zero
+ */
+typedef int(gpi_log_time_source_type)(uint64_t *time, int32_t *precision);
+
+/** Set the source of the simulation time printed by the native logger.
+    The GPI sets this at the start of the simulation.
+    @param time_source  Function to get the simulation time, or `NULL` to
+                        print a placeholder instead
+ */
+GPILOG_EXPORT void gpi_native_logger_set_time_source(
+    gpi_log_time_source_type *time_source);
+
+/** Switch the native logger to asynchronous output.
+    Messages are queued in a ring buffer and written out in batches by a
+    background thread, so logging doesn't wait on the output. Messages at
+    CRITICAL level are always written before returning.
+    @param binary_path  If not `NULL` or empty, also write every message to a
+                        binary log file at this path
+    @return             0 on success, or -1 if the binary log file can't be
+                        opened
+ */
+GPILOG_EXPORT int gpi_native_logger_start_async(const char *binary_path);
+
+/** Write out all queued messages and switch the native logger back to
+    synchronous output. Also called at exit.
+ */
+GPILOG_EXPORT void gpi_native_logger_stop_async(void);
+
 /** Set minimum logging level of the native logger.
     If a logging request occurs where the logging level is lower than the level
     set by this function, it is not logged. Only affects the native logger.
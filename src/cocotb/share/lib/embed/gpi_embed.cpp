@@ -37,6 +37,7 @@
 #include <py_gpi_logging.h>  // py_gpi_logger_set_level, py_gpi_logger_initialize, py_gpi_logger_finalize
 
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <map>
@@ -71,6 +72,16 @@ constexpr char const *PYTHON_INTERPRETER_PATH = "/bin/python";
 
 static PyObject *pEventFn = NULL;
 
+// Startup timing, reported at the debug level to measure the cost of Python
+// initialization
+using startup_clock = std::chrono::steady_clock;
+
+static double elapsed_ms(startup_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(startup_clock::now() -
+                                                     since)
+        .count();
+}
+
 static void set_program_name_in_venv(void) {
     static wchar_t venv_path_w[PATH_MAX];
 
@@ -143,8 +154,11 @@ extern "C" COCOTB_EXPORT void _embed_init_python(void) {
     // must set program name to Python executable before initialization, so
     // initialization can determine path from executable
     set_program_name_in_venv();
+    auto init_start = startup_clock::now();
     Py_Initialize(); /* Initialize the interpreter */
     PySys_SetArgvEx(1, argv, 0);
+    LOG_DEBUG("Python interpreter initialized in %.3f ms",
+              elapsed_ms(init_start));
 
     /* Swap out and return current thread state and release the GIL */
     gtstate = PyEval_SaveThread();
@@ -217,6 +231,7 @@ extern "C" COCOTB_EXPORT int _embed_sim_init(int argc,
     to_python();
     DEFER(to_simulator());
 
+    auto import_start = startup_clock::now();
     auto entry_utility_module = PyImport_ImportModule("pygpi.entry");
     if (!entry_utility_module) {
         // LCOV_EXCL_START
@@ -246,6 +261,8 @@ extern "C" COCOTB_EXPORT int _embed_sim_init(int argc,
         // LCOV_EXCL_STOP
     }
     // Objects returned from ParseTuple are borrowed from tuple
+    LOG_DEBUG("Python entry point imported in %.3f ms",
+              elapsed_ms(import_start));
 
     auto log_func = PyObject_GetAttrString(entry_module, "_log_from_c");
     if (!log_func) {
@@ -298,6 +315,7 @@ extern "C" COCOTB_EXPORT int _embed_sim_init(int argc,
     }
     DEFER(Py_DECREF(argv_list))
 
+    auto entry_start = startup_clock::now();
     auto cocotb_retval =
         PyObject_CallFunctionObjArgs(entry_point, argv_list, NULL);
     if (!cocotb_retval) {
@@ -307,6 +325,7 @@ extern "C" COCOTB_EXPORT int _embed_sim_init(int argc,
         // LCOV_EXCL_STOP
     }
     Py_DECREF(cocotb_retval);
+    LOG_DEBUG("Python entry point ran in %.3f ms", elapsed_ms(entry_start));
 
     return 0;
 }
@@ -99,6 +99,12 @@ int FliTimedCbHdl::cleanup_callback() {
     return 0;
 }
 
+int FliTimedCbHdl::rearm_timer(uint64_t time) {
+    // The process is still live, just schedule another wakeup
+    reset_time(time);
+    return arm_callback();
+}
+
 int FliSignalCbHdl::arm_callback() {
     if (NULL == m_proc_hdl) {
         LOG_DEBUG("Creating a new process to sensitise to signal %s",
@@ -402,7 +402,7 @@ GpiObjHdl *FliImpl::native_check_create(int32_t index, GpiObjHdl *parent) {
         snprintf(buff, 14, "(%d)", index);
 
         std::string idx = buff;
-        std::string name = parent->get_name() + idx;
+        std::string name = parent->get_name_str() + idx;
         std::string fq_name = parent->get_fullname() + idx;
 
         std::vector<char> writable(fq_name.begin(), fq_name.end());
@@ -436,7 +436,7 @@ GpiObjHdl *FliImpl::native_check_create(int32_t index, GpiObjHdl *parent) {
         snprintf(buff, 14, "(%d)", index);
 
         std::string idx = buff;
-        std::string name = parent->get_name() + idx;
+        std::string name = parent->get_name_str() + idx;
         std::string fq_name = parent->get_fullname() + idx;
 
         if (!(fli_obj->is_var())) {
@@ -606,6 +606,7 @@ GpiCbHdl *FliImpl::register_nexttime_callback(int (*function)(void *),
 }
 
 int FliImpl::deregister_callback(GpiCbHdl *gpi_hdl) {
+    gpi_unqueue_callback(gpi_hdl);
     return gpi_hdl->cleanup_callback();
 }
 
@@ -696,10 +697,12 @@ decltype(FliIterator::iterate_over) FliIterator::iterate_over = [] {
 
 FliIterator::FliIterator(GpiImplInterface *impl, GpiObjHdl *hdl)
     : GpiIterator(impl, hdl),
-      m_vars(),
-      m_sigs(),
-      m_regs(),
-      m_currentHandles(NULL) {
+      m_handles(),
+      m_region(NULL),
+      m_index(0),
+      m_index_end(0),
+      m_index_step(1),
+      m_by_index(false) {
     FliObj *fli_obj = dynamic_cast<FliObj *>(m_parent);
     int type = fli_obj->get_acc_full_type();
 
@@ -727,33 +730,12 @@ FliIterator::FliIterator(GpiImplInterface *impl, GpiObjHdl *hdl)
             continue;
         }
 
-        populate_handle_list(*one2many);
-
-        switch (*one2many) {
-            case FliIterator::OTM_CONSTANTS:
-            case FliIterator::OTM_VARIABLE_SUB_ELEMENTS:
-                m_currentHandles = &m_vars;
-                m_iterator = m_vars.begin();
-                break;
-            case FliIterator::OTM_SIGNALS:
-            case FliIterator::OTM_SIGNAL_SUB_ELEMENTS:
-                m_currentHandles = &m_sigs;
-                m_iterator = m_sigs.begin();
-                break;
-            case FliIterator::OTM_REGIONS:
-                m_currentHandles = &m_regs;
-                m_iterator = m_regs.begin();
-                break;
-            default:
-                LOG_WARN("Unhandled OneToMany Type (%d)", *one2many);
-        }
-
-        if (m_iterator != m_currentHandles->end()) break;
+        if (start_mapping(*one2many)) break;
 
         LOG_DEBUG("fli_iterator OneToMany=%d returned NULL", *one2many);
     }
 
-    if (m_iterator == m_currentHandles->end()) {
+    if (one2many == selected->end()) {
         LOG_DEBUG(
             "fli_iterator return NULL for all relationships on %s (%d) kind:%s",
             m_parent->get_name_str(), type, acc_fetch_type_str(type));
@@ -772,18 +754,15 @@ GpiIterator::Status FliIterator::next_handle(std::string &name, GpiObjHdl **hdl,
     if (!selected) return GpiIterator::END;
 
     gpi_objtype_t obj_type = m_parent->get_type();
-    std::string parent_name = m_parent->get_name();
 
     /* We want the next object in the current mapping.
      * If the end of mapping is reached then we want to
      * try next one until a new object is found
      */
     do {
-        obj = NULL;
-
-        if (m_iterator != m_currentHandles->end()) {
-            obj = *m_iterator++;
+        obj = next_raw_handle();
 
+        if (obj) {
             /* For GPI_GENARRAY, only allow the generate statements through that
              * match the name of the generate block.
              */
@@ -791,8 +770,8 @@ GpiIterator::Status FliIterator::next_handle(std::string &name, GpiObjHdl **hdl,
                 if (acc_fetch_fulltype(obj) == accForGenerate) {
                     std::string rgn_name =
                         mti_GetRegionName(static_cast<mtiRegionIdT>(obj));
-                    if (!FliImpl::compare_generate_labels(rgn_name,
-                                                          parent_name)) {
+                    if (!FliImpl::compare_generate_labels(
+                            rgn_name, m_parent->get_name())) {
                         obj = NULL;
                         continue;
                     }
@@ -822,26 +801,7 @@ GpiIterator::Status FliIterator::next_handle(std::string &name, GpiObjHdl **hdl,
             continue;
         }
 
-        populate_handle_list(*one2many);
-
-        switch (*one2many) {
-            case FliIterator::OTM_CONSTANTS:
-            case FliIterator::OTM_VARIABLE_SUB_ELEMENTS:
-                m_currentHandles = &m_vars;
-                m_iterator = m_vars.begin();
-                break;
-            case FliIterator::OTM_SIGNALS:
-            case FliIterator::OTM_SIGNAL_SUB_ELEMENTS:
-                m_currentHandles = &m_sigs;
-                m_iterator = m_sigs.begin();
-                break;
-            case FliIterator::OTM_REGIONS:
-                m_currentHandles = &m_regs;
-                m_iterator = m_regs.begin();
-                break;
-            default:
-                LOG_WARN("Unhandled OneToMany Type (%d)", *one2many);
-        }
+        start_mapping(*one2many);
     } while (!obj);
 
     if (NULL == obj) {
@@ -960,16 +920,19 @@ GpiIterator::Status FliIterator::next_handle(std::string &name, GpiObjHdl **hdl,
     }
 }
 
-void FliIterator::populate_handle_list(FliIterator::OneToMany childType) {
+bool FliIterator::start_mapping(FliIterator::OneToMany childType) {
+    m_handles.clear();
+    m_iterator = m_handles.begin();
+    m_region = NULL;
+    m_by_index = false;
+
     switch (childType) {
         case FliIterator::OTM_CONSTANTS: {
             mtiRegionIdT parent = m_parent->get_handle<mtiRegionIdT>();
             mtiVariableIdT id;
 
             for (id = mti_FirstVarByRegion(parent); id; id = mti_NextVar()) {
-                if (id) {
-                    m_vars.push_back(id);
-                }
+                m_handles.push_back(id);
             }
         } break;
         case FliIterator::OTM_SIGNALS: {
@@ -977,90 +940,72 @@ void FliIterator::populate_handle_list(FliIterator::OneToMany childType) {
             mtiSignalIdT id;
 
             for (id = mti_FirstSignal(parent); id; id = mti_NextSignal()) {
-                if (id) {
-                    m_sigs.push_back(id);
-                }
-            }
-        } break;
-        case FliIterator::OTM_REGIONS: {
-            mtiRegionIdT parent = m_parent->get_handle<mtiRegionIdT>();
-            mtiRegionIdT id;
-
-            for (id = mti_FirstLowerRegion(parent); id;
-                 id = mti_NextRegion(id)) {
-                if (id) {
-                    m_regs.push_back(id);
-                }
+                m_handles.push_back(id);
             }
         } break;
+        case FliIterator::OTM_REGIONS:
+            /* mti_NextRegion() keeps no state, so walk the siblings as the
+             * caller asks for them */
+            m_region =
+                mti_FirstLowerRegion(m_parent->get_handle<mtiRegionIdT>());
+            return m_region != NULL;
         case FliIterator::OTM_SIGNAL_SUB_ELEMENTS:
+        case FliIterator::OTM_VARIABLE_SUB_ELEMENTS:
             if (m_parent->get_type() == GPI_STRUCTURE) {
-                mtiSignalIdT parent = m_parent->get_handle<mtiSignalIdT>();
+                void **ids;
+                mtiTypeIdT type;
 
-                mtiTypeIdT type = mti_GetSignalType(parent);
-                mtiSignalIdT *ids = mti_GetSignalSubelements(parent, NULL);
-
-                LOG_DEBUG("GPI_STRUCTURE: %d fields", mti_TickLength(type));
-                for (int i = 0; i < mti_TickLength(type); i++) {
-                    m_sigs.push_back(ids[i]);
-                }
-                mti_VsimFree(ids);
-            } else if (m_parent->get_indexable()) {
-                FliValueObjHdl *fli_obj =
-                    reinterpret_cast<FliValueObjHdl *>(m_parent);
-
-                int left = m_parent->get_range_left();
-                int right = m_parent->get_range_right();
-
-                if (left > right) {
-                    for (int i = left; i >= right; i--) {
-                        m_sigs.push_back(
-                            static_cast<mtiSignalIdT>(fli_obj->get_sub_hdl(i)));
-                    }
+                if (childType == FliIterator::OTM_SIGNAL_SUB_ELEMENTS) {
+                    mtiSignalIdT parent = m_parent->get_handle<mtiSignalIdT>();
+                    type = mti_GetSignalType(parent);
+                    ids = (void **)mti_GetSignalSubelements(parent, NULL);
                 } else {
-                    for (int i = left; i <= right; i++) {
-                        m_sigs.push_back(
-                            static_cast<mtiSignalIdT>(fli_obj->get_sub_hdl(i)));
-                    }
+                    mtiVariableIdT parent =
+                        m_parent->get_handle<mtiVariableIdT>();
+                    type = mti_GetVarType(parent);
+                    ids = (void **)mti_GetVarSubelements(parent, NULL);
                 }
-            }
-            break;
-        case FliIterator::OTM_VARIABLE_SUB_ELEMENTS:
-            if (m_parent->get_type() == GPI_STRUCTURE) {
-                mtiVariableIdT parent = m_parent->get_handle<mtiVariableIdT>();
-
-                mtiTypeIdT type = mti_GetVarType(parent);
-                mtiVariableIdT *ids = mti_GetVarSubelements(parent, NULL);
 
                 LOG_DEBUG("GPI_STRUCTURE: %d fields", mti_TickLength(type));
-                for (int i = 0; i < mti_TickLength(type); i++) {
-                    m_vars.push_back(ids[i]);
-                }
-
+                m_handles.assign(ids, ids + mti_TickLength(type));
                 mti_VsimFree(ids);
             } else if (m_parent->get_indexable()) {
-                FliValueObjHdl *fli_obj =
-                    reinterpret_cast<FliValueObjHdl *>(m_parent);
-
+                /* The elements are fetched by index as they are consumed */
                 int left = m_parent->get_range_left();
                 int right = m_parent->get_range_right();
 
-                if (left > right) {
-                    for (int i = left; i >= right; i--) {
-                        m_vars.push_back(static_cast<mtiVariableIdT>(
-                            fli_obj->get_sub_hdl(i)));
-                    }
-                } else {
-                    for (int i = left; i <= right; i++) {
-                        m_vars.push_back(static_cast<mtiVariableIdT>(
-                            fli_obj->get_sub_hdl(i)));
-                    }
-                }
+                m_by_index = true;
+                m_index = left;
+                m_index_step = left > right ? -1 : 1;
+                m_index_end = right + m_index_step;
+                return true;
             }
             break;
         default:
             LOG_WARN("Unhandled OneToMany Type (%d)", childType);
     }
+
+    m_iterator = m_handles.begin();
+    return m_iterator != m_handles.end();
+}
+
+void *FliIterator::next_raw_handle() {
+    if (*one2many == FliIterator::OTM_REGIONS) {
+        mtiRegionIdT rgn = m_region;
+        if (rgn) m_region = mti_NextRegion(rgn);
+        return rgn;
+    }
+
+    if (m_by_index) {
+        if (m_index == m_index_end) return NULL;
+        FliValueObjHdl *fli_obj = reinterpret_cast<FliValueObjHdl *>(m_parent);
+        void *sub_hdl = fli_obj->get_sub_hdl(m_index);
+        m_index += m_index_step;
+        return sub_hdl;
+    }
+
+    if (m_iterator == m_handles.end()) return NULL;
+    return *m_iterator++;
 }
 
 FliTimedCbHdl *FliTimerCache::get_timer(uint64_t time) {
@@ -1093,42 +1038,38 @@ void FliTimerCache::put_timer(FliTimedCbHdl *hdl) {
 
 extern "C" {
 
-// Main re-entry point for callbacks from simulator
-void handle_fli_callback(void *data) {
-    gpi_to_user();
-
-    fflush(stderr);
-
-    FliProcessCbHdl *cb_hdl = (FliProcessCbHdl *)data;
-
-    if (!cb_hdl) {
-        LOG_CRITICAL("FLI: Callback data corrupted: ABORTING");
-        gpi_embed_end();
-        return;
-    }
-
+static bool run_fli_callback(GpiCbHdl *cb_hdl) {
     gpi_cb_state_e old_state = cb_hdl->get_call_state();
 
     if (old_state == GPI_PRIMED) {
         cb_hdl->set_call_state(GPI_CALL);
 
-        cb_hdl->run_callback();
+        gpi_run_callback(cb_hdl);
         gpi_cb_state_e new_state = cb_hdl->get_call_state();
 
         /* We have re-primed in the handler */
         if (new_state != GPI_PRIMED) {
-            if (cb_hdl->cleanup_callback()) {
-                delete cb_hdl;
-            }
-        }
-    } else {
-        /* Issue #188 seems to appear via FLI as well */
-        if (cb_hdl->cleanup_callback()) {
-            delete cb_hdl;
+            return cb_hdl->cleanup_callback() != 0;
         }
+        return false;
+    }
+    /* Issue #188 seems to appear via FLI as well */
+    return cb_hdl->cleanup_callback() != 0;
+}
+
+// Main re-entry point for callbacks from simulator
+void handle_fli_callback(void *data) {
+    fflush(stderr);
+
+    FliProcessCbHdl *cb_hdl = (FliProcessCbHdl *)data;
+
+    if (!cb_hdl) {
+        LOG_CRITICAL("FLI: Callback data corrupted: ABORTING");
+        gpi_embed_end();
+        return;
     }
 
-    gpi_to_simulator();
+    gpi_deliver_callback(cb_hdl, run_fli_callback);
 };
 
 static void register_initial_callback() {
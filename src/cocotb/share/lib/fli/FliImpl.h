@@ -139,6 +139,7 @@ class FliTimedCbHdl : public FliProcessCbHdl {
     int arm_callback() override;
     void reset_time(uint64_t new_time) { m_time = new_time; }
     int cleanup_callback() override;
+    int rearm_timer(uint64_t time) override;
 
   private:
     uint64_t m_time;
@@ -268,11 +269,14 @@ class FliLogicObjHdl : public FliValueObjHdl {
     }
 
     const char *get_signal_value_binstr() override;
+    int get_signal_value_bytes(gpi_vecval_t *buf, int n_words) override;
 
     using FliValueObjHdl::set_signal_value;
     int set_signal_value(int32_t value, gpi_set_action_t action) override;
     int set_signal_value_binstr(std::string &value,
                                 gpi_set_action_t action) override;
+    int set_signal_value_vector(const gpi_vecval_t *buf, int n_bits,
+                                gpi_set_action_t action) override;
 
     int initialise(const std::string &name,
                    const std::string &fq_name) override;
@@ -384,7 +388,8 @@ class FliIterator : public GpiIterator {
                        void **raw_hdl) override;
 
   private:
-    void populate_handle_list(OneToMany childType);
+    bool start_mapping(OneToMany childType);
+    void *next_raw_handle();
 
   private:
     static std::map<int, std::vector<OneToMany>>
@@ -392,11 +397,17 @@ class FliIterator : public GpiIterator {
     std::vector<OneToMany> *selected; /* Mapping currently in use */
     std::vector<OneToMany>::iterator one2many;
 
-    std::vector<void *> m_vars;
-    std::vector<void *> m_sigs;
-    std::vector<void *> m_regs;
-    std::vector<void *> *m_currentHandles;
+    /* Signals and variables are collected up front as mti_NextSignal() and
+     * mti_NextVar() share one cursor across the whole simulator. Regions and
+     * indexed sub-elements are walked on demand.
+     */
+    std::vector<void *> m_handles;
     std::vector<void *>::iterator m_iterator;
+    mtiRegionIdT m_region;
+    int m_index;
+    int m_index_end;
+    int m_index_step;
+    bool m_by_index;
 };
 
 class FliImpl : public GpiImplInterface {
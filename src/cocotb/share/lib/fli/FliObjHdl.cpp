@@ -79,10 +79,10 @@ int FliObjHdl::initialise(const std::string &name, const std::string &fq_name) {
     }
 
     str = mti_GetPrimaryName(get_handle<mtiRegionIdT>());
-    if (str != NULL) m_definition_name = str;
+    if (str != NULL) m_definition_name = gpi_intern_string(str);
 
     str = mti_GetRegionSourceName(get_handle<mtiRegionIdT>());
-    if (str != NULL) m_definition_file = str;
+    if (str != NULL) m_definition_file = gpi_intern_string(str);
 
     return GpiObjHdl::initialise(name, fq_name);
 }
@@ -333,17 +333,93 @@ const char *FliLogicObjHdl::get_signal_value_binstr() {
             }
         } break;
         default:
-            LOG_ERROR("Object type is not 'logic' for %s (%d)", m_name.c_str(),
+            LOG_ERROR("Object type is not 'logic' for %s (%d)", m_name,
                       m_fli_type);
             return NULL;
     }
 
     LOG_DEBUG("Retrieved \"%s\" for value object %s", m_val_buff,
-              m_name.c_str());
+              m_name);
 
     return m_val_buff;
 }
 
+int FliLogicObjHdl::set_signal_value_vector(const gpi_vecval_t *buf,
+                                            int n_bits,
+                                            gpi_set_action_t action) {
+    /* Forcing needs a value string, so only deposits of arrays are written
+     * directly into the value buffer */
+    if (m_fli_type != MTI_TYPE_ARRAY ||
+        (action != GPI_DEPOSIT && action != GPI_NO_DELAY)) {
+        return GpiSignalObjHdl::set_signal_value_vector(buf, n_bits, action);
+    }
+
+    if (n_bits != m_num_elems) {
+        LOG_ERROR(
+            "FLI: Unable to set logic vector from a vector of %d bits, %d are "
+            "needed",
+            n_bits, m_num_elems);
+        return -1;
+    }
+
+    for (int i = 0; i < m_num_elems; i++) {
+        // Element 0 is the left-most bit
+        m_mti_buff[i] =
+            (char)m_enum_map[unpack_logic_bit(buf, m_num_elems - 1 - i)];
+    }
+
+    if (m_is_var) {
+        mti_SetVarValue(get_handle<mtiVariableIdT>(), (mtiLongT)m_mti_buff);
+    } else {
+        mti_SetSignalValue(get_handle<mtiSignalIdT>(), (mtiLongT)m_mti_buff);
+    }
+    return 0;
+}
+
+int FliLogicObjHdl::get_signal_value_bytes(gpi_vecval_t *buf, int n_words) {
+    int words = (m_num_elems + 31) / 32;
+    if (!buf || n_words < words) {
+        return m_num_elems;
+    }
+
+    memset(buf, 0, sizeof(gpi_vecval_t) * static_cast<size_t>(words));
+
+    switch (m_fli_type) {
+        case MTI_TYPE_ENUM: {
+            mtiInt32T val;
+            if (m_is_var) {
+                val = mti_GetVarValue(get_handle<mtiVariableIdT>());
+            } else {
+                val = mti_GetSignalValue(get_handle<mtiSignalIdT>());
+            }
+            if (!pack_logic_bit(buf, 0, m_value_enum[val][1])) {
+                return -1;
+            }
+        } break;
+        case MTI_TYPE_ARRAY: {
+            if (m_is_var) {
+                mti_GetArrayVarValue(get_handle<mtiVariableIdT>(), m_mti_buff);
+            } else {
+                mti_GetArraySignalValue(get_handle<mtiSignalIdT>(), m_mti_buff);
+            }
+
+            for (int i = 0; i < m_num_elems; i++) {
+                // Element 0 is the left-most bit
+                if (!pack_logic_bit(buf, m_num_elems - 1 - i,
+                                    m_value_enum[(int)m_mti_buff[i]][1])) {
+                    return -1;
+                }
+            }
+        } break;
+        default:
+            LOG_ERROR("Object type is not 'logic' for %s (%d)", m_name,
+                      m_fli_type);
+            return -1;
+    }
+
+    return m_num_elems;
+}
+
 int FliLogicObjHdl::set_signal_value(const int32_t value,
                                      const gpi_set_action_t action) {
     if (m_fli_type == MTI_TYPE_ENUM) {
@@ -657,7 +733,7 @@ double FliRealObjHdl::get_signal_value_real() {
     }
 
     LOG_DEBUG("Retrieved \"%f\" for value object %s", m_mti_buff[0],
-              m_name.c_str());
+              m_name);
 
     return m_mti_buff[0];
 }
@@ -731,7 +807,7 @@ const char *FliStringObjHdl::get_signal_value_str() {
     strncpy(m_val_buff, m_mti_buff, static_cast<size_t>(m_num_elems));
 
     LOG_DEBUG("Retrieved \"%s\" for value object %s", m_val_buff,
-              m_name.c_str());
+              m_name);
 
     return m_val_buff;
 }
@@ -26,10 +26,12 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  ******************************************************************************/
 
+#include <vector>
+
 #include "gpi.h"
 #include "gpi_priv.h"
 
-const char *GpiObjHdl::get_name_str() { return m_name.c_str(); }
+const char *GpiObjHdl::get_name_str() { return m_name; }
 
 const char *GpiObjHdl::get_fullname_str() { return m_fullname.c_str(); }
 
@@ -65,7 +67,7 @@ const char *GpiObjHdl::get_type_str() {
     return ret;
 }
 
-const std::string &GpiObjHdl::get_name() { return m_name; }
+std::string GpiObjHdl::get_name() { return m_name; }
 
 /* Genertic base clss implementations */
 bool GpiHdl::is_this_impl(GpiImplInterface *impl) {
@@ -73,17 +75,166 @@ bool GpiHdl::is_this_impl(GpiImplInterface *impl) {
 }
 
 int GpiObjHdl::initialise(const std::string &name, const std::string &fq_name) {
-    m_name = name;
     m_fullname = fq_name;
+    if (m_fullname.size() >= name.size() &&
+        m_fullname.compare(m_fullname.size() - name.size(), name.size(),
+                           name) == 0) {
+        m_name = m_fullname.c_str() + (m_fullname.size() - name.size());
+    } else {
+        m_name = gpi_intern_string(name);
+    }
     return 0;
 }
 
+int GpiObjHdl::initialise_from_cache(const std::string &name,
+                                     const std::string &fq_name) {
+    const GpiObjProperties *cached = gpi_hierarchy_cache_find(fq_name);
+
+    // The simulator decided the type when creating the object, so an entry
+    // of another type is from a different design
+    if (cached && cached->type == m_type && cached->is_const == m_const) {
+        set_properties(*cached);
+        return GpiObjHdl::initialise(name, fq_name);
+    }
+
+    int ret = initialise(name, fq_name);
+    if (ret == 0) {
+        GpiObjProperties props;
+        get_properties(props);
+        gpi_hierarchy_cache_add(fq_name, props);
+    }
+    return ret;
+}
+
+void GpiObjHdl::get_properties(GpiObjProperties &props) {
+    props.type = m_type;
+    props.is_const = m_const;
+    props.num_elems = m_num_elems;
+    props.indexable = m_indexable;
+    props.range_left = m_range_left;
+    props.range_right = m_range_right;
+    props.range_dir = m_range_dir;
+    props.length = 0;
+}
+
+void GpiObjHdl::set_properties(const GpiObjProperties &props) {
+    m_num_elems = props.num_elems;
+    m_indexable = props.indexable != 0;
+    m_range_left = props.range_left;
+    m_range_right = props.range_right;
+    m_range_dir = static_cast<gpi_range_dir>(props.range_dir);
+}
+
+void GpiSignalObjHdl::get_properties(GpiObjProperties &props) {
+    GpiObjHdl::get_properties(props);
+    props.length = m_length;
+}
+
+void GpiSignalObjHdl::set_properties(const GpiObjProperties &props) {
+    GpiObjHdl::set_properties(props);
+    m_length = props.length;
+}
+
 void GpiCbHdl::set_call_state(gpi_cb_state_e new_state) { m_state = new_state; }
 
 gpi_cb_state_e GpiCbHdl::get_call_state() { return m_state; }
 
 GpiCbHdl::~GpiCbHdl() {}
 
+// Arbitrary, matching the FLI timer cache: it's doubtful more than this many
+// callbacks of one type will be freed and not re-used shortly after
+static constexpr size_t GPI_CB_POOL_DEFAULT_CAPACITY = 256;
+
+// Free lists of released callback objects. Every GpiCbHdl subclass has a
+// fixed size, so keying by size gives a free list per callback type.
+class GpiCbPool {
+  public:
+    void *alloc(size_t size) {
+        m_allocations++;
+        std::vector<void *> &free_list = get_free_list(size);
+        if (!free_list.empty()) {
+            void *ptr = free_list.back();
+            free_list.pop_back();
+            m_reused++;
+            return ptr;
+        }
+        return ::operator new(size);
+    }
+
+    void release(void *ptr, size_t size) {
+        std::vector<void *> &free_list = get_free_list(size);
+        if (free_list.size() < m_capacity) {
+            free_list.push_back(ptr);
+        } else {
+            ::operator delete(ptr);
+        }
+    }
+
+    void set_capacity(size_t capacity) {
+        m_capacity = capacity;
+        for (auto &bucket : m_buckets) {
+            while (bucket.free_list.size() > m_capacity) {
+                ::operator delete(bucket.free_list.back());
+                bucket.free_list.pop_back();
+            }
+        }
+    }
+
+    void get_stats(gpi_cb_pool_stats_t *stats) const {
+        stats->allocations = m_allocations;
+        stats->reused = m_reused;
+        stats->cached = 0;
+        for (auto &bucket : m_buckets) {
+            stats->cached += bucket.free_list.size();
+        }
+        stats->types = m_buckets.size();
+        stats->capacity = m_capacity;
+    }
+
+  private:
+    struct Bucket {
+        size_t size;
+        std::vector<void *> free_list;
+    };
+
+    // There are only a handful of callback types, so a linear search is
+    // cheaper than any map
+    std::vector<void *> &get_free_list(size_t size) {
+        for (auto &bucket : m_buckets) {
+            if (bucket.size == size) {
+                return bucket.free_list;
+            }
+        }
+        m_buckets.push_back(Bucket{size, {}});
+        return m_buckets.back().free_list;
+    }
+
+    std::vector<Bucket> m_buckets;
+    size_t m_capacity = GPI_CB_POOL_DEFAULT_CAPACITY;
+    uint64_t m_allocations = 0;
+    uint64_t m_reused = 0;
+};
+
+// Never destroyed, as callbacks may still be freed during static destruction
+static GpiCbPool &cb_pool() {
+    static GpiCbPool *pool = new GpiCbPool();
+    return *pool;
+}
+
+void *GpiCbHdl::operator new(size_t size) { return cb_pool().alloc(size); }
+
+void GpiCbHdl::operator delete(void *ptr, size_t size) {
+    cb_pool().release(ptr, size);
+}
+
+void gpi_get_cb_pool_stats(gpi_cb_pool_stats_t *stats) {
+    cb_pool().get_stats(stats);
+}
+
+void gpi_set_cb_pool_capacity(size_t capacity) {
+    cb_pool().set_capacity(capacity);
+}
+
 int GpiCbHdl::run_callback() {
     this->gpi_function(m_cb_data);
     return 0;
@@ -98,41 +249,101 @@ int GpiCbHdl::set_user_data(int (*_gpi_function)(void *), void *data) {
     return 0;
 }
 
-GpiValueCbHdl::GpiValueCbHdl(GpiImplInterface *impl, GpiSignalObjHdl *signal,
-                             gpi_edge_e edge)
-    : GpiCbHdl(impl), m_signal(signal) {
-    switch (edge) {
-        case GPI_RISING: {
-            required_value = "1";
+bool GpiSignalObjHdl::pack_logic_bit(gpi_vecval_t *buf, int bit, char value) {
+    uint32_t mask = 1u << (bit % 32);
+    gpi_vecval_t &word = buf[bit / 32];
+
+    switch (value) {
+        case '0':
             break;
-        }
-        case GPI_FALLING: {
-            required_value = "0";
+        case '1':
+            word.aval |= mask;
             break;
-        }
-        case GPI_VALUE_CHANGE: {
-            required_value = "X";
+        case 'Z':
+        case 'z':
+            word.bval |= mask;
+            break;
+        case 'X':
+        case 'x':
+            word.aval |= mask;
+            word.bval |= mask;
             break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+int GpiSignalObjHdl::get_signal_value_bytes(gpi_vecval_t *buf, int n_words) {
+    // Answer the size query from the cached length where there is one, so
+    // that callers sizing a buffer don't read the value twice
+    int length = m_length > 0 ? m_length : m_num_elems;
+    if (length > 0 && (!buf || n_words < (length + 31) / 32)) {
+        return length;
+    }
+
+    const char *binstr = get_signal_value_binstr();
+    if (!binstr) {
+        return -1;
+    }
+
+    int n_bits = static_cast<int>(strlen(binstr));
+    if (!buf || n_words < (n_bits + 31) / 32) {
+        return n_bits;
+    }
+
+    memset(buf, 0, sizeof(gpi_vecval_t) * static_cast<size_t>(n_words));
+    for (int i = 0; i < n_bits; i++) {
+        // The string starts with the left-most bit
+        if (!pack_logic_bit(buf, n_bits - 1 - i, binstr[i])) {
+            return -1;
         }
     }
+    return n_bits;
 }
 
-int GpiValueCbHdl::run_callback() {
-    std::string current_value;
-    bool pass = false;
+char GpiSignalObjHdl::unpack_logic_bit(const gpi_vecval_t *buf, int bit) {
+    static const char logic_chars[] = "01ZX";
+
+    uint32_t shift = static_cast<uint32_t>(bit % 32);
+    const gpi_vecval_t &word = buf[bit / 32];
+    return logic_chars[((word.aval >> shift) & 1) |
+                       (((word.bval >> shift) & 1) << 1)];
+}
 
-    if (required_value == "X")
-        pass = true;
-    else {
-        current_value = m_signal->get_signal_value_binstr();
-        if (current_value == required_value) pass = true;
+int GpiSignalObjHdl::set_signal_value_vector(const gpi_vecval_t *buf,
+                                             int n_bits,
+                                             gpi_set_action_t action) {
+    std::string binstr(static_cast<size_t>(n_bits), '0');
+    for (int i = 0; i < n_bits; i++) {
+        // The string starts with the left-most bit
+        binstr[static_cast<size_t>(i)] = unpack_logic_bit(buf, n_bits - 1 - i);
     }
+    return set_signal_value_binstr(binstr, action);
+}
+
+GpiValueCbHdl::GpiValueCbHdl(GpiImplInterface *impl, GpiSignalObjHdl *signal,
+                             gpi_edge_e edge)
+    : GpiCbHdl(impl), m_edge(edge), m_signal(signal) {}
+
+bool GpiValueCbHdl::edge_matches() {
+    gpi_vecval_t word;
 
-    if (pass) {
+    // Edges are only seen on single bit signals at 0 or 1
+    if (m_signal->get_signal_value_bytes(&word, 1) != 1 || (word.bval & 1)) {
+        return false;
+    }
+    return (word.aval & 1) == (m_edge == GPI_RISING ? 1u : 0u);
+}
+
+int GpiValueCbHdl::run_callback() {
+    if (m_edge == GPI_VALUE_CHANGE || edge_matches()) {
         this->gpi_function(m_cb_data);
     } else {
-        cleanup_callback();
-        arm_callback();
+        /* Value change callbacks stay registered with the simulator, so
+         * rather than being cleaned up and armed again this waits for the
+         * next change */
+        set_call_state(GPI_PRIMED);
     }
 
     return 0;
@@ -30,9 +30,27 @@
 #include <cocotb_utils.h>
 #include <sys/types.h>
 
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
-#include <map>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "gpi_priv.h"
@@ -43,54 +61,588 @@ static vector<GpiImplInterface *> registered_impls;
 
 #ifdef SINGLETON_HANDLES
 
+/* Open-addressing hash table of the unique object handles, keyed on the full
+ * name of the handle.
+ *
+ * The table does not keep its own copy of the name, the key is the full name
+ * stored in the handle, so each hierarchical name is held in memory exactly
+ * once. The hash of each entry is kept alongside it so probing only compares
+ * strings when the hashes are equal, which matters since names in a design
+ * tend to share long prefixes.
+ */
 class GpiHandleStore {
   public:
     GpiObjHdl *check_and_store(GpiObjHdl *hdl) {
-        std::map<std::string, GpiObjHdl *>::iterator it;
-
         const std::string &name = hdl->get_fullname();
 
         LOG_DEBUG("Checking %s exists", name.c_str());
 
-        it = handle_map.find(name);
-        if (it == handle_map.end()) {
-            handle_map[name] = hdl;
-            return hdl;
-        } else {
-            LOG_DEBUG("Found duplicate %s", name.c_str());
+        m_lookups++;
+
+        // Grow before probing so the returned slot stays valid
+        if ((m_count + 1) * 2 > m_table.size()) {
+            rehash(m_table.empty() ? 1024 : m_table.size() * 2);
+        }
 
-            delete hdl;
-            return it->second;
+        uint64_t hash = hash_name(name);
+        size_t mask = m_table.size() - 1;
+        size_t idx = static_cast<size_t>(hash) & mask;
+
+        while (m_table[idx].hdl) {
+            if (m_table[idx].hash == hash &&
+                m_table[idx].hdl->get_fullname() == name) {
+                LOG_DEBUG("Found duplicate %s", name.c_str());
+
+                m_hits++;
+                delete hdl;
+                return m_table[idx].hdl;
+            }
+            m_probes++;
+            idx = (idx + 1) & mask;
         }
+
+        m_table[idx].hash = hash;
+        m_table[idx].hdl = hdl;
+        m_count++;
+        return hdl;
     }
 
-    uint64_t handle_count() { return handle_map.size(); }
+    uint64_t handle_count() { return m_count; }
 
-    void clear() {
-        std::map<std::string, GpiObjHdl *>::iterator it;
+    void get_stats(gpi_handle_store_stats_t *stats) {
+        stats->handles = m_count;
+        stats->capacity = m_table.size();
+        stats->lookups = m_lookups;
+        stats->hits = m_hits;
+        stats->probes = m_probes;
+    }
 
-        // Delete the object handles before clearing the map
-        for (it = handle_map.begin(); it != handle_map.end(); it++) {
-            delete (it->second);
+    void clear() {
+        // Delete the object handles before clearing the table
+        for (auto &entry : m_table) {
+            delete entry.hdl;
         }
-        handle_map.clear();
+        m_table.clear();
+        m_count = 0;
     }
 
   private:
-    std::map<std::string, GpiObjHdl *> handle_map;
+    struct Entry {
+        uint64_t hash = 0;
+        GpiObjHdl *hdl = NULL;
+    };
+
+    /* 64-bit FNV-1a */
+    static uint64_t hash_name(const std::string &name) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (unsigned char c : name) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    void rehash(size_t new_size) {
+        std::vector<Entry> old_table(new_size);
+        old_table.swap(m_table);
+
+        size_t mask = new_size - 1;
+        for (auto &entry : old_table) {
+            if (!entry.hdl) continue;
+            size_t idx = static_cast<size_t>(entry.hash) & mask;
+            while (m_table[idx].hdl) {
+                idx = (idx + 1) & mask;
+            }
+            m_table[idx] = entry;
+        }
+    }
+
+    std::vector<Entry> m_table;
+    size_t m_count = 0;
+    uint64_t m_lookups = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_probes = 0;
 };
 
 static GpiHandleStore unique_handles;
 
 #define CHECK_AND_STORE(_x) unique_handles.check_and_store(_x)
 #define CLEAR_STORE() unique_handles.clear()
+#define STORE_STATS(_x) unique_handles.get_stats(_x)
 
 #else
 
 #define CHECK_AND_STORE(_x) _x
 #define CLEAR_STORE() (void)0  // No-op
+#define STORE_STATS(_x) memset((_x), 0, sizeof(*(_x)))
+
+#endif
+
+/* Cache of the results of looking up a child by name.
+ *
+ * For each (parent, name) pair this remembers the handle that was found, or
+ * which registered implementations already failed to find it, so repeated and
+ * cross-language lookups do not go back to the simulator. Handles are only
+ * freed in gpi_cleanup(), so the parent pointer is a stable key until then.
+ *
+ * Probing for names can make many misses, so only the last MAX_MISSES names
+ * which no implementation found are remembered.
+ */
+class GpiLookupCache {
+  public:
+    // At most this many implementations can be registered
+    static constexpr size_t MAX_IMPLS = 32;
+    static constexpr size_t MAX_MISSES = 4096;
+
+    struct Entry {
+        GpiObjHdl *hdl = NULL;
+        uint32_t failed_impls = 0;  // Bit set per index in registered_impls
+        bool is_miss = false;       // Whether its key is in m_misses
+    };
+
+    Entry &get(GpiObjHdl *parent, const std::string &name) {
+        return m_entries[Key{parent, name}];
+    }
+
+    // Records that no implementation found the entry of (parent, name), and
+    // forgets the oldest miss if there are too many
+    void add_miss(GpiObjHdl *parent, const std::string &name, Entry &entry) {
+        if (entry.is_miss) {
+            return;
+        }
+        entry.is_miss = true;
+        m_misses.push_back(Key{parent, name});
+        if (m_misses.size() <= MAX_MISSES) {
+            return;
+        }
+        auto it = m_entries.find(m_misses.front());
+        m_misses.pop_front();
+        if (it == m_entries.end()) {
+            return;
+        }
+        if (it->second.hdl) {
+            // Found later through a skipped implementation, so kept
+            it->second.is_miss = false;
+        } else {
+            m_entries.erase(it);
+        }
+    }
+
+    void clear() {
+        m_entries.clear();
+        m_misses.clear();
+    }
+
+  private:
+    struct Key {
+        GpiObjHdl *parent;
+        std::string name;
+
+        bool operator==(const Key &other) const {
+            return parent == other.parent && name == other.name;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const {
+            size_t h = std::hash<std::string>()(key.name);
+            return h ^ (std::hash<GpiObjHdl *>()(key.parent) + 0x9e3779b9 +
+                        (h << 6) + (h >> 2));
+        }
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> m_entries;
+    std::deque<Key> m_misses;  // Oldest first
+};
+
+static GpiLookupCache lookup_cache;
+
+/* Handles of the elements of arrays accessed in bulk, so that accessing an
+ * element again doesn't create its handle again. Handles are never freed
+ * before the end of the simulation, so the arrays can be used as keys.
+ */
+class GpiArrayElementCache {
+  public:
+    gpi_sim_hdl get(GpiObjHdl *array, int32_t index) {
+        auto &elements = m_arrays[array];
+        if (elements.empty()) {
+            elements.resize(static_cast<size_t>(array->get_num_elems()));
+        }
+        size_t offset = static_cast<size_t>(index - low_index(array));
+        if (!elements[offset]) {
+            elements[offset] = gpi_get_handle_by_index(array, index);
+        }
+        return elements[offset];
+    }
+
+    void clear() { m_arrays.clear(); }
+
+    static int32_t low_index(GpiObjHdl *array) {
+        return std::min(array->get_range_left(), array->get_range_right());
+    }
+
+  private:
+    std::unordered_map<GpiObjHdl *, std::vector<gpi_sim_hdl>> m_arrays;
+};
+
+static GpiArrayElementCache array_elements;
+
+const char *gpi_intern_string(const std::string &str) {
+    // Elements of an unordered_set are never moved, and are not freed as
+    // handles keep pointers to them until the end of the simulation
+    static std::unordered_set<std::string> strings;
+    return strings.insert(str).first->c_str();
+}
+
+/* Statistics of the calls made through the GPI
+ *
+ * These are counted at the GPI entry points rather than in each
+ * implementation, so they mean the same for all of them. The clock is only
+ * read around callbacks, so the overhead when enabled is two reads per
+ * callback.
+ *
+ * Like the rest of the GPI, they are only used from the thread running the
+ * simulator. The worker threads of gpi_submit_work() never call into the GPI,
+ * and the Python they run can't reach it, so the counters are plain integers
+ * rather than atomics, which would slow down every GPI call.
+ */
+class GpiStats {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    gpi_stats_t counts{};
+    bool enabled = false;
+
+    void set_enabled(bool enable) {
+        if (enable == enabled) {
+            return;
+        }
+        auto now = clock::now();
+        if (enable) {
+            counts = gpi_stats_t();
+            m_since = now;
+            m_user_time = clock::duration::zero();
+            // Enabled from within a callback, which is then not timed
+            m_depth = 0;
+        } else {
+            m_stopped = now;
+        }
+        enabled = enable;
+    }
+
+    void enter_user() {
+        // Only the outermost callback is timed, should a simulator run
+        // callbacks from within a GPI call
+        if (m_depth++ == 0) {
+            m_entered = clock::now();
+        }
+    }
+
+    void exit_user() {
+        if (m_depth == 0 || --m_depth != 0) {
+            return;
+        }
+        auto elapsed = clock::now() - m_entered;
+        m_user_time += elapsed;
+
+        auto us = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                .count());
+        unsigned int bucket = 0;
+        while (us != 0 && bucket < GPI_STATS_LATENCY_BUCKETS - 1) {
+            us >>= 1;
+            bucket++;
+        }
+        counts.cb_latency[bucket]++;
+    }
+
+    void get(gpi_stats_t *stats) {
+        *stats = counts;
+        auto end = enabled ? clock::now() : m_stopped;
+        auto total = end - m_since;
+        stats->user_ns = to_ns(m_user_time);
+        stats->simulator_ns = to_ns(total - m_user_time);
+    }
+
+    void log() {
+        gpi_stats_t stats;
+        get(&stats);
+        LOG_INFO(
+            "GPI stats: %llu value gets, %llu value sets, %llu handle lookups, "
+            "%llu iterations, %llu callbacks registered, %llu callbacks run",
+            (unsigned long long)stats.value_gets,
+            (unsigned long long)stats.value_sets,
+            (unsigned long long)stats.handle_lookups,
+            (unsigned long long)stats.iterations,
+            (unsigned long long)stats.cb_registrations,
+            (unsigned long long)stats.cb_runs);
+        LOG_INFO("GPI stats: %.3f s in callbacks, %.3f s in the simulator",
+                 static_cast<double>(stats.user_ns) / 1e9,
+                 static_cast<double>(stats.simulator_ns) / 1e9);
+    }
+
+  private:
+    static uint64_t to_ns(clock::duration d) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+    }
+
+    clock::time_point m_since;
+    clock::time_point m_stopped;
+    clock::time_point m_entered;
+    clock::duration m_user_time = clock::duration::zero();
+    unsigned int m_depth = 0;
+};
+
+static GpiStats gpi_stats;
+
+// Profiles the rest of the enclosing GPI function, see GpiProfiler.cpp
+class GpiProfileScope {
+  public:
+    explicit GpiProfileScope(const char *name)
+        : m_enabled(gpi_profile_is_enabled() != 0) {
+        if (m_enabled) {
+            gpi_profile_begin(name, "gpi");
+        }
+    }
+    ~GpiProfileScope() {
+        if (m_enabled) {
+            gpi_profile_end();
+        }
+    }
+
+  private:
+    bool m_enabled;
+};
+
+// Profiles the rest of a GPI entry point, placed at its start
+#define PROFILE_GPI_CALL() GpiProfileScope profile_scope_(__func__)
+
+// Counts a call to a GPI entry point
+#define COUNT_STAT(_field)             \
+    do {                               \
+        if (gpi_stats.enabled) {       \
+            gpi_stats.counts._field++; \
+        }                              \
+    } while (0)
+
+/* On-disk cache of the properties of the objects in the design.
+ *
+ * Enabled by setting GPI_HIERARCHY_CACHE to the path of the cache file. The
+ * file is read at the first lookup, and is only used if it was written for
+ * the same GPI_HIERARCHY_CACHE_KEY, simulator and simulator version. When
+ * objects not in the file were initialised, it is written again in
+ * gpi_cleanup().
+ *
+ * The file starts with the magic "GPIHIER1", then the length and bytes of the
+ * key, then the number of entries. Each entry is a GpiObjProperties followed
+ * by the length and bytes of the full name. All integers are 32 bits in the
+ * native byte order.
+ */
+class GpiHierarchyCache {
+  public:
+    const GpiObjProperties *find(const std::string &fq_name) {
+        if (!m_loaded) {
+            load();
+        }
+        if (!m_enabled) {
+            return NULL;
+        }
+        auto it = m_entries.find(fq_name);
+        if (it == m_entries.end()) {
+            return NULL;
+        }
+        return &it->second;
+    }
+
+    void add(const std::string &fq_name, const GpiObjProperties &props) {
+        if (!m_enabled) {
+            return;
+        }
+        m_entries[fq_name] = props;
+        m_dirty = true;
+    }
+
+    void save() {
+        if (!m_enabled || !m_dirty) {
+            return;
+        }
 
+        // Written to a temporary file of this process first so concurrent
+        // simulations never read or write a partial file
+#ifdef _WIN32
+        int pid = _getpid();
+#else
+        int pid = static_cast<int>(getpid());
 #endif
+        std::string tmp_path = m_path + "." + std::to_string(pid) + ".tmp";
+        FILE *f = fopen(tmp_path.c_str(), "wb");
+        if (!f) {
+            LOG_WARN("Unable to write hierarchy cache %s", tmp_path.c_str());
+            return;
+        }
+
+        bool ok = fwrite(CACHE_MAGIC, 1, sizeof(CACHE_MAGIC) - 1, f) ==
+                      sizeof(CACHE_MAGIC) - 1 &&
+                  write_string(f, m_key) &&
+                  write_u32(f, static_cast<uint32_t>(m_entries.size()));
+        for (auto it = m_entries.begin(); ok && it != m_entries.end(); it++) {
+            ok = fwrite(&it->second, sizeof(it->second), 1, f) == 1 &&
+                 write_string(f, it->first);
+        }
+        ok = (fclose(f) == 0) && ok;
+
+        // Renaming replaces the file atomically on POSIX
+        if (ok && std::rename(tmp_path.c_str(), m_path.c_str()) != 0) {
+#ifdef _WIN32
+            // but fails over an existing file on Windows
+            std::remove(m_path.c_str());
+            ok = std::rename(tmp_path.c_str(), m_path.c_str()) == 0;
+#else
+            ok = false;
+#endif
+        }
+        if (!ok) {
+            LOG_WARN("Unable to write hierarchy cache %s", m_path.c_str());
+            std::remove(tmp_path.c_str());
+            return;
+        }
+
+        LOG_DEBUG("Wrote %zu entries to hierarchy cache %s", m_entries.size(),
+                  m_path.c_str());
+        m_dirty = false;
+    }
+
+    void clear() {
+        m_entries.clear();
+        m_loaded = false;
+        m_enabled = false;
+        m_dirty = false;
+    }
+
+  private:
+    static constexpr const char CACHE_MAGIC[] = "GPIHIER1";
+
+    static bool write_u32(FILE *f, uint32_t value) {
+        return fwrite(&value, sizeof(value), 1, f) == 1;
+    }
+
+    static bool write_string(FILE *f, const std::string &str) {
+        return write_u32(f, static_cast<uint32_t>(str.size())) &&
+               fwrite(str.data(), 1, str.size(), f) == str.size();
+    }
+
+    // Reads from the buffer of the whole file, failing past its end
+    struct Reader {
+        const char *pos;
+        const char *end;
+
+        bool read(void *dst, size_t size) {
+            if (static_cast<size_t>(end - pos) < size) {
+                return false;
+            }
+            memcpy(dst, pos, size);
+            pos += size;
+            return true;
+        }
+
+        bool read_string(std::string &str) {
+            uint32_t size;
+            if (!read(&size, sizeof(size)) ||
+                static_cast<size_t>(end - pos) < size) {
+                return false;
+            }
+            str.assign(pos, size);
+            pos += size;
+            return true;
+        }
+    };
+
+    void load() {
+        m_loaded = true;
+
+        const char *path = getenv("GPI_HIERARCHY_CACHE");
+        if (!path || !*path || registered_impls.empty()) {
+            return;
+        }
+        m_enabled = true;
+        m_path = path;
+
+        const char *key = getenv("GPI_HIERARCHY_CACHE_KEY");
+        m_key = key ? key : "";
+        m_key += '\0';
+        m_key += registered_impls[0]->get_simulator_product();
+        m_key += '\0';
+        m_key += registered_impls[0]->get_simulator_version();
+
+        // Read in one go, parsing stops at the first inconsistency
+        FILE *f = fopen(path, "rb");
+        if (!f) {
+            LOG_INFO("Hierarchy cache %s not found, it will be created", path);
+            return;
+        }
+        std::vector<char> data;
+        char chunk[65536];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+            data.insert(data.end(), chunk, chunk + n);
+        }
+        fclose(f);
+
+        Reader reader{data.data(), data.data() + data.size()};
+        char magic[sizeof(CACHE_MAGIC) - 1];
+        std::string file_key;
+        uint32_t count;
+        if (!reader.read(magic, sizeof(magic)) ||
+            memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+            !reader.read_string(file_key) ||
+            !reader.read(&count, sizeof(count))) {
+            LOG_WARN("Ignoring invalid hierarchy cache %s", path);
+            return;
+        }
+        if (file_key != m_key) {
+            LOG_INFO("Hierarchy cache %s is for another build, rebuilding it",
+                     path);
+            return;
+        }
+
+        m_entries.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            GpiObjProperties props;
+            std::string fq_name;
+            if (!reader.read(&props, sizeof(props)) ||
+                !reader.read_string(fq_name)) {
+                LOG_WARN("Ignoring truncated hierarchy cache %s", path);
+                m_entries.clear();
+                return;
+            }
+            m_entries[fq_name] = props;
+        }
+
+        LOG_DEBUG("Read %zu entries from hierarchy cache %s", m_entries.size(),
+                  path);
+    }
+
+    std::unordered_map<std::string, GpiObjProperties> m_entries;
+    std::string m_path;
+    std::string m_key;
+    bool m_loaded = false;
+    bool m_enabled = false;
+    bool m_dirty = false;
+};
+
+constexpr const char GpiHierarchyCache::CACHE_MAGIC[];
+
+static GpiHierarchyCache hierarchy_cache;
+
+const GpiObjProperties *gpi_hierarchy_cache_find(const std::string &fq_name) {
+    return hierarchy_cache.find(fq_name);
+}
+
+void gpi_hierarchy_cache_add(const std::string &fq_name,
+                             const GpiObjProperties &props) {
+    hierarchy_cache.add(fq_name, props);
+}
 
 static bool sim_ending = false;
 
@@ -113,13 +665,45 @@ int gpi_register_impl(GpiImplInterface *func_tbl) {
             return -1;
         }
     }
+    if (registered_impls.size() == GpiLookupCache::MAX_IMPLS) {
+        LOG_ERROR("Unable to register %s, at most %zu implementations can be",
+                  func_tbl->get_name_c(), GpiLookupCache::MAX_IMPLS);
+        return -1;
+    }
     registered_impls.push_back(func_tbl);
     return 0;
 }
 
 bool gpi_has_registered_impl() { return registered_impls.size() > 0; }
 
+struct GpiSimHook {
+    void (*start)(void *);
+    void (*end)(void *);
+    void *data;
+};
+static vector<GpiSimHook> sim_hooks;
+
+static int gpi_log_sim_time(uint64_t *time, int32_t *precision) {
+    if (registered_impls.empty()) {
+        return 0;
+    }
+    *time = gpi_get_sim_time64();
+    gpi_get_sim_precision(precision);
+    return 1;
+}
+
+void gpi_register_sim_hooks(void (*start)(void *), void (*end)(void *),
+                            void *data) {
+    sim_hooks.push_back({start, end, data});
+}
+
 void gpi_embed_init(int argc, char const *const *argv) {
+    gpi_native_logger_set_time_source(gpi_log_sim_time);
+    for (auto &hook : sim_hooks) {
+        if (hook.start) {
+            hook.start(hook.data);
+        }
+    }
     if (embed_sim_init(argc, argv)) gpi_embed_end();
 }
 
@@ -133,9 +717,35 @@ void gpi_sim_end() {
     sim_ending = true;
 }
 
+int gpi_set_trace_enabled(int enable) {
+    return registered_impls[0]->set_trace_enabled(enable != 0);
+}
+
+int gpi_save_checkpoint(const char *path) {
+    return registered_impls[0]->save_checkpoint(path);
+}
+
 void gpi_cleanup(void) {
+    if (gpi_stats.enabled) {
+        gpi_stats.log();
+    }
+    hierarchy_cache.save();
+    hierarchy_cache.clear();
+    array_elements.clear();
+    lookup_cache.clear();
     CLEAR_STORE();
+    for (auto &hook : sim_hooks) {
+        if (hook.end) {
+            hook.end(hook.data);
+        }
+    }
+    sim_hooks.clear();
+    gpi_stop_profiler();
+    // Before Python is finalized, as the work may run Python code
+    gpi_stop_worker_pool();
     embed_sim_cleanup();
+    gpi_native_logger_stop_async();
+    gpi_native_logger_set_time_source(nullptr);
 }
 
 static void gpi_load_libs(std::vector<std::string> to_load) {
@@ -179,7 +789,27 @@ static void gpi_load_libs(std::vector<std::string> to_load) {
     }
 }
 
+static void gpi_setup_native_logger() {
+    const char *async_env = getenv("GPI_LOG_ASYNC");
+    const char *binary_path = getenv("GPI_LOG_BINARY_FILE");
+    bool async = async_env && strcmp(async_env, "0") && async_env[0];
+    if (binary_path && binary_path[0]) {
+        async = true;
+    }
+    if (async && gpi_native_logger_start_async(binary_path)) {
+        LOG_ERROR("Unable to open GPI_LOG_BINARY_FILE %s", binary_path);
+    }
+}
+
 void gpi_entry_point() {
+    gpi_setup_native_logger();
+
+    const char *stats_env = getenv("GPI_STATS");
+    if (stats_env && stats_env[0] && strcmp(stats_env, "0")) {
+        gpi_stats.set_enabled(true);
+    }
+    gpi_start_profiler();
+
     /* Lets look at what other libs we were asked to load too */
     char *lib_env = getenv("GPI_EXTRA");
 
@@ -207,14 +837,38 @@ void gpi_entry_point() {
     gpi_print_registered_impl();
 }
 
+/* Depth of the callbacks from the simulator being run, and the simulation
+ * time read during the innermost one, if any */
+static int user_depth = 0;
+static bool sim_time_cached = false;
+static uint64_t sim_time_cache = 0;
+
 void gpi_get_sim_time(uint32_t *high, uint32_t *low) {
-    registered_impls[0]->get_sim_time(high, low);
+    uint64_t time = gpi_get_sim_time64();
+    *high = static_cast<uint32_t>(time >> 32);
+    *low = static_cast<uint32_t>(time);
+}
+
+uint64_t gpi_get_sim_time64() {
+    if (registered_impls.empty()) {
+        return 0;
+    }
+    if (!sim_time_cached) {
+        uint32_t high, low;
+        registered_impls[0]->get_sim_time(&high, &low);
+        sim_time_cache = (static_cast<uint64_t>(high) << 32) | low;
+        // Outside of a callback the simulator may be running, so don't cache
+        sim_time_cached = user_depth > 0;
+    }
+    return sim_time_cache;
 }
 
 void gpi_get_sim_precision(int32_t *precision) {
     /* We clamp to sensible values here, 1e-15 min and 1e3 max */
-    int32_t val;
-    registered_impls[0]->get_sim_precision(&val);
+    int32_t val = 0;
+    if (!registered_impls.empty()) {
+        registered_impls[0]->get_sim_precision(&val);
+    }
     if (val > 2) val = 2;
 
     if (val < -15) val = -15;
@@ -230,7 +884,20 @@ const char *gpi_get_simulator_version() {
     return registered_impls[0]->get_simulator_version();
 }
 
+void gpi_get_handle_store_stats(gpi_handle_store_stats_t *stats) {
+    STORE_STATS(stats);
+}
+
+void gpi_set_stats_enabled(int enable) { gpi_stats.set_enabled(enable != 0); }
+
+int gpi_get_stats(gpi_stats_t *stats) {
+    gpi_stats.get(stats);
+    return gpi_stats.enabled;
+}
+
 gpi_sim_hdl gpi_get_root_handle(const char *name) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(handle_lookups);
     /* May need to look over all the implementations that are registered
        to find this handle */
     vector<GpiImplInterface *>::iterator iter;
@@ -257,17 +924,47 @@ gpi_sim_hdl gpi_get_root_handle(const char *name) {
     }
 }
 
+static uint32_t gpi_impl_mask(GpiImplInterface *impl) {
+    assert(registered_impls.size() <= GpiLookupCache::MAX_IMPLS);
+    for (size_t i = 0; i < registered_impls.size(); i++) {
+        if (registered_impls[i] == impl) {
+            return 1u << i;
+        }
+    }
+    return 0;
+}
+
 static GpiObjHdl *gpi_get_handle_by_name_(GpiObjHdl *parent,
                                           const std::string &name,
                                           GpiImplInterface *skip_impl) {
     LOG_DEBUG("Searching for %s", name.c_str());
 
-    // check parent impl *first* if it's not skipped
-    if (!skip_impl || (skip_impl != parent->m_impl)) {
+    GpiLookupCache::Entry &entry = lookup_cache.get(parent, name);
+
+    if (entry.hdl && (!skip_impl || (skip_impl != entry.hdl->m_impl))) {
+        LOG_DEBUG("Found %s in lookup cache", name.c_str());
+        return entry.hdl;
+    }
+
+    // The cached handle is kept if another implementation finds one
+    auto found = [&entry](GpiObjHdl *hdl) {
+        hdl = CHECK_AND_STORE(hdl);
+        if (!entry.hdl) {
+            entry.hdl = hdl;
+        }
+        return hdl;
+    };
+
+    // check parent impl *first* if it's not skipped or known to fail
+    uint32_t mask = gpi_impl_mask(parent->m_impl);
+    if ((!skip_impl || (skip_impl != parent->m_impl)) &&
+        !(entry.failed_impls & mask)) {
+        COUNT_STAT(native_lookups);
         auto hdl = parent->m_impl->native_check_create(name, parent);
         if (hdl) {
-            return CHECK_AND_STORE(hdl);
+            return found(hdl);
         }
+        entry.failed_impls |= mask;
     }
 
     // iterate over all registered impls to see if we can get the signal
@@ -286,6 +983,13 @@ static GpiObjHdl *gpi_get_handle_by_name_(GpiObjHdl *parent,
             continue;
         }
 
+        mask = gpi_impl_mask(*iter);
+        if (entry.failed_impls & mask) {
+            LOG_DEBUG("%s is known not to be found through implementation %s",
+                      name.c_str(), (*iter)->get_name_c());
+            continue;
+        }
+
         LOG_DEBUG("Checking if %s is native through implementation %s",
                   name.c_str(), (*iter)->get_name_c());
 
@@ -295,13 +999,18 @@ static GpiObjHdl *gpi_get_handle_by_name_(GpiObjHdl *parent,
            be seen discovered even if the parents implementation is not the same
            as the one that we are querying through */
 
+        COUNT_STAT(native_lookups);
         auto hdl = (*iter)->native_check_create(name, parent);
         if (hdl) {
             LOG_DEBUG("Found %s via %s", name.c_str(), (*iter)->get_name_c());
-            return CHECK_AND_STORE(hdl);
+            return found(hdl);
         }
+        entry.failed_impls |= mask;
     }
 
+    if (!entry.hdl) {
+        lookup_cache.add_miss(parent, name, entry);
+    }
     return NULL;
 }
 
@@ -336,6 +1045,8 @@ static GpiObjHdl *gpi_get_handle_by_raw(GpiObjHdl *parent, void *raw_hdl,
 }
 
 gpi_sim_hdl gpi_get_handle_by_name(gpi_sim_hdl base, const char *name) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(handle_lookups);
     std::string s_name = name;
     GpiObjHdl *hdl = gpi_get_handle_by_name_(base, s_name, NULL);
     if (!hdl) {
@@ -348,6 +1059,8 @@ gpi_sim_hdl gpi_get_handle_by_name(gpi_sim_hdl base, const char *name) {
 }
 
 gpi_sim_hdl gpi_get_handle_by_index(gpi_sim_hdl base, int32_t index) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(handle_lookups);
     GpiObjHdl *hdl = NULL;
     GpiImplInterface *intf = base->m_impl;
 
@@ -401,6 +1114,8 @@ gpi_iterator_hdl gpi_iterate(gpi_sim_hdl obj_hdl, gpi_iterator_sel_t type) {
 }
 
 gpi_sim_hdl gpi_next(gpi_iterator_hdl iter) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(iterations);
     std::string name;
     GpiObjHdl *parent = iter->get_parent();
 
@@ -445,6 +1160,59 @@ gpi_sim_hdl gpi_next(gpi_iterator_hdl iter) {
     }
 }
 
+static std::string g_next_name;
+
+const char *gpi_next_name(gpi_iterator_hdl iter, gpi_objtype_t *type) {
+    if (!iter->supports_next_name()) {
+        // The names can only be found by creating the handles
+        gpi_sim_hdl next = gpi_next(iter);
+        if (!next) {
+            return NULL;
+        }
+        g_next_name = next->get_name();
+        *type = next->get_type();
+        return g_next_name.c_str();
+    }
+
+    PROFILE_GPI_CALL();
+    COUNT_STAT(iterations);
+    GpiObjHdl *parent = iter->get_parent();
+
+    while (true) {
+        void *raw_hdl = NULL;
+        GpiIterator::Status ret = iter->next_name(g_next_name, type, &raw_hdl);
+
+        switch (ret) {
+            case GpiIterator::NATIVE:
+                return g_next_name.c_str();
+            case GpiIterator::NATIVE_NO_NAME:
+                LOG_DEBUG("Unable to fully setup handle, skipping");
+                continue;
+            case GpiIterator::NOT_NATIVE:
+                // Left to the other implementations when the handle is created
+                *type = GPI_UNKNOWN;
+                return g_next_name.c_str();
+            case GpiIterator::NOT_NATIVE_NO_NAME: {
+                LOG_DEBUG(
+                    "Found an object but not accessible via %s, trying others",
+                    iter->m_impl->get_name_c());
+                GpiObjHdl *next =
+                    gpi_get_handle_by_raw(parent, raw_hdl, iter->m_impl);
+                if (next) {
+                    g_next_name = next->get_name();
+                    *type = next->get_type();
+                    return g_next_name.c_str();
+                }
+                continue;
+            }
+            case GpiIterator::END:
+                LOG_DEBUG("Reached end of iterator");
+                delete iter;
+                return NULL;
+        }
+    }
+}
+
 const char *gpi_get_definition_name(gpi_sim_hdl obj_hdl) {
     return obj_hdl->get_definition_name();
 }
@@ -456,6 +1224,8 @@ const char *gpi_get_definition_file(gpi_sim_hdl obj_hdl) {
 static std::string g_binstr;
 
 const char *gpi_get_signal_value_binstr(gpi_sim_hdl sig_hdl) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(value_gets);
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
     g_binstr = obj_hdl->get_signal_value_binstr();
     std::transform(g_binstr.begin(), g_binstr.end(), g_binstr.begin(),
@@ -463,17 +1233,31 @@ const char *gpi_get_signal_value_binstr(gpi_sim_hdl sig_hdl) {
     return g_binstr.c_str();
 }
 
+int gpi_get_signal_value_bytes(gpi_sim_hdl sig_hdl, gpi_vecval_t *buf,
+                               int n_words) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(value_gets);
+    GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
+    return obj_hdl->get_signal_value_bytes(buf, n_words);
+}
+
 const char *gpi_get_signal_value_str(gpi_sim_hdl sig_hdl) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(value_gets);
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
     return obj_hdl->get_signal_value_str();
 }
 
 double gpi_get_signal_value_real(gpi_sim_hdl sig_hdl) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(value_gets);
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
     return obj_hdl->get_signal_value_real();
 }
 
 long gpi_get_signal_value_long(gpi_sim_hdl sig_hdl) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(value_gets);
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
     return obj_hdl->get_signal_value_long();
 }
@@ -487,6 +1271,303 @@ const char *gpi_get_signal_type_str(gpi_sim_hdl obj_hdl) {
     return obj_hdl->get_type_str();
 }
 
+// Checks a slice of an array and returns its first element, or NULL if the
+// slice can't be accessed in bulk
+static gpi_sim_hdl gpi_array_slice_first(gpi_sim_hdl arr, int32_t first,
+                                         int count) {
+    if (!arr->get_indexable() || arr->get_num_elems() <= 0) {
+        LOG_ERROR("%s is not an array", arr->get_fullname_str());
+        return NULL;
+    }
+    int64_t low = GpiArrayElementCache::low_index(arr);
+    if (count <= 0 || first < low ||
+        static_cast<int64_t>(first) + count > low + arr->get_num_elems()) {
+        LOG_ERROR("Elements %d to %d are out of the range of %s", first,
+                  first + count - 1, arr->get_fullname_str());
+        return NULL;
+    }
+
+    gpi_sim_hdl elem = array_elements.get(arr, first);
+    if (!elem) {
+        return NULL;
+    }
+    switch (elem->get_type()) {
+        case GPI_NET:
+        case GPI_REGISTER:
+        case GPI_PACKED_STRUCTURE:
+            return elem;
+        default:
+            LOG_ERROR("The elements of %s are not logic objects",
+                      arr->get_fullname_str());
+            return NULL;
+    }
+}
+
+int gpi_get_array_values(gpi_sim_hdl arr, int32_t first, int count,
+                         gpi_vecval_t *buf, int n_words) {
+    PROFILE_GPI_CALL();
+    gpi_sim_hdl elem = gpi_array_slice_first(arr, first, count);
+    if (!elem) {
+        return -1;
+    }
+    // The elements are read through their handles, so that the bulk read
+    // is counted once
+    int n_bits =
+        static_cast<GpiSignalObjHdl *>(elem)->get_signal_value_bytes(NULL, 0);
+    int elem_words = (n_bits + 31) / 32;
+    if (n_bits < 0 || !buf ||
+        static_cast<int64_t>(n_words) <
+            static_cast<int64_t>(elem_words) * count) {
+        return n_bits;
+    }
+
+    COUNT_STAT(value_gets);
+    if (arr->get_array_values(first, count, buf)) {
+        return n_bits;
+    }
+    for (int i = 0; i < count; i++) {
+        elem = array_elements.get(arr, first + i);
+        if (!elem || static_cast<GpiSignalObjHdl *>(elem)
+                             ->get_signal_value_bytes(buf, elem_words) < 0) {
+            return -1;
+        }
+        buf += elem_words;
+    }
+    return n_bits;
+}
+
+int gpi_set_array_values(gpi_sim_hdl arr, int32_t first, int count,
+                         const gpi_vecval_t *buf, int n_bits,
+                         gpi_set_action_t action) {
+    PROFILE_GPI_CALL();
+    gpi_sim_hdl elem = gpi_array_slice_first(arr, first, count);
+    if (!elem) {
+        return -1;
+    }
+    if (static_cast<GpiSignalObjHdl *>(elem)->get_signal_value_bytes(
+            NULL, 0) != n_bits) {
+        LOG_ERROR("The elements of %s do not have %d bits",
+                  arr->get_fullname_str(), n_bits);
+        return -1;
+    }
+
+    COUNT_STAT(value_sets);
+    if (arr->set_array_values(first, count, buf, action)) {
+        return 0;
+    }
+    int elem_words = (n_bits + 31) / 32;
+    for (int i = 0; i < count; i++) {
+        elem = array_elements.get(arr, first + i);
+        if (!elem) {
+            return -1;
+        }
+        static_cast<GpiSignalObjHdl *>(elem)->set_signal_value_vector(
+            buf, n_bits, action);
+        buf += elem_words;
+    }
+    return 0;
+}
+
+/* A read-only view of a range of a file. The range is mapped where the
+ * platform supports it, so that the pages are only read as they are
+ * converted, and read into memory otherwise.
+ */
+class GpiFileImage {
+  public:
+    GpiFileImage() = default;
+    GpiFileImage(const GpiFileImage &) = delete;
+    GpiFileImage &operator=(const GpiFileImage &) = delete;
+
+    ~GpiFileImage() {
+#ifndef _WIN32
+        if (m_map != MAP_FAILED) {
+            munmap(m_map, m_map_len);
+        }
+#endif
+    }
+
+    bool open(const char *path, uint64_t offset, uint64_t length) {
+#ifndef _WIN32
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            LOG_ERROR("Unable to open %s: %s", path, strerror(errno));
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) ||
+            !check_size(path, static_cast<uint64_t>(st.st_size), offset,
+                        length)) {
+            close(fd);
+            return false;
+        }
+        // mmap offsets must be page aligned
+        uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        uint64_t start = offset - offset % page;
+        m_map_len = static_cast<size_t>(offset - start + length);
+        m_map = mmap(NULL, m_map_len, PROT_READ, MAP_PRIVATE, fd,
+                     static_cast<off_t>(start));
+        close(fd);
+        if (m_map == MAP_FAILED) {
+            LOG_ERROR("Unable to map %s: %s", path, strerror(errno));
+            return false;
+        }
+        madvise(m_map, m_map_len, MADV_SEQUENTIAL);
+        m_data = static_cast<const uint8_t *>(m_map) + (offset - start);
+        return true;
+#else
+        FILE *f = fopen(path, "rb");
+        if (!f) {
+            LOG_ERROR("Unable to open %s: %s", path, strerror(errno));
+            return false;
+        }
+        bool ok = _fseeki64(f, 0, SEEK_END) == 0 &&
+                  check_size(path, static_cast<uint64_t>(_ftelli64(f)),
+                             offset, length) &&
+                  _fseeki64(f, static_cast<__int64>(offset), SEEK_SET) == 0;
+        if (ok) {
+            m_buf.resize(static_cast<size_t>(length));
+            ok = fread(m_buf.data(), 1, m_buf.size(), f) == m_buf.size();
+            if (!ok) {
+                LOG_ERROR("Unable to read %s", path);
+            }
+        }
+        fclose(f);
+        m_data = m_buf.data();
+        return ok;
+#endif
+    }
+
+    const uint8_t *data() const { return m_data; }
+
+  private:
+    static bool check_size(const char *path, uint64_t size, uint64_t offset,
+                           uint64_t length) {
+        if (offset > size || length > size - offset) {
+            LOG_ERROR("%s is too small to read %" PRIu64
+                      " bytes at offset %" PRIu64,
+                      path, length, offset);
+            return false;
+        }
+        return true;
+    }
+
+    const uint8_t *m_data = nullptr;
+#ifndef _WIN32
+    void *m_map = MAP_FAILED;
+    size_t m_map_len = 0;
+#else
+    std::vector<uint8_t> m_buf;
+#endif
+};
+
+// Number of elements converted at a time when loading or dumping an array
+#define GPI_ARRAY_FILE_CHUNK 4096
+
+int gpi_load_array_from_file(gpi_sim_hdl arr, const char *path,
+                             uint64_t offset, int32_t first, int count,
+                             gpi_set_action_t action) {
+    int n_bits = gpi_get_array_values(arr, first, count, NULL, 0);
+    if (n_bits < 0) {
+        return -1;
+    }
+    size_t elem_bytes = static_cast<size_t>((n_bits + 7) / 8);
+    size_t elem_words = static_cast<size_t>((n_bits + 31) / 32);
+    uint32_t top_mask =
+        n_bits % 32 ? (UINT32_C(1) << (n_bits % 32)) - 1 : UINT32_MAX;
+
+    GpiFileImage image;
+    if (!image.open(path, offset,
+                    static_cast<uint64_t>(elem_bytes) *
+                        static_cast<uint64_t>(count))) {
+        return -1;
+    }
+
+    std::vector<gpi_vecval_t> words;
+    const uint8_t *in = image.data();
+    for (int done = 0; done < count;) {
+        int chunk = std::min(count - done, GPI_ARRAY_FILE_CHUNK);
+        words.assign(elem_words * static_cast<size_t>(chunk), {0, 0});
+        gpi_vecval_t *out = words.data();
+        for (int i = 0; i < chunk; i++) {
+            for (size_t b = 0; b < elem_bytes; b++) {
+                out[b / 4].aval |= static_cast<uint32_t>(in[b])
+                                   << (8 * (b % 4));
+            }
+            out[elem_words - 1].aval &= top_mask;
+            in += elem_bytes;
+            out += elem_words;
+        }
+        if (gpi_set_array_values(arr, first + done, chunk, words.data(),
+                                 n_bits, action)) {
+            return -1;
+        }
+        done += chunk;
+    }
+    return 0;
+}
+
+int gpi_dump_array_to_file(gpi_sim_hdl arr, const char *path, int32_t first,
+                           int count) {
+    int n_bits = gpi_get_array_values(arr, first, count, NULL, 0);
+    if (n_bits < 0) {
+        return -1;
+    }
+    size_t elem_bytes = static_cast<size_t>((n_bits + 7) / 8);
+    size_t elem_words = static_cast<size_t>((n_bits + 31) / 32);
+
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        LOG_ERROR("Unable to open %s: %s", path, strerror(errno));
+        return -1;
+    }
+
+    std::vector<gpi_vecval_t> words;
+    std::vector<uint8_t> bytes;
+    long unresolved = 0;
+    int ret = 0;
+    for (int done = 0; done < count;) {
+        int chunk = std::min(count - done, GPI_ARRAY_FILE_CHUNK);
+        words.resize(elem_words * static_cast<size_t>(chunk));
+        bytes.resize(elem_bytes * static_cast<size_t>(chunk));
+        if (gpi_get_array_values(arr, first + done, chunk, words.data(),
+                                 static_cast<int>(words.size())) < 0) {
+            ret = -1;
+            break;
+        }
+        const gpi_vecval_t *in = words.data();
+        uint8_t *out = bytes.data();
+        for (int i = 0; i < chunk; i++) {
+            bool resolved = true;
+            for (size_t b = 0; b < elem_bytes; b++) {
+                const gpi_vecval_t &w = in[b / 4];
+                uint32_t shift = static_cast<uint32_t>(8 * (b % 4));
+                uint8_t bval = static_cast<uint8_t>(w.bval >> shift);
+                out[b] = static_cast<uint8_t>((w.aval >> shift) & ~bval);
+                resolved = resolved && !bval;
+            }
+            unresolved += !resolved;
+            in += elem_words;
+            out += elem_bytes;
+        }
+        if (fwrite(bytes.data(), 1, bytes.size(), f) != bytes.size()) {
+            LOG_ERROR("Unable to write %s: %s", path, strerror(errno));
+            ret = -1;
+            break;
+        }
+        done += chunk;
+    }
+    if (fclose(f) && !ret) {
+        LOG_ERROR("Unable to write %s: %s", path, strerror(errno));
+        ret = -1;
+    }
+    if (unresolved) {
+        LOG_WARN("%ld elements of %s dumped to %s hold X or Z bits, which "
+                 "were written as 0",
+                 unresolved, arr->get_fullname_str(), path);
+    }
+    return ret;
+}
+
 gpi_objtype_t gpi_get_object_type(gpi_sim_hdl obj_hdl) {
     return obj_hdl->get_type();
 }
@@ -503,6 +1584,8 @@ int gpi_is_indexable(gpi_sim_hdl obj_hdl) {
 
 void gpi_set_signal_value_int(gpi_sim_hdl sig_hdl, int32_t value,
                               gpi_set_action_t action) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(value_sets);
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
 
     obj_hdl->set_signal_value(value, action);
@@ -510,6 +1593,8 @@ void gpi_set_signal_value_int(gpi_sim_hdl sig_hdl, int32_t value,
 
 void gpi_set_signal_value_binstr(gpi_sim_hdl sig_hdl, const char *binstr,
                                  gpi_set_action_t action) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(value_sets);
     std::string value = binstr;
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
     obj_hdl->set_signal_value_binstr(value, action);
@@ -517,17 +1602,177 @@ void gpi_set_signal_value_binstr(gpi_sim_hdl sig_hdl, const char *binstr,
 
 void gpi_set_signal_value_str(gpi_sim_hdl sig_hdl, const char *str,
                               gpi_set_action_t action) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(value_sets);
     std::string value = str;
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
     obj_hdl->set_signal_value_str(value, action);
 }
 
+void gpi_set_signal_value_vector(gpi_sim_hdl sig_hdl, const gpi_vecval_t *buf,
+                                 int n_bits, gpi_set_action_t action) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(value_sets);
+    GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
+    obj_hdl->set_signal_value_vector(buf, n_bits, action);
+}
+
 void gpi_set_signal_value_real(gpi_sim_hdl sig_hdl, double value,
                                gpi_set_action_t action) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(value_sets);
     GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
     obj_hdl->set_signal_value(value, action);
 }
 
+/* Writes deferred until gpi_apply_queued_writes(). A write to a handle that
+ * already has one queued supersedes it: the earlier entry is left in place
+ * with no handle and skipped, so writes are applied in the order they were
+ * last made, as they would have been without the queue */
+class GpiWriteQueue {
+  public:
+    enum Kind { WRITE_INT, WRITE_REAL, WRITE_BINSTR, WRITE_STR, WRITE_VECTOR };
+
+    struct Write {
+        GpiSignalObjHdl *hdl;
+        Kind kind;
+        gpi_set_action_t action;
+        int32_t int_value;
+        double real_value;
+        int n_bits;
+        size_t offset;  // of the words of a vector value in m_words
+        std::string str;
+    };
+
+    Write &push(GpiSignalObjHdl *hdl, Kind kind, gpi_set_action_t action) {
+        auto it = m_index.find(hdl);
+        if (it != m_index.end()) {
+            m_writes[it->second].hdl = nullptr;
+            it->second = m_writes.size();
+        } else {
+            m_index.emplace(hdl, m_writes.size());
+        }
+        m_writes.push_back({hdl, kind, action, 0, 0.0, 0, 0, std::string()});
+        return m_writes.back();
+    }
+
+    void push_vector(GpiSignalObjHdl *hdl, const gpi_vecval_t *buf, int n_bits,
+                     gpi_set_action_t action) {
+        Write &write = push(hdl, WRITE_VECTOR, action);
+        write.n_bits = n_bits;
+        write.offset = m_words.size();
+        m_words.insert(m_words.end(), buf,
+                       buf + static_cast<size_t>((n_bits + 31) / 32));
+    }
+
+    int apply() {
+        /* Applying a write may run a callback which queues another one, which
+         * then waits for the next call */
+        std::vector<Write> writes;
+        std::vector<gpi_vecval_t> words;
+        writes.swap(m_writes);
+        words.swap(m_words);
+        m_index.clear();
+
+        int n_applied = 0;
+        for (auto &write : writes) {
+            if (!write.hdl) {
+                continue;
+            }
+            switch (write.kind) {
+                case WRITE_INT:
+                    write.hdl->set_signal_value(write.int_value, write.action);
+                    break;
+                case WRITE_REAL:
+                    write.hdl->set_signal_value(write.real_value,
+                                                write.action);
+                    break;
+                case WRITE_BINSTR:
+                    write.hdl->set_signal_value_binstr(write.str,
+                                                       write.action);
+                    break;
+                case WRITE_STR:
+                    write.hdl->set_signal_value_str(write.str, write.action);
+                    break;
+                case WRITE_VECTOR:
+                    write.hdl->set_signal_value_vector(
+                        &words[write.offset], write.n_bits, write.action);
+                    break;
+            }
+            n_applied++;
+        }
+
+        /* Keep the storage for the next batch of writes */
+        if (m_writes.empty()) {
+            writes.clear();
+            words.clear();
+            m_writes.swap(writes);
+            m_words.swap(words);
+        }
+        return n_applied;
+    }
+
+    void clear() {
+        m_writes.clear();
+        m_words.clear();
+        m_index.clear();
+    }
+
+    int size() const { return static_cast<int>(m_index.size()); }
+
+  private:
+    std::vector<Write> m_writes;
+    std::vector<gpi_vecval_t> m_words;
+    std::unordered_map<GpiSignalObjHdl *, size_t> m_index;
+};
+
+static GpiWriteQueue write_queue;
+
+void gpi_queue_signal_value_int(gpi_sim_hdl sig_hdl, int32_t value,
+                                gpi_set_action_t action) {
+    GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
+    write_queue.push(obj_hdl, GpiWriteQueue::WRITE_INT, action).int_value =
+        value;
+}
+
+void gpi_queue_signal_value_binstr(gpi_sim_hdl sig_hdl, const char *binstr,
+                                   gpi_set_action_t action) {
+    GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
+    write_queue.push(obj_hdl, GpiWriteQueue::WRITE_BINSTR, action).str =
+        binstr;
+}
+
+void gpi_queue_signal_value_str(gpi_sim_hdl sig_hdl, const char *str,
+                                gpi_set_action_t action) {
+    GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
+    write_queue.push(obj_hdl, GpiWriteQueue::WRITE_STR, action).str = str;
+}
+
+void gpi_queue_signal_value_vector(gpi_sim_hdl sig_hdl, const gpi_vecval_t *buf,
+                                   int n_bits, gpi_set_action_t action) {
+    GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
+    write_queue.push_vector(obj_hdl, buf, n_bits, action);
+}
+
+void gpi_queue_signal_value_real(gpi_sim_hdl sig_hdl, double value,
+                                 gpi_set_action_t action) {
+    GpiSignalObjHdl *obj_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
+    write_queue.push(obj_hdl, GpiWriteQueue::WRITE_REAL, action).real_value =
+        value;
+}
+
+int gpi_apply_queued_writes() {
+    int n_applied = write_queue.apply();
+    if (gpi_stats.enabled) {
+        gpi_stats.counts.value_sets += static_cast<uint64_t>(n_applied);
+    }
+    return n_applied;
+}
+
+void gpi_clear_queued_writes() { write_queue.clear(); }
+
+int gpi_get_num_queued_writes() { return write_queue.size(); }
+
 int gpi_get_num_elems(gpi_sim_hdl obj_hdl) { return obj_hdl->get_num_elems(); }
 
 int gpi_get_range_left(gpi_sim_hdl obj_hdl) {
@@ -546,6 +1791,8 @@ gpi_cb_hdl gpi_register_value_change_callback(int (*gpi_function)(void *),
                                               void *gpi_cb_data,
                                               gpi_sim_hdl sig_hdl,
                                               gpi_edge_e edge) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(cb_registrations);
     GpiSignalObjHdl *signal_hdl = static_cast<GpiSignalObjHdl *>(sig_hdl);
 
     /* Do something based on int & GPI_RISING | GPI_FALLING */
@@ -554,13 +1801,17 @@ gpi_cb_hdl gpi_register_value_change_callback(int (*gpi_function)(void *),
     if (!gpi_hdl) {
         LOG_ERROR("Failed to register a value change callback");
         return NULL;
-    } else {
-        return gpi_hdl;
     }
+    static const char *const edge_names[] = {"rising edge", "falling edge",
+                                             "value change"};
+    gpi_hdl->set_profile_name(edge_names[edge]);
+    return gpi_hdl;
 }
 
 gpi_cb_hdl gpi_register_timed_callback(int (*gpi_function)(void *),
                                        void *gpi_cb_data, uint64_t time) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(cb_registrations);
     // It should not matter which implementation we use for this so just pick
     // the first one
     GpiCbHdl *gpi_hdl = registered_impls[0]->register_timed_callback(
@@ -568,13 +1819,15 @@ gpi_cb_hdl gpi_register_timed_callback(int (*gpi_function)(void *),
     if (!gpi_hdl) {
         LOG_ERROR("Failed to register a timed callback");
         return NULL;
-    } else {
-        return gpi_hdl;
     }
+    gpi_hdl->set_profile_name("timed");
+    return gpi_hdl;
 }
 
 gpi_cb_hdl gpi_register_readonly_callback(int (*gpi_function)(void *),
                                           void *gpi_cb_data) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(cb_registrations);
     // It should not matter which implementation we use for this so just pick
     // the first one
     GpiCbHdl *gpi_hdl = registered_impls[0]->register_readonly_callback(
@@ -582,13 +1835,15 @@ gpi_cb_hdl gpi_register_readonly_callback(int (*gpi_function)(void *),
     if (!gpi_hdl) {
         LOG_ERROR("Failed to register a readonly callback");
         return NULL;
-    } else {
-        return gpi_hdl;
     }
+    gpi_hdl->set_profile_name("read-only");
+    return gpi_hdl;
 }
 
 gpi_cb_hdl gpi_register_nexttime_callback(int (*gpi_function)(void *),
                                           void *gpi_cb_data) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(cb_registrations);
     // It should not matter which implementation we use for this so just pick
     // the first one
     GpiCbHdl *gpi_hdl = registered_impls[0]->register_nexttime_callback(
@@ -596,13 +1851,15 @@ gpi_cb_hdl gpi_register_nexttime_callback(int (*gpi_function)(void *),
     if (!gpi_hdl) {
         LOG_ERROR("Failed to register a nexttime callback");
         return NULL;
-    } else {
-        return gpi_hdl;
     }
+    gpi_hdl->set_profile_name("next time step");
+    return gpi_hdl;
 }
 
 gpi_cb_hdl gpi_register_readwrite_callback(int (*gpi_function)(void *),
                                            void *gpi_cb_data) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(cb_registrations);
     // It should not matter which implementation we use for this so just pick
     // the first one
     GpiCbHdl *gpi_hdl = registered_impls[0]->register_readwrite_callback(
@@ -610,15 +1867,172 @@ gpi_cb_hdl gpi_register_readwrite_callback(int (*gpi_function)(void *),
     if (!gpi_hdl) {
         LOG_ERROR("Failed to register a readwrite callback");
         return NULL;
-    } else {
-        return gpi_hdl;
     }
+    gpi_hdl->set_profile_name("read-write");
+    return gpi_hdl;
 }
 
 void gpi_deregister_callback(gpi_cb_hdl cb_hdl) {
     cb_hdl->m_impl->deregister_callback(cb_hdl);
 }
 
+static void (*cb_batch_begin)(void *) = nullptr;
+static void (*cb_batch_end)(void *) = nullptr;
+static void *cb_batch_data = nullptr;
+
+void gpi_set_callback_batch_handlers(void (*begin)(void *),
+                                     void (*end)(void *), void *data) {
+    cb_batch_begin = begin;
+    cb_batch_end = end;
+    cb_batch_data = data;
+}
+
+void gpi_begin_callback_batch() {
+    if (cb_batch_begin) {
+        cb_batch_begin(cb_batch_data);
+    }
+}
+
+void gpi_end_callback_batch() {
+    if (cb_batch_end) {
+        cb_batch_end(cb_batch_data);
+    }
+}
+
+/* Ring buffer of the callbacks fired while another is being run
+ *
+ * Some simulators run the callbacks caused by a GPI call before it returns,
+ * e.g. the value changes of a write with vpiNoDelay, so they are queued until
+ * the running callback returns. The buffer only grows, so once it has held
+ * the largest cascade of the simulation it doesn't allocate any more.
+ */
+class GpiCbQueue {
+  public:
+    struct Entry {
+        GpiCbHdl *cb_hdl;  // NULL once deregistered
+        gpi_cb_runner_t run;
+    };
+
+    bool empty() const { return m_head == m_tail; }
+
+    void push(GpiCbHdl *cb_hdl, gpi_cb_runner_t run) {
+        if (m_tail - m_head == m_entries.size()) {
+            grow();
+        }
+        m_entries[m_tail++ & (m_entries.size() - 1)] = {cb_hdl, run};
+    }
+
+    Entry pop() { return m_entries[m_head++ & (m_entries.size() - 1)]; }
+
+    void remove(GpiCbHdl *cb_hdl) {
+        for (size_t i = m_head; i != m_tail; i++) {
+            Entry &entry = m_entries[i & (m_entries.size() - 1)];
+            if (entry.cb_hdl == cb_hdl) {
+                entry.cb_hdl = nullptr;
+            }
+        }
+    }
+
+  private:
+    void grow() {
+        // A power of two, so indices wrap with a mask
+        std::vector<Entry> entries(m_entries.empty() ? 64
+                                                     : 2 * m_entries.size());
+        size_t n = 0;
+        while (!empty()) {
+            entries[n++] = pop();
+        }
+        m_entries.swap(entries);
+        m_head = 0;
+        m_tail = n;
+    }
+
+    std::vector<Entry> m_entries;
+    size_t m_head = 0;
+    size_t m_tail = 0;
+};
+
+static GpiCbQueue cb_queue;
+static bool delivering_callbacks = false;
+// Handles of the one-shot callbacks run, deleted once all have run
+static std::vector<GpiCbHdl *> cb_deletions;
+
+static void gpi_run_queued_callback(GpiCbHdl *cb_hdl, gpi_cb_runner_t run) {
+    if (gpi_stats.enabled) {
+        gpi_stats.counts.cb_runs++;
+    }
+    if (run(cb_hdl)) {
+        cb_deletions.push_back(cb_hdl);
+    }
+}
+
+void gpi_deliver_callback(GpiCbHdl *cb_hdl, gpi_cb_runner_t run) {
+    if (delivering_callbacks) {
+        cb_queue.push(cb_hdl, run);
+        return;
+    }
+    delivering_callbacks = true;
+    gpi_to_user();
+
+    gpi_begin_callback_batch();
+    gpi_run_queued_callback(cb_hdl, run);
+    while (true) {
+        while (!cb_queue.empty()) {
+            auto entry = cb_queue.pop();
+            if (entry.cb_hdl) {
+                gpi_run_queued_callback(entry.cb_hdl, entry.run);
+            }
+        }
+        // Handling a batch of deferred callbacks can queue more
+        gpi_end_callback_batch();
+        if (cb_queue.empty()) {
+            break;
+        }
+        gpi_begin_callback_batch();
+    }
+
+    for (auto deleted : cb_deletions) {
+        delete deleted;
+    }
+    cb_deletions.clear();
+
+    delivering_callbacks = false;
+    gpi_to_simulator();
+}
+
+void gpi_unqueue_callback(GpiCbHdl *cb_hdl) { cb_queue.remove(cb_hdl); }
+
+int gpi_rearm_timed_callback(gpi_cb_hdl cb_hdl, uint64_t time) {
+    PROFILE_GPI_CALL();
+    COUNT_STAT(cb_registrations);
+    if (cb_hdl->get_call_state() != GPI_CALL) {
+        LOG_ERROR("Timed callback can only be re-armed from its own function");
+        return -1;
+    }
+    return cb_hdl->rearm_timer(time);
+}
+
+int gpi_rearm_value_change_callback(gpi_cb_hdl cb_hdl) {
+    if (cb_hdl->get_call_state() != GPI_CALL) {
+        LOG_ERROR(
+            "Value change callback can only be re-armed from its own "
+            "function");
+        return -1;
+    }
+    // The simulator callback stays registered while the handle is primed, as
+    // for changes that don't match the edge of the callback
+    cb_hdl->set_call_state(GPI_PRIMED);
+    return 0;
+}
+
+int gpi_get_callback_value(gpi_cb_hdl cb_hdl, gpi_vecval_t *buf,
+                           int n_words) {
+    if (cb_hdl->get_call_state() != GPI_CALL) {
+        return -1;
+    }
+    return cb_hdl->get_delivered_value(buf, n_words);
+}
+
 void *gpi_get_callback_data(gpi_cb_hdl cb_hdl) {
     return cb_hdl->get_user_data();
 }
@@ -627,9 +2041,25 @@ const char *GpiImplInterface::get_name_c() { return m_name.c_str(); }
 
 const string &GpiImplInterface::get_name_s() { return m_name; }
 
-void gpi_to_user() { LOG_TRACE("Passing control to GPI user"); }
+void gpi_to_user() {
+    if (user_depth++ == 0) {
+        gpi_profile_to_user();
+    }
+    sim_time_cached = false;
+    if (gpi_stats.enabled) {
+        gpi_stats.enter_user();
+    }
+    LOG_TRACE("Passing control to GPI user");
+}
 
 void gpi_to_simulator() {
+    if (--user_depth == 0) {
+        gpi_profile_to_simulator();
+    }
+    sim_time_cached = false;
+    if (gpi_stats.enabled) {
+        gpi_stats.exit_user();
+    }
     if (sim_ending) {
         gpi_cleanup();
     }
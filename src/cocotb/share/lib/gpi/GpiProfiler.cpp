@@ -0,0 +1,206 @@
+// Copyright cocotb contributors
+// Licensed under the Revised BSD License, see LICENSE for details.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <chrono>
+#include <cstdio>
+
+#include "gpi_priv.h"
+
+/* Profile of the simulation, written as a Chrome trace event file
+ *
+ * Enabled by setting GPI_PROFILE_FILE to the path of the file, which can be
+ * opened in Perfetto or chrome://tracing. The events are nested slices on a
+ * single track, timed with the wall clock:
+ *
+ * - "simulator": the simulator running between callbacks.
+ * - "callback": a callback from the simulator, named after its type.
+ * - "gpi": a call made through the GPI, named after the function.
+ * - and those begun by the GPI user, e.g. Python dispatch, triggers and tasks.
+ *
+ * The simulation time is a "sim_time" counter, updated when the first
+ * callback of a time step runs, and the argument of each callback slice.
+ *
+ * The events are written as they happen through the buffer of the file, so
+ * the profile only uses memory for the slices still open. Only the thread
+ * running the simulation may be profiled.
+ */
+class GpiProfiler {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    bool enabled = false;
+
+    bool start(const char *path);
+    void stop();
+
+    void begin(const char *name, const char *category);
+    void begin_callback(const char *name, uint64_t sim_time);
+    void end();
+
+  private:
+    void write_prefix(char phase);
+    void write_string(const char *str);
+
+    FILE *m_file = nullptr;
+    clock::time_point m_since;
+    unsigned int m_depth = 0;
+    uint64_t m_sim_time = 0;
+    bool m_sim_time_valid = false;
+};
+
+bool GpiProfiler::start(const char *path) {
+    m_file = fopen(path, "w");
+    if (!m_file) {
+        LOG_ERROR("Unable to open GPI_PROFILE_FILE %s", path);
+        return false;
+    }
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", m_file);
+    fputs("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+          "\"args\":{\"name\":\"simulation\"}}",
+          m_file);
+    m_since = clock::now();
+    m_depth = 0;
+    m_sim_time_valid = false;
+    enabled = true;
+    return true;
+}
+
+void GpiProfiler::stop() {
+    if (!enabled) {
+        return;
+    }
+    while (m_depth) {
+        end();
+    }
+    enabled = false;
+
+    int32_t precision = 0;
+    if (gpi_has_registered_impl()) {
+        gpi_get_sim_precision(&precision);
+        fputs(",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+              "\"args\":{\"name\":",
+              m_file);
+        write_string(gpi_get_simulator_product());
+        fputs("}}", m_file);
+    }
+    // The precision is the exponent of the unit of sim_time, e.g. -12 for ps
+    fprintf(m_file, "\n],\"otherData\":{\"sim_time_precision\":%d}}\n",
+            precision);
+    if (fclose(m_file)) {
+        LOG_ERROR("Unable to write GPI_PROFILE_FILE");
+    }
+    m_file = nullptr;
+}
+
+void GpiProfiler::write_prefix(char phase) {
+    auto ns = static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() -
+                                                             m_since)
+            .count());
+    // Timestamps are in microseconds
+    fprintf(m_file, ",\n{\"ph\":\"%c\",\"pid\":1,\"tid\":1,\"ts\":%llu.%03llu",
+            phase, ns / 1000, ns % 1000);
+}
+
+void GpiProfiler::write_string(const char *str) {
+    putc('"', m_file);
+    for (; *str; str++) {
+        auto c = static_cast<unsigned char>(*str);
+        if (c == '"' || c == '\\') {
+            putc('\\', m_file);
+            putc(c, m_file);
+        } else if (c < 0x20) {
+            fprintf(m_file, "\\u%04x", c);
+        } else {
+            putc(c, m_file);
+        }
+    }
+    putc('"', m_file);
+}
+
+void GpiProfiler::begin(const char *name, const char *category) {
+    write_prefix('B');
+    fputs(",\"name\":", m_file);
+    write_string(name);
+    fputs(",\"cat\":", m_file);
+    write_string(category);
+    putc('}', m_file);
+    m_depth++;
+}
+
+void GpiProfiler::begin_callback(const char *name, uint64_t sim_time) {
+    if (!m_sim_time_valid || sim_time != m_sim_time) {
+        write_prefix('C');
+        fprintf(m_file,
+                ",\"name\":\"sim_time\",\"args\":{\"value\":%llu}}",
+                static_cast<unsigned long long>(sim_time));
+        m_sim_time = sim_time;
+        m_sim_time_valid = true;
+    }
+    write_prefix('B');
+    fputs(",\"name\":", m_file);
+    write_string(name);
+    fprintf(m_file, ",\"cat\":\"callback\",\"args\":{\"sim_time\":%llu}}",
+            static_cast<unsigned long long>(sim_time));
+    m_depth++;
+}
+
+void GpiProfiler::end() {
+    // Ends without a begin, e.g. from the GPI user, are ignored
+    if (m_depth == 0) {
+        return;
+    }
+    write_prefix('E');
+    putc('}', m_file);
+    m_depth--;
+}
+
+static GpiProfiler gpi_profiler;
+
+void gpi_start_profiler() {
+    const char *path = getenv("GPI_PROFILE_FILE");
+    if (path && path[0] && gpi_profiler.start(path)) {
+        // The simulator runs until the first callback
+        gpi_profiler.begin("simulator", "simulator");
+    }
+}
+
+void gpi_stop_profiler() { gpi_profiler.stop(); }
+
+void gpi_profile_to_user() {
+    if (gpi_profiler.enabled) {
+        gpi_profiler.end();
+    }
+}
+
+void gpi_profile_to_simulator() {
+    if (gpi_profiler.enabled) {
+        gpi_profiler.begin("simulator", "simulator");
+    }
+}
+
+int gpi_run_callback(GpiCbHdl *cb_hdl) {
+    if (!gpi_profiler.enabled) {
+        return cb_hdl->run_callback();
+    }
+    gpi_profiler.begin_callback(cb_hdl->get_profile_name(),
+                                gpi_get_sim_time64());
+    int ret = cb_hdl->run_callback();
+    gpi_profiler.end();
+    return ret;
+}
+
+int gpi_profile_is_enabled() { return gpi_profiler.enabled; }
+
+void gpi_profile_begin(const char *name, const char *category) {
+    if (gpi_profiler.enabled) {
+        gpi_profiler.begin(name, category);
+    }
+}
+
+void gpi_profile_end() {
+    if (gpi_profiler.enabled) {
+        gpi_profiler.end();
+    }
+}
@@ -0,0 +1,201 @@
+// Copyright cocotb contributors
+// Licensed under the Revised BSD License, see LICENSE for details.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "gpi_priv.h"
+
+/* A function submitted to the worker pool.
+ *
+ * Shared by the pool and the holder of the handle, and deleted by whichever
+ * of them is done with it last.
+ */
+class GpiWorkItem {
+  public:
+    GpiWorkItem(void (*func)(void *), void *data)
+        : m_func(func), m_data(data) {}
+
+    void run();
+    bool done() const { return m_done.load(std::memory_order_acquire); }
+    void wait();
+    void release() {
+        if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+  private:
+    void (*m_func)(void *);
+    void *m_data;
+    std::atomic<int> m_refs{2};
+    std::atomic<bool> m_done{false};
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+};
+
+void GpiWorkItem::run() {
+    m_func(m_data);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done.store(true, std::memory_order_release);
+    }
+    m_cond.notify_all();
+}
+
+void GpiWorkItem::wait() {
+    if (done()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this] { return done(); });
+}
+
+class GpiWorkerPool {
+  public:
+    ~GpiWorkerPool() { stop(); }
+
+    // Start the threads if needed, returns false on failure
+    bool start();
+    // Run the work already submitted and join the threads
+    void stop();
+
+    bool submit(GpiWorkItem *item);
+    int num_threads() const {
+        std::lock_guard<std::mutex> lock(m_threads_mutex);
+        return static_cast<int>(m_threads.size());
+    }
+
+  private:
+    void run();
+    // Join the threads, with m_threads_mutex held
+    void join_threads();
+
+    // Guards starting and stopping the threads, which may race when work is
+    // submitted from several threads. Separate from m_mutex so that the
+    // workers can take that while the threads are being started.
+    mutable std::mutex m_threads_mutex;
+    std::vector<std::thread> m_threads;
+    std::deque<GpiWorkItem *> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_stopping = false;
+};
+
+bool GpiWorkerPool::start() {
+    std::lock_guard<std::mutex> threads_lock(m_threads_mutex);
+    if (!m_threads.empty()) {
+        return true;
+    }
+
+    unsigned n_threads = 0;
+    const char *env = getenv("GPI_WORKER_THREADS");
+    if (env && env[0]) {
+        char *end;
+        long n = strtol(env, &end, 10);
+        if (*end != '\0' || n < 1) {
+            LOG_ERROR("GPI_WORKER_THREADS must be a positive integer, got %s",
+                      env);
+            return false;
+        }
+        n_threads = static_cast<unsigned>(n);
+    } else {
+        // Leave a core for the simulator
+        unsigned n_cores = std::thread::hardware_concurrency();
+        n_threads = n_cores > 1 ? n_cores - 1 : 1;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = false;
+    }
+    try {
+        for (unsigned i = 0; i < n_threads; i++) {
+            m_threads.emplace_back(&GpiWorkerPool::run, this);
+        }
+    } catch (const std::system_error &e) {
+        LOG_ERROR("Unable to start the worker pool: %s", e.what());
+        join_threads();
+        return false;
+    }
+    LOG_DEBUG("Started the worker pool with %u threads", n_threads);
+    return true;
+}
+
+void GpiWorkerPool::stop() {
+    std::lock_guard<std::mutex> threads_lock(m_threads_mutex);
+    join_threads();
+}
+
+void GpiWorkerPool::join_threads() {
+    if (m_threads.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cond.notify_all();
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+    m_threads.clear();
+}
+
+bool GpiWorkerPool::submit(GpiWorkItem *item) {
+    if (!start()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(item);
+    }
+    m_cond.notify_one();
+    return true;
+}
+
+void GpiWorkerPool::run() {
+    for (;;) {
+        GpiWorkItem *item;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock,
+                        [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;  // stopping, and all the work has run
+            }
+            item = m_queue.front();
+            m_queue.pop_front();
+        }
+        item->run();
+        item->release();
+    }
+}
+
+static GpiWorkerPool worker_pool;
+
+void gpi_stop_worker_pool() { worker_pool.stop(); }
+
+gpi_work_hdl gpi_submit_work(void (*func)(void *), void *data) {
+    GpiWorkItem *item = new GpiWorkItem(func, data);
+    if (!worker_pool.submit(item)) {
+        delete item;
+        return NULL;
+    }
+    return item;
+}
+
+int gpi_work_done(gpi_work_hdl work_hdl) { return work_hdl->done(); }
+
+void gpi_wait_work(gpi_work_hdl work_hdl) { work_hdl->wait(); }
+
+void gpi_release_work(gpi_work_hdl work_hdl) { work_hdl->release(); }
+
+int gpi_get_num_worker_threads() { return worker_pool.num_threads(); }
@@ -55,6 +55,19 @@ class GpiImplInterface;
 class GpiIterator;
 class GpiCbHdl;
 
+// Properties of an object that are kept in the hierarchy cache, see
+// GpiObjHdl::initialise_from_cache()
+struct GpiObjProperties {
+    int32_t type;
+    int32_t is_const;
+    int32_t num_elems;
+    int32_t indexable;
+    int32_t range_left;
+    int32_t range_right;
+    int32_t range_dir;
+    int32_t length;
+};
+
 /* Base GPI class others are derived from */
 class GPI_EXPORT GpiHdl {
   public:
@@ -100,44 +113,68 @@ class GPI_EXPORT GpiObjHdl : public GpiHdl {
     gpi_objtype_t get_type() { return m_type; };
     bool get_const() { return m_const; };
     int get_num_elems() {
-        LOG_DEBUG("%s has %d elements", m_name.c_str(), m_num_elems);
+        LOG_DEBUG("%s has %d elements", m_name, m_num_elems);
         return m_num_elems;
     }
     int get_range_left() { return m_range_left; }
     int get_range_right() { return m_range_right; }
     gpi_range_dir get_range_dir() {
-        LOG_DEBUG("%s has direction %d", m_name.c_str(), m_range_dir);
+        LOG_DEBUG("%s has direction %d", m_name, m_range_dir);
         return m_range_dir;
     }
     int get_indexable() { return m_indexable; }
 
-    const std::string &get_name();
+    std::string get_name();
     const std::string &get_fullname();
 
     virtual const char *get_definition_name() {
-        return m_definition_name.c_str();
+        return m_definition_name ? m_definition_name : "";
     };
     virtual const char *get_definition_file() {
-        return m_definition_file.c_str();
+        return m_definition_file ? m_definition_file : "";
     };
 
     bool is_native_impl(GpiImplInterface *impl);
     virtual int initialise(const std::string &name,
                            const std::string &full_name);
+    // Like initialise(), but takes the properties of the object from the
+    // hierarchy cache instead of querying the simulator if it has them, and
+    // adds them to the cache otherwise. Only for objects whose initialise()
+    // does nothing but set these properties.
+    int initialise_from_cache(const std::string &name,
+                              const std::string &full_name);
+
+    // Read or write consecutive elements of an array in one go, see
+    // gpi_get_array_values(). The indices have been checked against the range
+    // and the elements are logic objects. Return false if the implementation
+    // can't, the elements are then accessed one by one.
+    virtual bool get_array_values(int32_t, int, gpi_vecval_t *) {
+        return false;
+    }
+    virtual bool set_array_values(int32_t, int, const gpi_vecval_t *,
+                                  gpi_set_action_t) {
+        return false;
+    }
 
   protected:
+    virtual void get_properties(GpiObjProperties &props);
+    virtual void set_properties(const GpiObjProperties &props);
+
+    // Designs can have hundreds of thousands of objects, so only the full
+    // name is stored per object. The name points to its end when it is a
+    // suffix of it, or to an interned string otherwise, as do the definition
+    // strings, which are shared by all the instances of a definition.
+    std::string m_fullname = "unknown";
+    const char *m_name = "unknown";
+    const char *m_definition_name = nullptr;
+    const char *m_definition_file = nullptr;
+
     int m_num_elems = 0;
-    bool m_indexable = false;
     int m_range_left = -1;
     int m_range_right = -1;
     gpi_range_dir m_range_dir = GPI_RANGE_NO_DIR;
-    std::string m_name = "unknown";
-    std::string m_fullname = "unknown";
-
-    std::string m_definition_name;
-    std::string m_definition_file;
-
     gpi_objtype_t m_type;
+    bool m_indexable = false;
     bool m_const;
 };
 
@@ -155,6 +192,8 @@ class GPI_EXPORT GpiSignalObjHdl : public GpiObjHdl {
     virtual const char *get_signal_value_str() = 0;
     virtual double get_signal_value_real() = 0;
     virtual long get_signal_value_long() = 0;
+    // Default implementation packs the value from get_signal_value_binstr()
+    virtual int get_signal_value_bytes(gpi_vecval_t *buf, int n_words);
 
     int m_length = 0;
 
@@ -166,12 +205,26 @@ class GPI_EXPORT GpiSignalObjHdl : public GpiObjHdl {
                                      gpi_set_action_t action) = 0;
     virtual int set_signal_value_binstr(std::string &value,
                                         gpi_set_action_t action) = 0;
+    // Default implementation unpacks the value and uses
+    // set_signal_value_binstr()
+    virtual int set_signal_value_vector(const gpi_vecval_t *buf, int n_bits,
+                                        gpi_set_action_t action);
     // virtual GpiCbHdl monitor_value(bool rising_edge) = 0; this was for the
     // triggers
     // but the explicit ones are probably better
 
     virtual GpiCbHdl *register_value_change_callback(
         gpi_edge_e edge, int (*gpi_function)(void *), void *gpi_cb_data) = 0;
+
+  protected:
+    // Sets bit `bit` of `buf` from a logic character.
+    // Returns false if the character isn't one of 0, 1, X or Z.
+    static bool pack_logic_bit(gpi_vecval_t *buf, int bit, char value);
+    // Returns bit `bit` of `buf` as one of the characters 0, 1, X or Z.
+    static char unpack_logic_bit(const gpi_vecval_t *buf, int bit);
+
+    void get_properties(GpiObjProperties &props) override;
+    void set_properties(const GpiObjProperties &props) override;
 };
 
 /* GPI Callback handle */
@@ -190,16 +243,34 @@ class GPI_EXPORT GpiCbHdl : public GpiHdl {
     void set_call_state(gpi_cb_state_e new_state);
     gpi_cb_state_e get_call_state();
 
+    // Re-arm a fired timed callback to fire again after *time* steps.
+    // Returns nonzero if this callback can't be re-armed.
+    virtual int rearm_timer(uint64_t) { return -1; }
+
+    // Get the value the simulator delivered with the callback being run.
+    // Returns the number of bits, or -1 if no value was delivered.
+    virtual int get_delivered_value(gpi_vecval_t *, int) { return -1; }
+
     int set_user_data(int (*function)(void *), void *cb_data);
     void *get_user_data() noexcept { return m_cb_data; };
 
+    // Name of the callback in the profile, see GPI_PROFILE_FILE
+    void set_profile_name(const char *name) { m_profile_name = name; }
+    const char *get_profile_name() const { return m_profile_name; }
+
     virtual ~GpiCbHdl();
 
+    // Callback objects are created and destroyed at a high rate, so they are
+    // recycled through a pool with a free list per object size.
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
   protected:
     gpi_cb_state_e m_state =
         GPI_FREE;  // GPI state of the callback through its cycle
     int (*gpi_function)(void *) = nullptr;  // GPI function to callback
     void *m_cb_data = nullptr;  // GPI data supplied to "gpi_function"
+    const char *m_profile_name = "callback";
 };
 
 class GPI_EXPORT GpiValueCbHdl : public virtual GpiCbHdl {
@@ -209,7 +280,11 @@ class GPI_EXPORT GpiValueCbHdl : public virtual GpiCbHdl {
     int run_callback() override;
 
   protected:
-    std::string required_value;
+    // Returns true if the signal is at the level of the edge being waited
+    // on. The default implementation reads the value of the signal.
+    virtual bool edge_matches();
+
+    gpi_edge_e m_edge;
     GpiSignalObjHdl *m_signal;
 };
 
@@ -233,6 +308,15 @@ class GPI_EXPORT GpiIterator : public GpiHdl {
         return GpiIterator::END;
     }
 
+    // Iterators that can find the name and type of the next object without
+    // creating a handle for it implement next_name() and return true here
+    virtual bool supports_next_name() { return false; }
+    virtual Status next_name(std::string &name, gpi_objtype_t *type, void **) {
+        name = "";
+        *type = GPI_UNKNOWN;
+        return GpiIterator::END;
+    }
+
     GpiObjHdl *get_parent() { return m_parent; }
 
   protected:
@@ -252,6 +336,10 @@ class GPI_EXPORT GpiImplInterface {
     virtual void get_sim_precision(int32_t *precision) = 0;
     virtual const char *get_simulator_product() = 0;
     virtual const char *get_simulator_version() = 0;
+    // Returns nonzero if the simulator cannot control its trace
+    virtual int set_trace_enabled(bool) { return -1; }
+    // Returns nonzero if the simulator cannot save checkpoints
+    virtual int save_checkpoint(const std::string &) { return -1; }
 
     /* Hierarchy related */
     virtual GpiObjHdl *native_check_create(const std::string &name,
@@ -296,6 +384,46 @@ GPI_EXPORT void gpi_entry_point();
 GPI_EXPORT void gpi_to_user();
 GPI_EXPORT void gpi_to_simulator();
 
+// Called by implementations instead of GpiCbHdl::run_callback(), to profile
+// the callback if GPI_PROFILE_FILE is set
+GPI_EXPORT int gpi_run_callback(GpiCbHdl *cb_hdl);
+
+// Called by implementations around a group of callbacks delivered together
+GPI_EXPORT void gpi_begin_callback_batch();
+GPI_EXPORT void gpi_end_callback_batch();
+
+// Runs a callback fired by the simulator with gpi_run_callback(), returns
+// true if its handle must be deleted
+typedef bool (*gpi_cb_runner_t)(GpiCbHdl *cb_hdl);
+
+// Called by implementations for each callback fired by the simulator. Runs
+// *cb_hdl* with *run*, and then the callbacks fired meanwhile, which are
+// queued, all in one batch and between one gpi_to_user() and
+// gpi_to_simulator(). The handles are deleted once all have run.
+GPI_EXPORT void gpi_deliver_callback(GpiCbHdl *cb_hdl, gpi_cb_runner_t run);
+// Called by implementations when deregistering a callback which may be queued
+GPI_EXPORT void gpi_unqueue_callback(GpiCbHdl *cb_hdl);
+
+// Hierarchy cache, see GpiObjHdl::initialise_from_cache()
+// Returns NULL if the cache is disabled or has no entry for *fq_name*
+/* Returns a copy of str that lives until the end of the simulation, shared by
+ * all equal strings */
+const char *gpi_intern_string(const std::string &str);
+
+const GpiObjProperties *gpi_hierarchy_cache_find(const std::string &fq_name);
+void gpi_hierarchy_cache_add(const std::string &fq_name,
+                             const GpiObjProperties &props);
+
+// Run the work submitted to the worker pool and join its threads
+void gpi_stop_worker_pool();
+
+// Profile of the simulation, see GpiProfiler.cpp
+void gpi_start_profiler();
+void gpi_stop_profiler();
+// Called when the outermost callback is entered and left
+void gpi_profile_to_user();
+void gpi_profile_to_simulator();
+
 typedef void (*layer_entry_func)();
 
 /* Use this macro in an implementation layer to define an entry point */
@@ -30,13 +30,33 @@
 #include <cocotb_utils.h>  // DEFER
 #include <gpi_logging.h>   // this library
 
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdarg>
+#include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <string>
+#include <thread>
 #include <vector>
 
 static gpi_log_handler_type *current_handler = nullptr;
 static void *current_userdata = nullptr;
+// The levels may be set from any thread, so are atomic
+static std::atomic<int> current_native_logger_level(GPIInfo);
+static std::atomic<int> current_min_level(GPIInfo);
+
+extern "C" const char gpi_logger_name[] = "gpi";
+
+extern "C" int gpi_log_enabled(int level) {
+    return level >= current_min_level.load(std::memory_order_relaxed);
+}
+
+extern "C" void gpi_set_log_min_level(int level) {
+    current_min_level.store(level, std::memory_order_relaxed);
+}
 
 extern "C" void gpi_log(const char *name, int level, const char *pathname,
                         const char *funcname, long lineno, const char *msg,
@@ -50,6 +70,11 @@ extern "C" void gpi_log(const char *name, int level, const char *pathname,
 extern "C" void gpi_vlog(const char *name, int level, const char *pathname,
                          const char *funcname, long lineno, const char *msg,
                          va_list argp) {
+    // The minimum level is that of the "gpi" logger, the handler filters
+    // messages of other loggers
+    if (name == gpi_logger_name && !gpi_log_enabled(level)) {
+        return;
+    }
     if (current_handler) {
         (*current_handler)(current_userdata, name, level, pathname, funcname,
                            lineno, msg, argp);
@@ -69,15 +94,15 @@ extern "C" void gpi_set_log_handler(gpi_log_handler_type *handler,
                                     void *userdata) {
     current_handler = handler;
     current_userdata = userdata;
+    current_min_level = 0;
 }
 
 extern "C" void gpi_clear_log_handler(void) {
     current_handler = nullptr;
     current_userdata = nullptr;
+    current_min_level = current_native_logger_level.load();
 }
 
-static int current_native_logger_level = GPIInfo;
-
 extern "C" void gpi_native_logger_log(const char *name, int level,
                                       const char *pathname,
                                       const char *funcname, long lineno,
@@ -112,6 +137,259 @@ const char *log_level(long level) {
     return str;
 }
 
+// Source of the simulation time stamped on native log messages
+static gpi_log_time_source_type *current_time_source = nullptr;
+
+// Set while the time source runs, as it may log itself
+static bool in_time_source = false;
+
+static bool get_log_time(uint64_t *time, int32_t *precision) {
+    if (!current_time_source || in_time_source) {
+        return false;
+    }
+    in_time_source = true;
+    bool has_time = current_time_source(time, precision) != 0;
+    in_time_source = false;
+    return has_time;
+}
+
+// Format a message of the native logger into *buff*, returning its length
+static size_t format_native_log_line(std::vector<char> &buff, bool has_time,
+                                     uint64_t time, int32_t precision,
+                                     int level, const char *name,
+                                     const char *pathname,
+                                     const char *funcname, long lineno,
+                                     const char *msg) {
+    char time_str[32];
+    if (has_time) {
+        double time_ns = (double)time * pow(10.0, precision + 9);
+        snprintf(time_str, sizeof(time_str), "%9.2fns ", time_ns);
+    } else {
+        snprintf(time_str, sizeof(time_str), "     -.--ns ");
+    }
+
+    size_t pathlen = strlen(pathname);
+    const char *path_prefix = "";
+    int path_width = 20;
+    if (pathlen > 20) {
+        path_prefix = "..";
+        path_width = 18;
+        pathname += pathlen - 18;
+    }
+
+    const char *fmt = "%s%-9s%-35s%s%*s:%-4ld in %-31s %s\n";
+    for (;;) {
+        int n = snprintf(buff.data(), buff.size(), fmt, time_str,
+                         log_level(level), name, path_prefix, path_width,
+                         pathname, lineno, funcname, msg);
+        if (n < 0) {
+            // LCOV_EXCL_START
+            return 0;
+            // LCOV_EXCL_STOP
+        }
+        if ((size_t)n < buff.size()) {
+            return (size_t)n;
+        }
+        buff.resize((size_t)n + 1);
+    }
+}
+
+/* Asynchronous mode of the native logger.
+ *
+ * Messages are copied into a ring buffer of fixed size records by the
+ * simulator thread, and formatted and written out in batches by a background
+ * thread, optionally also to a binary log file. There is a single producer,
+ * as the GPI only ever logs from the simulator thread.
+ */
+class AsyncLogWriter {
+  public:
+    bool start(const char *binary_path);
+    void stop();
+
+    // Queue a message, returns false if it doesn't fit in a record
+    bool push(bool has_time, uint64_t time, int32_t precision, int level,
+              const char *name, const char *pathname, const char *funcname,
+              long lineno, const char *msg);
+
+    // Wait until all queued messages have been written
+    void drain();
+
+    bool running() const { return m_running; }
+
+  private:
+    static constexpr size_t NUM_RECORDS = 1024;
+    static constexpr size_t RECORD_SIZE = 1024;
+
+    // Header of each record, followed by the name, path, function name and
+    // message strings without terminators. Also the layout of a record in the
+    // binary log file.
+    struct RecordHeader {
+        uint64_t time;
+        int32_t precision;
+        int32_t level;
+        int32_t lineno;
+        uint16_t name_len;
+        uint16_t path_len;
+        uint16_t func_len;
+        uint16_t flags;  // RECORD_HAS_TIME if the time is known
+        uint32_t msg_len;
+    };
+    static constexpr uint16_t RECORD_HAS_TIME = 1;
+
+    char *record(size_t index) {
+        return &m_records[(index % NUM_RECORDS) * RECORD_SIZE];
+    }
+
+    void run();
+    void write_record(const char *rec);
+
+    std::vector<char> m_records;
+    std::atomic<size_t> m_head{0};  // Next record to write, owned by producer
+    std::atomic<size_t> m_tail{0};  // Next record to read, owned by writer
+    std::atomic<bool> m_stopping{false};
+    bool m_running = false;
+    std::thread m_thread;
+    FILE *m_binary_file = nullptr;
+    std::vector<char> m_line_buff = std::vector<char>(1024);
+};
+
+static AsyncLogWriter async_log_writer;
+
+bool AsyncLogWriter::start(const char *binary_path) {
+    if (m_running) {
+        return true;
+    }
+    if (binary_path && binary_path[0]) {
+        m_binary_file = fopen(binary_path, "wb");
+        if (!m_binary_file) {
+            fprintf(stderr, "Unable to open binary log file %s\n",
+                    binary_path);
+            return false;
+        }
+        fwrite("GPILOG01", 1, 8, m_binary_file);
+    }
+    m_records.resize(NUM_RECORDS * RECORD_SIZE);
+    m_stopping = false;
+    m_thread = std::thread(&AsyncLogWriter::run, this);
+    m_running = true;
+    return true;
+}
+
+void AsyncLogWriter::stop() {
+    if (!m_running) {
+        return;
+    }
+    m_running = false;
+    m_stopping = true;
+    m_thread.join();
+    if (m_binary_file) {
+        fclose(m_binary_file);
+        m_binary_file = nullptr;
+    }
+}
+
+bool AsyncLogWriter::push(bool has_time, uint64_t time, int32_t precision,
+                          int level, const char *name, const char *pathname,
+                          const char *funcname, long lineno, const char *msg) {
+    RecordHeader hdr;
+    size_t name_len = strlen(name);
+    size_t path_len = strlen(pathname);
+    size_t func_len = strlen(funcname);
+    size_t msg_len = strlen(msg);
+    if (sizeof(hdr) + name_len + path_len + func_len + msg_len > RECORD_SIZE) {
+        return false;
+    }
+
+    hdr.time = time;
+    hdr.precision = precision;
+    hdr.level = level;
+    hdr.lineno = (int32_t)lineno;
+    hdr.name_len = (uint16_t)name_len;
+    hdr.path_len = (uint16_t)path_len;
+    hdr.func_len = (uint16_t)func_len;
+    hdr.flags = has_time ? RECORD_HAS_TIME : 0;
+    hdr.msg_len = (uint32_t)msg_len;
+
+    size_t head = m_head.load(std::memory_order_relaxed);
+    while (head - m_tail.load(std::memory_order_acquire) >= NUM_RECORDS) {
+        std::this_thread::yield();  // full, wait for the writer
+    }
+
+    char *p = record(head);
+    memcpy(p, &hdr, sizeof(hdr));
+    p += sizeof(hdr);
+    memcpy(p, name, name_len);
+    p += name_len;
+    memcpy(p, pathname, path_len);
+    p += path_len;
+    memcpy(p, funcname, func_len);
+    p += func_len;
+    memcpy(p, msg, msg_len);
+
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void AsyncLogWriter::drain() {
+    while (m_tail.load(std::memory_order_acquire) !=
+           m_head.load(std::memory_order_relaxed)) {
+        std::this_thread::yield();
+    }
+}
+
+void AsyncLogWriter::write_record(const char *rec) {
+    RecordHeader hdr;
+    memcpy(&hdr, rec, sizeof(hdr));
+    const char *p = rec + sizeof(hdr);
+
+    std::string name(p, hdr.name_len);
+    p += hdr.name_len;
+    std::string pathname(p, hdr.path_len);
+    p += hdr.path_len;
+    std::string funcname(p, hdr.func_len);
+    p += hdr.func_len;
+    std::string msg(p, hdr.msg_len);
+
+    size_t n = format_native_log_line(
+        m_line_buff, hdr.flags & RECORD_HAS_TIME, hdr.time, hdr.precision,
+        hdr.level, name.c_str(), pathname.c_str(), funcname.c_str(),
+        hdr.lineno, msg.c_str());
+    fwrite(m_line_buff.data(), 1, n, stdout);
+
+    if (m_binary_file) {
+        fwrite(rec, 1,
+               sizeof(hdr) + hdr.name_len + hdr.path_len + hdr.func_len +
+                   hdr.msg_len,
+               m_binary_file);
+    }
+}
+
+void AsyncLogWriter::run() {
+    for (;;) {
+        // Read the stop flag first so records queued before it are written
+        bool stopping = m_stopping.load(std::memory_order_acquire);
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t head = m_head.load(std::memory_order_acquire);
+
+        if (tail == head) {
+            if (stopping) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        for (; tail != head; tail++) {
+            write_record(record(tail));
+        }
+        fflush(stdout);
+        if (m_binary_file) {
+            fflush(m_binary_file);
+        }
+        m_tail.store(tail, std::memory_order_release);
+    }
+}
+
 extern "C" void gpi_native_logger_vlog(const char *name, int level,
                                        const char *pathname,
                                        const char *funcname, long lineno,
@@ -161,26 +439,58 @@ extern "C" void gpi_native_logger_vlog(const char *name, int level,
         }
     }
 
-    fprintf(stdout, "     -.--ns ");
-    fprintf(stdout, "%-9s", log_level(level));
-    fprintf(stdout, "%-35s", name);
+    uint64_t time = 0;
+    int32_t precision = 0;
+    bool has_time = get_log_time(&time, &precision);
 
-    size_t pathlen = strlen(pathname);
-    if (pathlen > 20) {
-        fprintf(stdout, "..%18s:", (pathname + (pathlen - 18)));
-    } else {
-        fprintf(stdout, "%20s:", pathname);
+    if (async_log_writer.running()) {
+        if (async_log_writer.push(has_time, time, precision, level, name,
+                                  pathname, funcname, lineno,
+                                  log_buff.data())) {
+            // An unrecoverable error is likely to be followed by a crash
+            if (level >= GPICritical) {
+                async_log_writer.drain();
+            }
+            return;
+        }
+        // Too long for a record, write it directly but keep the order
+        async_log_writer.drain();
     }
 
-    fprintf(stdout, "%-4ld", lineno);
-    fprintf(stdout, " in %-31s ", funcname);
-    fprintf(stdout, "%s", log_buff.data());
-    fprintf(stdout, "\n");
+    static std::vector<char> line_buff(1024);
+    size_t len =
+        format_native_log_line(line_buff, has_time, time, precision, level,
+                               name, pathname, funcname, lineno,
+                               log_buff.data());
+    fwrite(line_buff.data(), 1, len, stdout);
     fflush(stdout);
 }
 
+extern "C" void gpi_native_logger_set_time_source(
+    gpi_log_time_source_type *time_source) {
+    current_time_source = time_source;
+}
+
+extern "C" int gpi_native_logger_start_async(const char *binary_path) {
+    static bool registered_atexit = false;
+    if (!async_log_writer.start(binary_path)) {
+        return -1;
+    }
+    if (!registered_atexit) {
+        // Make sure everything queued is written before the process exits
+        atexit(gpi_native_logger_stop_async);
+        registered_atexit = true;
+    }
+    return 0;
+}
+
+extern "C" void gpi_native_logger_stop_async(void) { async_log_writer.stop(); }
+
 extern "C" int gpi_native_logger_set_level(int level) {
     int old_level = current_native_logger_level;
     current_native_logger_level = level;
+    if (!current_handler) {
+        current_min_level = level;
+    }
     return old_level;
 }
@@ -7,15 +7,38 @@
 #include <gpi_logging.h>     // all things GPI logging
 #include <py_gpi_logging.h>  // this library
 
-#include <cstdarg>  // va_list, va_copy, va_end
-#include <cstdio>   // fprintf, vsnprintf
-#include <vector>   // std::vector
+#include <atomic>          // std::atomic
+#include <cstdarg>         // va_list, va_copy, va_end
+#include <cstdint>         // uint32_t
+#include <cstdio>          // fprintf, vsnprintf
+#include <vector>          // std::vector
 
 static PyObject *pLogHandler = nullptr;
 
 static PyObject *pLogFilter = nullptr;
 
-static int py_gpi_log_level = GPIInfo;
+// The level and configuration may be changed from any thread, while records
+// are only logged from the thread running cocotb
+static std::atomic<int> py_gpi_log_level(GPIInfo);
+
+// Results of calling pLogFilter for the "gpi" logger, as bits indexed by
+// level / 5 that are only valid until its level may have changed, which
+// bumps filter_generation. Other loggers are always filtered by Python, as
+// cocotb isn't told when their configuration changes.
+struct FilterCacheEntry {
+    uint32_t checked = 0;
+    uint32_t enabled = 0;
+};
+static FilterCacheEntry filter_cache;
+static std::atomic<unsigned> filter_generation(0);
+static unsigned filter_cache_generation = 0;
+
+static uint32_t filter_cache_bit(const char *name, int level) {
+    if (name != gpi_logger_name || level < 0 || level % 5 || level / 5 >= 32) {
+        return 0;  // not cached
+    }
+    return 1u << (level / 5);
+}
 
 static void fallback_handler(const char *name, int level, const char *pathname,
                              const char *funcname, long lineno,
@@ -30,10 +53,7 @@ static void fallback_handler(const char *name, int level, const char *pathname,
 static void py_gpi_log_handler(void *, const char *name, int level,
                                const char *pathname, const char *funcname,
                                long lineno, const char *msg, va_list argp) {
-    if (level < py_gpi_log_level) {
-        return;
-    }
-
+    // Messages of the "gpi" logger below its level were dropped by gpi_vlog()
     va_list argp_copy;
     va_copy(argp_copy, argp);
     DEFER(va_end(argp_copy));
@@ -42,6 +62,22 @@ static void py_gpi_log_handler(void *, const char *name, int level,
     PyGILState_STATE gstate = PyGILState_Ensure();
     DEFER(PyGILState_Release(gstate));
 
+    unsigned generation = filter_generation.load(std::memory_order_acquire);
+    if (generation != filter_cache_generation) {
+        filter_cache = FilterCacheEntry();
+        filter_cache_generation = generation;
+    }
+
+    // check the cached filter result first, to avoid formatting the message
+    uint32_t level_bit = filter_cache_bit(name, level);
+    bool filter_known = false;
+    if (filter_cache.checked & level_bit) {
+        if (!(filter_cache.enabled & level_bit)) {
+            return;
+        }
+        filter_known = true;
+    }
+
     static std::vector<char> log_buff(512);
 
     log_buff.clear();
@@ -99,29 +135,40 @@ static void py_gpi_log_handler(void *, const char *name, int level,
     }
     DEFER(Py_DECREF(logger_name_arg));
 
-    // check if log level is enabled
-    PyObject *filter_ret = PyObject_CallFunctionObjArgs(
-        pLogFilter, logger_name_arg, level_arg, NULL);
-    if (filter_ret == NULL) {
-        // LCOV_EXCL_START
-        PyErr_Print();
-        return fallback_handler(name, level, pathname, funcname, lineno,
-                                log_buff.data());
-        // LCOV_EXCL_STOP
-    }
+    // check if log level is enabled, unless already known to be
+    if (!filter_known) {
+        PyObject *filter_ret = PyObject_CallFunctionObjArgs(
+            pLogFilter, logger_name_arg, level_arg, NULL);
+        if (filter_ret == NULL) {
+            // LCOV_EXCL_START
+            PyErr_Print();
+            return fallback_handler(name, level, pathname, funcname, lineno,
+                                    log_buff.data());
+            // LCOV_EXCL_STOP
+        }
 
-    int is_enabled = PyObject_IsTrue(filter_ret);
-    Py_DECREF(filter_ret);
-    if (is_enabled < 0) {
-        // LCOV_EXCL_START
-        PyErr_Print();
-        return fallback_handler(name, level, pathname, funcname, lineno,
-                                log_buff.data());
-        // LCOV_EXCL_STOP
-    }
+        int is_enabled = PyObject_IsTrue(filter_ret);
+        Py_DECREF(filter_ret);
+        if (is_enabled < 0) {
+            // LCOV_EXCL_START
+            PyErr_Print();
+            return fallback_handler(name, level, pathname, funcname, lineno,
+                                    log_buff.data());
+            // LCOV_EXCL_STOP
+        }
 
-    if (!is_enabled) {
-        return;
+        // the filter runs arbitrary Python code which may set the level, so
+        // the result is only cached if it did not
+        if (filter_generation.load(std::memory_order_acquire) == generation) {
+            filter_cache.checked |= level_bit;
+            if (is_enabled) {
+                filter_cache.enabled |= level_bit;
+            }
+        }
+
+        if (!is_enabled) {
+            return;
+        }
     }
 
     PyObject *filename_arg = PyUnicode_FromString(pathname);  // New reference
@@ -181,6 +228,10 @@ static void py_gpi_log_handler(void *, const char *name, int level,
 extern "C" void py_gpi_logger_set_level(int level) {
     py_gpi_log_level = level;
     gpi_native_logger_set_level(level);
+    gpi_set_log_min_level(level);
+    // Called whenever the level of a cocotb logger is set, which may change
+    // the result of the filter for the "gpi" logger
+    filter_generation.fetch_add(1, std::memory_order_release);
 }
 
 extern "C" void py_gpi_logger_initialize(PyObject *handler, PyObject *filter) {
@@ -189,6 +240,7 @@ extern "C" void py_gpi_logger_initialize(PyObject *handler, PyObject *filter) {
     pLogHandler = handler;
     pLogFilter = filter;
     gpi_set_log_handler(py_gpi_log_handler, nullptr);
+    gpi_set_log_min_level(py_gpi_log_level);
 }
 
 extern "C" void py_gpi_logger_finalize() {
@@ -0,0 +1,457 @@
+// Copyright cocotb contributors
+// Licensed under the Revised BSD License, see LICENSE for details.
+// SPDX-License-Identifier: BSD-3-Clause
+
+/* Shared-memory transactor bridge, see cocotb_shm_bridge.h
+ *
+ * Loaded with
+ * GPI_EXTRA=<libs dir>/libcocotbshmbridge.so:cocotbshmbridge_entry_point
+ */
+
+#include <cocotb_shm_bridge.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../gpi/gpi_priv.h"
+
+class ShmBridge {
+  public:
+    bool start();
+    void stop();
+
+    void set_exception_handler(cocotb_shm_exception_handler_t handler) {
+        m_handler = handler;
+    }
+    const cocotb_shm_bridge_stats_t &stats() const { return m_stats; }
+
+  private:
+    struct Signal {
+        gpi_sim_hdl hdl;
+        int n_bits;
+        uint32_t n_words;  // Of the packed value, without the bval words
+    };
+
+    static int edge_cb(void *data);
+    static int drive_cb(void *data);
+
+    bool add_signals(const char *env_name, std::vector<Signal> &signals,
+                     uint32_t &n_words);
+    bool map(const char *name, uint32_t num_slots, uint32_t slot_size);
+    bool remove_stale(const char *name);
+    void fail();
+    void sample();
+    void drive(cocotb_shm_slot_t *slot);
+    void handle_exception(cocotb_shm_slot_t *slot);
+    cocotb_shm_slot_t *reserve_from_sim();
+
+    std::string m_name;
+    uint32_t m_timeout_s = 60;
+    cocotb_shm_header_t *m_hdr = nullptr;
+    size_t m_size = 0;
+    gpi_cb_hdl m_edge_cb = nullptr;
+    bool m_drive_pending = false;
+    std::vector<Signal> m_drive;
+    std::vector<Signal> m_sample;
+    uint32_t m_drive_words = 0;  // aval and bval words of a drive payload
+    uint32_t m_sample_words = 0;
+    cocotb_shm_exception_handler_t m_handler = nullptr;
+    cocotb_shm_bridge_stats_t m_stats = {};
+};
+
+// Looks up a handle by a path relative to the toplevel, e.g. "bus.valid"
+static gpi_sim_hdl find_signal(const std::string &path) {
+    gpi_sim_hdl hdl = gpi_get_root_handle(NULL);
+    size_t pos = 0;
+    while (hdl) {
+        size_t end = path.find('.', pos);
+        hdl = gpi_get_handle_by_name(hdl, path.substr(pos, end - pos).c_str());
+        if (end == std::string::npos) {
+            break;
+        }
+        pos = end + 1;
+    }
+    return hdl;
+}
+
+bool ShmBridge::add_signals(const char *env_name, std::vector<Signal> &signals,
+                            uint32_t &n_words) {
+    const char *env = getenv(env_name);
+    if (!env || !env[0]) {
+        return true;
+    }
+
+    std::string list = env;
+    size_t pos = 0;
+    for (;;) {
+        size_t end = list.find(',', pos);
+        std::string path = list.substr(pos, end - pos);
+        gpi_sim_hdl hdl = find_signal(path);
+        int n_bits = hdl ? gpi_get_signal_value_bytes(hdl, NULL, 0) : -1;
+        if (n_bits <= 0) {
+            LOG_ERROR("%s: %s is not a logic signal", env_name, path.c_str());
+            return false;
+        }
+        uint32_t words = (static_cast<uint32_t>(n_bits) + 31) / 32;
+        signals.push_back({hdl, n_bits, words});
+        n_words += 2 * words;
+        if (end == std::string::npos) {
+            return true;
+        }
+        pos = end + 1;
+    }
+}
+
+static bool process_alive(uint32_t pid) {
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+}
+
+// Removes the object of a simulation which has exited, returns false if it
+// is still in use
+bool ShmBridge::remove_stale(const char *name) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return errno == ENOENT;
+    }
+    struct stat st;
+    uint32_t sim_pid = 0;
+    if (fstat(fd, &st) == 0 &&
+        static_cast<size_t>(st.st_size) >= sizeof(cocotb_shm_header_t)) {
+        void *mem = mmap(NULL, sizeof(cocotb_shm_header_t), PROT_READ,
+                         MAP_SHARED, fd, 0);
+        if (mem != MAP_FAILED) {
+            sim_pid = __atomic_load_n(
+                &static_cast<cocotb_shm_header_t *>(mem)->sim_pid,
+                __ATOMIC_ACQUIRE);
+            munmap(mem, sizeof(cocotb_shm_header_t));
+        }
+    }
+    close(fd);
+
+    // An object being created has no pid yet, and is left alone
+    if (sim_pid == 0 || process_alive(sim_pid)) {
+        return false;
+    }
+    LOG_INFO("Removing shared memory %s left over by process %u", name,
+             sim_pid);
+    return shm_unlink(name) == 0 || errno == ENOENT;
+}
+
+bool ShmBridge::map(const char *name, uint32_t num_slots, uint32_t slot_size) {
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST && remove_stale(name)) {
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    }
+    if (fd < 0 && errno == EEXIST) {
+        LOG_ERROR(
+            "Unable to create shared memory %s: it is used by another "
+            "simulation",
+            name);
+        return false;
+    }
+    if (fd < 0) {
+        LOG_ERROR("Unable to create shared memory %s: %s", name,
+                  strerror(errno));
+        return false;
+    }
+    m_name = name;
+
+    m_size = cocotb_shm_size(num_slots, slot_size);
+    void *mem = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(m_size)) == 0) {
+        mem = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mem == MAP_FAILED) {
+        LOG_ERROR("Unable to map shared memory %s: %s", name, strerror(errno));
+        stop();
+        return false;
+    }
+
+    // ftruncate() zeroes the memory, which leaves the rings empty
+    m_hdr = static_cast<cocotb_shm_header_t *>(mem);
+    m_hdr->magic = COCOTB_SHM_BRIDGE_MAGIC;
+    m_hdr->version = COCOTB_SHM_BRIDGE_VERSION;
+    m_hdr->num_slots = num_slots;
+    m_hdr->slot_size = slot_size;
+    m_hdr->sim_pid = static_cast<uint32_t>(getpid());
+    __atomic_store_n(&m_hdr->ready, 1u, __ATOMIC_RELEASE);
+    return true;
+}
+
+static bool get_env_uint(const char *name, uint32_t &value) {
+    const char *env = getenv(name);
+    if (!env || !env[0]) {
+        return true;
+    }
+    char *end;
+    unsigned long n = strtoul(env, &end, 10);
+    if (*end != '\0' || n == 0 || n > UINT32_MAX / 2) {
+        LOG_ERROR("%s must be a positive integer, got %s", name, env);
+        return false;
+    }
+    value = static_cast<uint32_t>(n);
+    return true;
+}
+
+bool ShmBridge::start() {
+    const char *name = getenv("GPI_SHM_BRIDGE");
+    if (!name || !name[0]) {
+        LOG_WARN("GPI_SHM_BRIDGE is not set, the bridge is disabled");
+        return true;
+    }
+    const char *clock = getenv("GPI_SHM_BRIDGE_CLOCK");
+    if (!clock || !clock[0]) {
+        LOG_ERROR("GPI_SHM_BRIDGE_CLOCK must be set");
+        return false;
+    }
+    gpi_sim_hdl clk_hdl = find_signal(clock);
+    if (!clk_hdl) {
+        LOG_ERROR("GPI_SHM_BRIDGE_CLOCK: Unable to find %s", clock);
+        return false;
+    }
+
+    if (!add_signals("GPI_SHM_BRIDGE_DRIVE", m_drive, m_drive_words) ||
+        !add_signals("GPI_SHM_BRIDGE_SAMPLE", m_sample, m_sample_words)) {
+        return false;
+    }
+
+    uint32_t num_slots = 1024;
+    uint32_t slot_size = 256;
+    if (!get_env_uint("GPI_SHM_BRIDGE_SLOTS", num_slots) ||
+        !get_env_uint("GPI_SHM_BRIDGE_SLOT_SIZE", slot_size) ||
+        !get_env_uint("GPI_SHM_BRIDGE_TIMEOUT", m_timeout_s)) {
+        return false;
+    }
+    uint32_t min_size = static_cast<uint32_t>(sizeof(cocotb_shm_slot_t)) +
+                        4 * std::max(m_drive_words, m_sample_words);
+    // Keep the slots aligned for the 64-bit time
+    slot_size = (std::max(slot_size, min_size) + 7) & ~7u;
+
+    if (!map(name, num_slots, slot_size)) {
+        return false;
+    }
+
+    m_edge_cb = gpi_register_value_change_callback(edge_cb, this, clk_hdl,
+                                                   GPI_RISING);
+    if (!m_edge_cb) {
+        LOG_ERROR("Unable to register a callback on %s", clock);
+        stop();
+        return false;
+    }
+    LOG_INFO("Bridging %s on %s: driving %zu and sampling %zu signals", name,
+             clock, m_drive.size(), m_sample.size());
+    return true;
+}
+
+void ShmBridge::stop() {
+    if (m_hdr) {
+        munmap(m_hdr, m_size);
+        m_hdr = nullptr;
+    }
+    if (!m_name.empty()) {
+        shm_unlink(m_name.c_str());
+        m_name.clear();
+    }
+    m_edge_cb = nullptr;
+}
+
+// Stops bridging and ends the simulation, the error has been logged
+void ShmBridge::fail() {
+    stop();
+    gpi_sim_end();
+}
+
+cocotb_shm_slot_t *ShmBridge::reserve_from_sim() {
+    cocotb_shm_slot_t *slot = cocotb_shm_reserve(m_hdr, &m_hdr->from_sim);
+    if (slot) {
+        return slot;
+    }
+
+    // Wait for the external process to catch up, as long as it is alive
+    m_stats.full_waits++;
+    using clock = std::chrono::steady_clock;
+    auto deadline = clock::now() + std::chrono::seconds(m_timeout_s);
+    for (;;) {
+        sched_yield();
+        slot = cocotb_shm_reserve(m_hdr, &m_hdr->from_sim);
+        if (slot) {
+            return slot;
+        }
+        uint32_t peer = __atomic_load_n(&m_hdr->peer_pid, __ATOMIC_RELAXED);
+        if (peer && !process_alive(peer)) {
+            LOG_ERROR("The external process %u of %s has exited", peer,
+                      m_name.c_str());
+            break;
+        }
+        if (clock::now() >= deadline) {
+            LOG_ERROR(
+                "The external process of %s made no space for %u seconds, "
+                "see GPI_SHM_BRIDGE_TIMEOUT",
+                m_name.c_str(), m_timeout_s);
+            break;
+        }
+    }
+    m_stats.errors++;
+    fail();
+    return nullptr;
+}
+
+void ShmBridge::sample() {
+    cocotb_shm_slot_t *slot = reserve_from_sim();
+    if (!slot) {
+        return;
+    }
+    slot->time = gpi_get_sim_time64();
+    slot->flags = 0;
+    slot->n_words = m_sample_words;
+
+    auto *words = reinterpret_cast<gpi_vecval_t *>(cocotb_shm_payload(slot));
+    for (const auto &sig : m_sample) {
+        gpi_get_signal_value_bytes(sig.hdl, words,
+                                   static_cast<int>(sig.n_words));
+        words += sig.n_words;
+    }
+    cocotb_shm_commit(&m_hdr->from_sim);
+    m_stats.sampled++;
+}
+
+void ShmBridge::drive(cocotb_shm_slot_t *slot) {
+    if (slot->n_words != m_drive_words) {
+        LOG_ERROR("Dropping a transaction of %u words, expected %u",
+                  slot->n_words, m_drive_words);
+        m_stats.errors++;
+        return;
+    }
+    auto *words = reinterpret_cast<gpi_vecval_t *>(cocotb_shm_payload(slot));
+    for (const auto &sig : m_drive) {
+        gpi_set_signal_value_vector(sig.hdl, words, sig.n_bits, GPI_DEPOSIT);
+        words += sig.n_words;
+    }
+    m_stats.driven++;
+}
+
+void ShmBridge::handle_exception(cocotb_shm_slot_t *slot) {
+    m_stats.exceptions++;
+    uint32_t max_words = cocotb_shm_max_words(m_hdr);
+    if (slot->n_words > max_words) {
+        LOG_ERROR("Dropping an exception transaction of %u words, at most %u "
+                  "fit in a slot",
+                  slot->n_words, max_words);
+        m_stats.errors++;
+        return;
+    }
+    if (!m_handler) {
+        LOG_ERROR("Dropping an exception transaction, no handler is set");
+        m_stats.errors++;
+        return;
+    }
+
+    // The response is sampled at the time of the transaction
+    cocotb_shm_slot_t *resp = reserve_from_sim();
+    if (!resp) {
+        return;
+    }
+    int n_words = m_handler(cocotb_shm_payload(slot), slot->n_words,
+                            cocotb_shm_payload(resp), max_words);
+    if (n_words < 0) {
+        return;
+    }
+    if (static_cast<uint32_t>(n_words) > max_words) {
+        LOG_ERROR("Dropping a response of %d words, at most %u fit in a slot",
+                  n_words, max_words);
+        m_stats.errors++;
+        return;
+    }
+    resp->time = gpi_get_sim_time64();
+    resp->flags = COCOTB_SHM_TXN_EXCEPTION;
+    resp->n_words = static_cast<uint32_t>(n_words);
+    cocotb_shm_commit(&m_hdr->from_sim);
+}
+
+int ShmBridge::edge_cb(void *data) {
+    auto *bridge = static_cast<ShmBridge *>(data);
+    // Not re-armed once the bridge has stopped
+    if (!bridge->m_hdr) {
+        return 0;
+    }
+    gpi_rearm_value_change_callback(bridge->m_edge_cb);
+
+    if (!bridge->m_sample.empty()) {
+        bridge->sample();
+        if (!bridge->m_hdr) {
+            return 0;
+        }
+    }
+    // Drive after the design has seen the edge, like writes from cocotb
+    if (!bridge->m_drive_pending &&
+        cocotb_shm_peek(bridge->m_hdr, &bridge->m_hdr->to_sim)) {
+        if (gpi_register_readwrite_callback(drive_cb, bridge)) {
+            bridge->m_drive_pending = true;
+        } else {
+            LOG_ERROR("Unable to register a read-write callback");
+        }
+    }
+    return 0;
+}
+
+int ShmBridge::drive_cb(void *data) {
+    auto *bridge = static_cast<ShmBridge *>(data);
+    bridge->m_drive_pending = false;
+    if (!bridge->m_hdr) {
+        return 0;
+    }
+
+    cocotb_shm_slot_t *slot =
+        cocotb_shm_peek(bridge->m_hdr, &bridge->m_hdr->to_sim);
+    if (slot->flags & COCOTB_SHM_TXN_EXCEPTION) {
+        bridge->handle_exception(slot);
+    } else {
+        bridge->drive(slot);
+    }
+    if (bridge->m_hdr) {
+        cocotb_shm_release(&bridge->m_hdr->to_sim);
+    }
+    return 0;
+}
+
+static ShmBridge bridge;
+
+static void bridge_start(void *) {
+    if (!bridge.start()) {
+        gpi_sim_end();
+    }
+}
+
+static void bridge_end(void *) { bridge.stop(); }
+
+static void register_hooks() {
+    gpi_register_sim_hooks(bridge_start, bridge_end, nullptr);
+}
+
+GPI_ENTRY_POINT(cocotbshmbridge, register_hooks)
+
+extern "C" {
+
+// Set the handler of exception transactions, called from the simulator
+// thread. Pass NULL to drop them.
+COCOTB_EXPORT void cocotbshmbridge_set_exception_handler(
+    cocotb_shm_exception_handler_t handler) {
+    bridge.set_exception_handler(handler);
+}
+
+COCOTB_EXPORT void cocotbshmbridge_get_stats(cocotb_shm_bridge_stats_t *stats) {
+    *stats = bridge.stats();
+}
+}
@@ -38,9 +38,11 @@
 #include <cocotb_utils.h>    // to_python to_simulator
 #include <py_gpi_logging.h>  // py_gpi_logger_set_level
 
+#include <algorithm>
 #include <cerrno>
 #include <limits>
 #include <type_traits>
+#include <vector>
 
 #include "gpi.h"
 
@@ -53,10 +55,35 @@
 
 #define MODULE_NAME "simulator"
 
+// A comparison of the value of a signal, evaluated before calling into Python
+// so that callbacks only reach Python once it holds
+struct ValueMatch {
+    gpi_sim_hdl signal;
+    int width;
+    bool negate;  // Match when the compared bits differ instead
+    std::vector<uint32_t> value;  // Expected value of the compared bits
+    std::vector<uint32_t> mask;   // Bits that are compared
+    std::vector<gpi_vecval_t> words;  // Scratch space for the current value
+    gpi_cb_hdl cb_hdl = nullptr;
+
+    // Compared bits which are X, Z or any other unresolved state never equal
+    // the expected value
+    bool matches() {
+        int n_words = static_cast<int>(words.size());
+        bool equal =
+            gpi_get_signal_value_bytes(signal, words.data(), n_words) == width;
+        for (size_t i = 0; equal && i < words.size(); i++) {
+            equal = !((words[i].bval | (words[i].aval ^ value[i])) & mask[i]);
+        }
+        return equal != negate;
+    }
+};
+
 // callback user data
 struct PythonCallback {
-    PythonCallback(PyObject *func, PyObject *_args, PyObject *_kwargs)
-        : function(func), args(_args), kwargs(_kwargs) {
+    PythonCallback(PyObject *func, PyObject *_args, PyObject *_kwargs,
+                   PyObject *_arg = NULL)
+        : function(func), args(_args), kwargs(_kwargs), arg(_arg) {
         // All PyObject references are stolen.
         // Arguments may be NULL.
     }
@@ -64,17 +91,107 @@ struct PythonCallback {
         Py_XDECREF(function);
         Py_XDECREF(args);
         Py_XDECREF(kwargs);
+        Py_XDECREF(arg);
+        delete match;
+    }
+
+    // Call the function, returning a new reference to the result or NULL if
+    // an exception was raised
+    PyObject *call() {
+        if (!args) {
+            // Every trigger passes at most one argument, so skip building an
+            // argument tuple and use the cheapest call available
+#if PY_VERSION_HEX >= 0x03090000
+            return arg ? PyObject_CallOneArg(function, arg)
+                       : PyObject_CallNoArgs(function);
+#else
+            return PyObject_CallFunctionObjArgs(function, arg, NULL);
+#endif
+        }
+        return PyObject_Call(function, args, kwargs);
     }
+
+    // One of these is created for every trigger, so freed callbacks are kept
+    // on a free list for re-use
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
+
     uint32_t id_value =
         COCOTB_ACTIVE_ID;  // COCOTB_ACTIVE_ID or COCOTB_INACTIVE_ID
     PyObject *function;    // Function to call when the callback fires
     PyObject *args;        // The arguments to call the function with
     PyObject *kwargs;      // Keyword arguments to call the function with
+    PyObject *arg;  // The single argument to call the function with if args
+                    // is NULL, or NULL for no arguments
+    bool batchable = false;  // May be deferred into a batch of callbacks
+    ValueMatch *match = nullptr;  // Only call the function once this matches
 };
 
+static constexpr size_t PYTHON_CALLBACK_FREE_LIST_SIZE = 256;
+// Never destroyed, as callbacks may still be freed during static destruction
+static std::vector<void *> &python_callback_free_list =
+    *new std::vector<void *>();
+
+void *PythonCallback::operator new(size_t size) {
+    if (python_callback_free_list.empty()) {
+        return ::operator new(size);
+    }
+    void *ptr = python_callback_free_list.back();
+    python_callback_free_list.pop_back();
+    return ptr;
+}
+
+void PythonCallback::operator delete(void *ptr) {
+    if (python_callback_free_list.size() < PYTHON_CALLBACK_FREE_LIST_SIZE) {
+        python_callback_free_list.push_back(ptr);
+    } else {
+        ::operator delete(ptr);
+    }
+}
+
+// Create the callback data for a registration, passing the *nargs* - *first*
+// items of *args* from index *first* on to *function* when the callback fires.
+// Steals the reference to *function*, returns NULL on failure.
+static PythonCallback *new_python_callback(PyObject *function,
+                                           PyObject *const *args,
+                                           Py_ssize_t nargs, Py_ssize_t first) {
+    if (nargs - first <= 1) {
+        PyObject *arg = NULL;
+        if (nargs > first) {
+            arg = args[first];
+            Py_INCREF(arg);
+        }
+        return new PythonCallback(function, NULL, NULL, arg);
+    }
+
+    // Remaining args for function
+    PyObject *fArgs = PyTuple_New(nargs - first);  // New reference
+    if (fArgs == NULL) {
+        Py_DECREF(function);
+        return NULL;
+    }
+    for (Py_ssize_t i = first; i < nargs; i++) {
+        Py_INCREF(args[i]);
+        PyTuple_SET_ITEM(fArgs, i - first, args[i]);
+    }
+    return new PythonCallback(function, fArgs, NULL);
+}
+
 class GpiClock;
 using gpi_clk_hdl = GpiClock *;
 
+class GpiSignalGroup;
+using gpi_group_hdl = GpiSignalGroup *;
+
+class GpiRecorder;
+using gpi_rec_hdl = GpiRecorder *;
+
+struct GpiValueAccessor;
+using gpi_accessor_hdl = GpiValueAccessor *;
+
+struct GpiPyWork;
+using gpi_pywork_hdl = GpiPyWork *;
+
 /* define the extension types as templates */
 namespace {
 template <typename gpi_hdl>
@@ -121,6 +238,106 @@ static PyObject *gpi_hdl_New(gpi_hdl hdl) {
     return (PyObject *)obj;
 }
 
+/* The hot methods take their arguments as a C array rather than a tuple,
+ * using the METH_FASTCALL calling convention of Python 3.7+. On older
+ * versions they are called through an adapter unpacking the tuple.
+ */
+#if PY_VERSION_HEX >= 0x03070000
+#define FASTCALL_METHOD(func) \
+    (PyCFunction)(void (*)(void))(func), METH_FASTCALL
+#else
+template <typename F, F func>
+struct fastcall_adapter;
+
+template <typename Self,
+          PyObject *(*func)(Self *, PyObject *const *, Py_ssize_t)>
+struct fastcall_adapter<PyObject *(*)(Self *, PyObject *const *, Py_ssize_t),
+                        func> {
+    static PyObject *call(Self *self, PyObject *args) {
+        return func(self, ((PyTupleObject *)args)->ob_item,
+                    PyTuple_GET_SIZE(args));
+    }
+};
+
+#define FASTCALL_METHOD(func)                                           \
+    (PyCFunction)(fastcall_adapter<decltype(&func), &func>::call), \
+        METH_VARARGS
+#endif
+
+// Raises TypeError like PyArg_ParseTuple if *nargs* is not *expected*
+static bool check_nargs(const char *name, Py_ssize_t nargs,
+                        Py_ssize_t expected) {
+    if (nargs != expected) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s() takes exactly %zd arguments (%zd given)", name,
+                     expected, nargs);
+        return false;
+    }
+    return true;
+}
+
+// Converts an int argument as the "i" format of PyArg_ParseTuple
+static bool parse_int_arg(PyObject *obj, int *value) {
+    if (PyFloat_Check(obj)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "integer argument expected, got float");
+        return false;
+    }
+    long v = PyLong_AsLong(obj);
+    if (v == -1 && PyErr_Occurred()) {
+        return false;
+    }
+    if (v < std::numeric_limits<int>::min() ||
+        v > std::numeric_limits<int>::max()) {
+        PyErr_SetString(PyExc_OverflowError,
+                        "signed integer is out of range for C int");
+        return false;
+    }
+    *value = static_cast<int>(v);
+    return true;
+}
+
+static bool parse_action_arg(PyObject *obj, gpi_set_action_t *action) {
+    int value;
+    if (!parse_int_arg(obj, &value)) {
+        return false;
+    }
+    *action = static_cast<gpi_set_action_t>(value);
+    return true;
+}
+
+// Converts a str or bytes argument with no embedded null character to a C
+// string, as the "s" and "y" formats of PyArg_ParseTuple
+static const char *parse_string_arg(PyObject *obj, bool bytes) {
+    const char *str;
+    Py_ssize_t len;
+    if (bytes) {
+        if (!PyBytes_Check(obj)) {
+            PyErr_Format(PyExc_TypeError, "a bytes-like object is required, "
+                                          "not '%s'",
+                         Py_TYPE(obj)->tp_name);
+            return NULL;
+        }
+        str = PyBytes_AS_STRING(obj);
+        len = PyBytes_GET_SIZE(obj);
+    } else {
+        if (!PyUnicode_Check(obj)) {
+            PyErr_Format(PyExc_TypeError, "str expected, not %s",
+                         Py_TYPE(obj)->tp_name);
+            return NULL;
+        }
+        str = PyUnicode_AsUTF8AndSize(obj, &len);
+        if (!str) {
+            return NULL;
+        }
+    }
+    if (strlen(str) != static_cast<size_t>(len)) {
+        PyErr_SetString(PyExc_ValueError, "embedded null character");
+        return NULL;
+    }
+    return str;
+}
+
 /** Comparison checks if the types match, and then compares pointers */
 template <typename gpi_hdl>
 static PyObject *gpi_hdl_richcompare(PyObject *self, PyObject *other, int op) {
@@ -164,6 +381,14 @@ template <>
 PyTypeObject gpi_hdl_Object<gpi_cb_hdl>::py_type;
 template <>
 PyTypeObject gpi_hdl_Object<gpi_clk_hdl>::py_type;
+template <>
+PyTypeObject gpi_hdl_Object<gpi_group_hdl>::py_type;
+template <>
+PyTypeObject gpi_hdl_Object<gpi_rec_hdl>::py_type;
+template <>
+PyTypeObject gpi_hdl_Object<gpi_accessor_hdl>::py_type;
+template <>
+PyTypeObject gpi_hdl_Object<gpi_pywork_hdl>::py_type;
 }  // namespace
 
 typedef int (*gpi_function_t)(void *);
@@ -173,6 +398,99 @@ struct sim_time {
     uint32_t low;
 };
 
+// cocotb runs on the thread the simulator calls it from, which is the thread
+// importing this module. Other threads run while the simulator does, as the
+// GIL is released between callbacks, and free-threaded builds have no GIL at
+// all, so every call reaching the GPI or the state of this module checks it
+// is made from it. Only comparing handles and polling offloaded work are
+// allowed from other threads.
+static unsigned long sim_thread_ident = 0;
+
+static bool check_sim_thread() {
+    if (PyThread_get_thread_ident() == sim_thread_ident) {
+        return true;
+    }
+    PyErr_SetString(PyExc_RuntimeError,
+                    "The simulator can only be accessed from the thread "
+                    "running cocotb");
+    return false;
+}
+
+// Callback batching, see set_callback_batching()
+static PyObject *batch_function = NULL;  // Callbacks to this may be batched
+static PyObject *batch_handler = NULL;   // Called with the batched arguments
+static bool in_callback_batch = false;
+static std::vector<PythonCallback *> callback_batch;
+
+// Whether callbacks registered with *function* may be batched
+static bool is_batch_function(PyObject *function) {
+    if (!batch_function) {
+        return false;
+    }
+    if (function == batch_function) {
+        return true;
+    }
+    // Bound methods are created anew on each attribute access
+    return PyMethod_Check(function) && PyMethod_Check(batch_function) &&
+           PyMethod_GET_FUNCTION(function) ==
+               PyMethod_GET_FUNCTION(batch_function) &&
+           PyMethod_GET_SELF(function) == PyMethod_GET_SELF(batch_function);
+}
+
+// Deliver the deferred callbacks with a single call into Python
+static void flush_callback_batch() {
+    std::vector<PythonCallback *> batch;
+    batch.swap(callback_batch);
+
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    DEFER(PyGILState_Release(gstate));
+
+    PyObject *pValue;
+    if (batch.size() == 1) {
+        pValue = batch[0]->call();
+    } else {
+        PyObject *pArgs = PyList_New(static_cast<Py_ssize_t>(batch.size()));
+        if (pArgs == NULL) {
+            pValue = NULL;
+        } else {
+            for (size_t i = 0; i < batch.size(); i++) {
+                PyObject *arg = batch[i]->arg ? batch[i]->arg : Py_None;
+                Py_INCREF(arg);
+                PyList_SET_ITEM(pArgs, static_cast<Py_ssize_t>(i), arg);
+            }
+            pValue = PyObject_CallFunctionObjArgs(batch_handler, pArgs, NULL);
+            Py_DECREF(pArgs);
+        }
+    }
+
+    // See handle_gpi_callback()
+    if (pValue == NULL) {
+        PyErr_Print();
+        gpi_sim_end();
+    } else {
+        Py_DECREF(pValue);
+    }
+
+    for (auto cb_data : batch) {
+        if (cb_data->id_value == COCOTB_INACTIVE_ID) {
+            delete cb_data;
+        }
+    }
+}
+
+static void callback_batch_begin(void *) { in_callback_batch = true; }
+
+static void callback_batch_end(void *) {
+    in_callback_batch = false;
+    if (!callback_batch.empty()) {
+        to_python();
+        DEFER(to_simulator());
+        gpi_profile_begin("python", "python");
+        DEFER(gpi_profile_end());
+        flush_callback_batch();
+    }
+}
+
 /**
  * @name    Callback Handling
  * @brief   Handle a callback coming from GPI
@@ -191,6 +509,8 @@ struct sim_time {
 int handle_gpi_callback(void *user_data) {
     to_python();
     DEFER(to_simulator());
+    gpi_profile_begin("python", "python");
+    DEFER(gpi_profile_end());
 
     PythonCallback *cb_data = (PythonCallback *)user_data;
 
@@ -200,6 +520,15 @@ int handle_gpi_callback(void *user_data) {
     }
     cb_data->id_value = COCOTB_INACTIVE_ID;
 
+    if (cb_data->batchable && in_callback_batch) {
+        callback_batch.push_back(cb_data);
+        return 0;
+    }
+    // Keep the callbacks in the order they fired
+    if (!callback_batch.empty()) {
+        flush_callback_batch();
+    }
+
     PyGILState_STATE gstate = PyGILState_Ensure();
     DEFER(PyGILState_Release(gstate));
 
@@ -211,8 +540,7 @@ int handle_gpi_callback(void *user_data) {
     }
 
     // Call the callback
-    PyObject *pValue =
-        PyObject_Call(cb_data->function, cb_data->args, cb_data->kwargs);
+    PyObject *pValue = cb_data->call();
 
     // If the return value is NULL a Python exception has occurred
     // The best thing to do here is shutdown as any subsequent
@@ -234,18 +562,34 @@ int handle_gpi_callback(void *user_data) {
     return 0;
 }
 
+// Value change callback which only calls into Python once the value of a
+// signal matches, and waits for the next change otherwise
+static int handle_value_match_callback(void *user_data) {
+    PythonCallback *cb_data = (PythonCallback *)user_data;
+
+    if (cb_data->id_value == COCOTB_ACTIVE_ID && !cb_data->match->matches()) {
+        gpi_rearm_value_change_callback(cb_data->match->cb_hdl);
+        return 0;
+    }
+    return handle_gpi_callback(user_data);
+}
+
 // Register a callback for read-only state of sim
 // First argument is the function to call
 // Remaining arguments are keyword arguments to be passed to the callback
-static PyObject *register_readonly_callback(PyObject *, PyObject *args) {
+static PyObject *register_readonly_callback(PyObject *,
+                                            PyObject *const *args,
+                                            Py_ssize_t nargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
     }
 
-    Py_ssize_t numargs = PyTuple_Size(args);
-
-    if (numargs < 1) {
+    if (nargs < 1) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register ReadOnly callback without enough "
                         "arguments!\n");
@@ -253,7 +597,7 @@ static PyObject *register_readonly_callback(PyObject *, PyObject *args) {
     }
 
     // Extract the callback function
-    PyObject *function = PyTuple_GetItem(args, 0);
+    PyObject *function = args[0];
     if (!PyCallable_Check(function)) {
         PyErr_SetString(
             PyExc_TypeError,
@@ -262,14 +606,11 @@ static PyObject *register_readonly_callback(PyObject *, PyObject *args) {
     }
     Py_INCREF(function);
 
-    // Remaining args for function
-    PyObject *fArgs = PyTuple_GetSlice(args, 1, numargs);  // New reference
-    if (fArgs == NULL) {
+    PythonCallback *cb_data = new_python_callback(function, args, nargs, 1);
+    if (cb_data == NULL) {
         return NULL;
     }
 
-    PythonCallback *cb_data = new PythonCallback(function, fArgs, NULL);
-
     gpi_cb_hdl hdl = gpi_register_readonly_callback(
         (gpi_function_t)handle_gpi_callback, cb_data);
 
@@ -278,15 +619,19 @@ static PyObject *register_readonly_callback(PyObject *, PyObject *args) {
     return rv;
 }
 
-static PyObject *register_rwsynch_callback(PyObject *, PyObject *args) {
+static PyObject *register_rwsynch_callback(PyObject *,
+                                           PyObject *const *args,
+                                           Py_ssize_t nargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
     }
 
-    Py_ssize_t numargs = PyTuple_Size(args);
-
-    if (numargs < 1) {
+    if (nargs < 1) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register ReadWrite callback without enough "
                         "arguments!\n");
@@ -294,7 +639,7 @@ static PyObject *register_rwsynch_callback(PyObject *, PyObject *args) {
     }
 
     // Extract the callback function
-    PyObject *function = PyTuple_GetItem(args, 0);
+    PyObject *function = args[0];
     if (!PyCallable_Check(function)) {
         PyErr_SetString(
             PyExc_TypeError,
@@ -303,14 +648,11 @@ static PyObject *register_rwsynch_callback(PyObject *, PyObject *args) {
     }
     Py_INCREF(function);
 
-    // Remaining args for function
-    PyObject *fArgs = PyTuple_GetSlice(args, 1, numargs);  // New reference
-    if (fArgs == NULL) {
+    PythonCallback *cb_data = new_python_callback(function, args, nargs, 1);
+    if (cb_data == NULL) {
         return NULL;
     }
 
-    PythonCallback *cb_data = new PythonCallback(function, fArgs, NULL);
-
     gpi_cb_hdl hdl = gpi_register_readwrite_callback(
         (gpi_function_t)handle_gpi_callback, cb_data);
 
@@ -319,15 +661,19 @@ static PyObject *register_rwsynch_callback(PyObject *, PyObject *args) {
     return rv;
 }
 
-static PyObject *register_nextstep_callback(PyObject *, PyObject *args) {
+static PyObject *register_nextstep_callback(PyObject *,
+                                            PyObject *const *args,
+                                            Py_ssize_t nargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
     }
 
-    Py_ssize_t numargs = PyTuple_Size(args);
-
-    if (numargs < 1) {
+    if (nargs < 1) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register NextStep callback without enough "
                         "arguments!\n");
@@ -335,7 +681,7 @@ static PyObject *register_nextstep_callback(PyObject *, PyObject *args) {
     }
 
     // Extract the callback function
-    PyObject *function = PyTuple_GetItem(args, 0);
+    PyObject *function = args[0];
     if (!PyCallable_Check(function)) {
         PyErr_SetString(
             PyExc_TypeError,
@@ -344,14 +690,11 @@ static PyObject *register_nextstep_callback(PyObject *, PyObject *args) {
     }
     Py_INCREF(function);
 
-    // Remaining args for function
-    PyObject *fArgs = PyTuple_GetSlice(args, 1, numargs);  // New reference
-    if (fArgs == NULL) {
+    PythonCallback *cb_data = new_python_callback(function, args, nargs, 1);
+    if (cb_data == NULL) {
         return NULL;
     }
 
-    PythonCallback *cb_data = new PythonCallback(function, fArgs, NULL);
-
     gpi_cb_hdl hdl = gpi_register_nexttime_callback(
         (gpi_function_t)handle_gpi_callback, cb_data);
 
@@ -364,15 +707,19 @@ static PyObject *register_nextstep_callback(PyObject *, PyObject *args) {
 // First argument should be the time in picoseconds
 // Second argument is the function to call
 // Remaining arguments and keyword arguments are to be passed to the callback
-static PyObject *register_timed_callback(PyObject *, PyObject *args) {
+static PyObject *register_timed_callback(PyObject *,
+                                         PyObject *const *args,
+                                         Py_ssize_t nargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
     }
 
-    Py_ssize_t numargs = PyTuple_Size(args);
-
-    if (numargs < 2) {
+    if (nargs < 2) {
         PyErr_SetString(
             PyExc_TypeError,
             "Attempt to register timed callback without enough arguments!\n");
@@ -381,7 +728,7 @@ static PyObject *register_timed_callback(PyObject *, PyObject *args) {
 
     uint64_t time;
     {  // Extract the time
-        PyObject *pTime = PyTuple_GetItem(args, 0);
+        PyObject *pTime = args[0];
         long long pTime_as_longlong = PyLong_AsLongLong(pTime);
         if (pTime_as_longlong == -1 && PyErr_Occurred()) {
             return NULL;
@@ -395,7 +742,7 @@ static PyObject *register_timed_callback(PyObject *, PyObject *args) {
     }
 
     // Extract the callback function
-    PyObject *function = PyTuple_GetItem(args, 1);
+    PyObject *function = args[1];
     if (!PyCallable_Check(function)) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register timed callback without passing a "
@@ -404,14 +751,11 @@ static PyObject *register_timed_callback(PyObject *, PyObject *args) {
     }
     Py_INCREF(function);
 
-    // Remaining args for function
-    PyObject *fArgs = PyTuple_GetSlice(args, 2, numargs);  // New reference
-    if (fArgs == NULL) {
+    PythonCallback *cb_data = new_python_callback(function, args, nargs, 2);
+    if (cb_data == NULL) {
         return NULL;
     }
 
-    PythonCallback *cb_data = new PythonCallback(function, fArgs, NULL);
-
     gpi_cb_hdl hdl = gpi_register_timed_callback(
         (gpi_function_t)handle_gpi_callback, cb_data, time);
 
@@ -425,24 +769,26 @@ static PyObject *register_timed_callback(PyObject *, PyObject *args) {
 // First argument should be the signal handle
 // Second argument is the function to call
 // Remaining arguments and keyword arguments are to be passed to the callback
-static PyObject *register_value_change_callback(
-    PyObject *, PyObject *args)  //, PyObject *keywds)
-{
+static PyObject *register_value_change_callback(PyObject *,
+                                                PyObject *const *args,
+                                                Py_ssize_t nargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
     }
 
-    Py_ssize_t numargs = PyTuple_Size(args);
-
-    if (numargs < 3) {
+    if (nargs < 3) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register value change callback without "
                         "enough arguments!\n");
         return NULL;
     }
 
-    PyObject *pSigHdl = PyTuple_GetItem(args, 0);
+    PyObject *pSigHdl = args[0];
     if (Py_TYPE(pSigHdl) != &gpi_hdl_Object<gpi_sim_hdl>::py_type) {
         PyErr_SetString(PyExc_TypeError,
                         "First argument must be a gpi_sim_hdl");
@@ -451,7 +797,7 @@ static PyObject *register_value_change_callback(
     gpi_sim_hdl sig_hdl = ((gpi_hdl_Object<gpi_sim_hdl> *)pSigHdl)->hdl;
 
     // Extract the callback function
-    PyObject *function = PyTuple_GetItem(args, 1);
+    PyObject *function = args[1];
     if (!PyCallable_Check(function)) {
         PyErr_SetString(PyExc_TypeError,
                         "Attempt to register value change callback without "
@@ -460,16 +806,14 @@ static PyObject *register_value_change_callback(
     }
     Py_INCREF(function);
 
-    PyObject *pedge = PyTuple_GetItem(args, 2);
+    PyObject *pedge = args[2];
     gpi_edge_e edge = (gpi_edge_e)PyLong_AsLong(pedge);
 
-    // Remaining args for function
-    PyObject *fArgs = PyTuple_GetSlice(args, 3, numargs);  // New reference
-    if (fArgs == NULL) {
+    PythonCallback *cb_data = new_python_callback(function, args, nargs, 3);
+    if (cb_data == NULL) {
         return NULL;
     }
-
-    PythonCallback *cb_data = new PythonCallback(function, fArgs, NULL);
+    cb_data->batchable = !cb_data->args && is_batch_function(function);
 
     gpi_cb_hdl hdl = gpi_register_value_change_callback(
         (gpi_function_t)handle_gpi_callback, cb_data, sig_hdl, edge);
@@ -480,7 +824,172 @@ static PyObject *register_value_change_callback(
     return rv;
 }
 
+// Reads the little-endian bytes of `obj` into `words`, returning -1 and
+// raising ValueError if it doesn't hold `n_bytes` bytes
+static int read_match_words(PyObject *obj, size_t n_bytes, const char *name,
+                            std::vector<uint32_t> &words) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_SIMPLE) < 0) {
+        return -1;
+    }
+    if (static_cast<size_t>(view.len) != n_bytes) {
+        PyErr_Format(PyExc_ValueError, "%s must be %zu bytes, got %zd", name,
+                     n_bytes, view.len);
+        PyBuffer_Release(&view);
+        return -1;
+    }
+    words.assign((n_bytes + 3) / 4, 0);
+    auto bytes = static_cast<const unsigned char *>(view.buf);
+    for (size_t i = 0; i < n_bytes; i++) {
+        words[i / 4] |= static_cast<uint32_t>(bytes[i]) << (8 * (i % 4));
+    }
+    PyBuffer_Release(&view);
+    return 0;
+}
+
+static PyObject *register_value_match_callback(PyObject *,
+                                               PyObject *const *args,
+                                               Py_ssize_t nargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    if (!gpi_has_registered_impl()) {
+        PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
+        return NULL;
+    }
+
+    if (nargs < 7) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Attempt to register value match callback without "
+                        "enough arguments!\n");
+        return NULL;
+    }
+
+    PyObject *pSigHdl, *pEdgeHdl, *pValue, *pMask, *function;
+    int edge, negate;
+    PyObject *fixed = PyTuple_New(7);
+    if (fixed == NULL) {
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < 7; i++) {
+        Py_INCREF(args[i]);
+        PyTuple_SET_ITEM(fixed, i, args[i]);
+    }
+    int ok = PyArg_ParseTuple(fixed, "O!OiOOpO:register_value_match_callback",
+                              &gpi_hdl_Object<gpi_sim_hdl>::py_type, &pSigHdl,
+                              &pEdgeHdl, &edge, &pValue, &pMask, &negate,
+                              &function);
+    Py_DECREF(fixed);
+    if (!ok) {
+        return NULL;
+    }
+    gpi_sim_hdl sig_hdl = ((gpi_hdl_Object<gpi_sim_hdl> *)pSigHdl)->hdl;
+
+    // The value is checked on changes of the signal itself by default
+    gpi_sim_hdl edge_hdl = sig_hdl;
+    if (pEdgeHdl != Py_None) {
+        if (Py_TYPE(pEdgeHdl) != &gpi_hdl_Object<gpi_sim_hdl>::py_type) {
+            PyErr_SetString(PyExc_TypeError,
+                            "Second argument must be a gpi_sim_hdl or None");
+            return NULL;
+        }
+        edge_hdl = ((gpi_hdl_Object<gpi_sim_hdl> *)pEdgeHdl)->hdl;
+    } else {
+        edge = GPI_VALUE_CHANGE;
+    }
+
+    if (!PyCallable_Check(function)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Attempt to register value match callback without "
+                        "passing a callable callback!\n");
+        return NULL;
+    }
+
+    int width = gpi_get_signal_value_bytes(sig_hdl, NULL, 0);
+    if (width <= 0) {
+        PyErr_Format(PyExc_TypeError, "%s has no packed value to match",
+                     gpi_get_signal_name_str(sig_hdl));
+        return NULL;
+    }
+
+    auto match = new ValueMatch();
+    match->signal = sig_hdl;
+    match->width = width;
+    match->negate = negate;
+    match->words.resize(static_cast<size_t>((width + 31) / 32));
+    size_t n_bytes = static_cast<size_t>((width + 7) / 8);
+    if (read_match_words(pValue, n_bytes, "value", match->value) < 0 ||
+        read_match_words(pMask, n_bytes, "mask", match->mask) < 0) {
+        delete match;
+        return NULL;
+    }
+    for (size_t i = 0; i < match->value.size(); i++) {
+        match->value[i] &= match->mask[i];
+    }
+
+    Py_INCREF(function);
+    PythonCallback *cb_data = new_python_callback(function, args, nargs, 7);
+    if (cb_data == NULL) {
+        delete match;
+        return NULL;
+    }
+    cb_data->batchable = !cb_data->args && is_batch_function(function);
+    cb_data->match = match;
+
+    gpi_cb_hdl hdl = gpi_register_value_change_callback(
+        handle_value_match_callback, cb_data, edge_hdl,
+        static_cast<gpi_edge_e>(edge));
+    if (!hdl) {
+        delete cb_data;
+        Py_RETURN_NONE;
+    }
+    match->cb_hdl = hdl;
+
+    return gpi_hdl_New(hdl);
+}
+
+static PyObject *set_callback_batching(PyObject *, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    PyObject *function;
+    PyObject *handler;
+
+    if (!PyArg_ParseTuple(args, "OO:set_callback_batching", &function,
+                          &handler)) {
+        return NULL;
+    }
+
+    if (function == Py_None || handler == Py_None) {
+        Py_CLEAR(batch_function);
+        Py_CLEAR(batch_handler);
+        gpi_set_callback_batch_handlers(NULL, NULL, NULL);
+        Py_RETURN_NONE;
+    }
+
+    if (!PyCallable_Check(function) || !PyCallable_Check(handler)) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Callback batching requires callable arguments");
+        return NULL;
+    }
+
+    Py_INCREF(function);
+    Py_INCREF(handler);
+    Py_XSETREF(batch_function, function);
+    Py_XSETREF(batch_handler, handler);
+    gpi_set_callback_batch_handlers(callback_batch_begin, callback_batch_end,
+                                    NULL);
+
+    Py_RETURN_NONE;
+}
+
 static PyObject *iterate(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     int type;
 
     if (!PyArg_ParseTuple(args, "i:iterate", &type)) {
@@ -493,12 +1002,20 @@ static PyObject *iterate(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *args) {
 }
 
 static PyObject *package_iterate(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     gpi_iterator_hdl result = gpi_iterate(NULL, GPI_PACKAGE_SCOPES);
 
     return gpi_hdl_New(result);
 }
 
 static PyObject *next(gpi_hdl_Object<gpi_iterator_hdl> *self) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     gpi_sim_hdl result = gpi_next(self->hdl);
 
     // Raise StopIteration when we're done
@@ -510,11 +1027,55 @@ static PyObject *next(gpi_hdl_Object<gpi_iterator_hdl> *self) {
     return gpi_hdl_New(result);
 }
 
+static PyObject *next_names(gpi_hdl_Object<gpi_iterator_hdl> *self,
+                            PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    Py_ssize_t count;
+
+    if (!PyArg_ParseTuple(args, "n:next_names", &count)) {
+        return NULL;
+    }
+    if (count < 1) {
+        PyErr_SetString(PyExc_ValueError, "Count must be positive");
+        return NULL;
+    }
+
+    PyObject *names = PyList_New(0);
+    if (names == NULL) {
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        gpi_objtype_t type;
+        const char *name = gpi_next_name(self->hdl, &type);
+        if (name == NULL) {
+            break;
+        }
+
+        PyObject *entry = Py_BuildValue("(si)", name, (int)type);
+        if (entry == NULL || PyList_Append(names, entry) < 0) {
+            Py_XDECREF(entry);
+            Py_DECREF(names);
+            return NULL;
+        }
+        Py_DECREF(entry);
+    }
+
+    return names;
+}
+
 // Raise an exception on failure
 // Return None if for example get bin_string on enum?
 
 static PyObject *get_signal_val_binstr(gpi_hdl_Object<gpi_sim_hdl> *self,
                                        PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     const char *result = gpi_get_signal_value_binstr(self->hdl);
     if (result == NULL) {
         // LCOV_EXCL_START
@@ -526,11 +1087,274 @@ static PyObject *get_signal_val_binstr(gpi_hdl_Object<gpi_sim_hdl> *self,
     return PyUnicode_FromString(result);
 }
 
-static PyObject *get_signal_val_str(gpi_hdl_Object<gpi_sim_hdl> *self,
-                                    PyObject *) {
-    const char *result = gpi_get_signal_value_str(self->hdl);
-    if (result == NULL) {
-        // LCOV_EXCL_START
+// Scratch buffer of packed words, reused between calls to avoid allocating
+static std::vector<gpi_vecval_t> vector_scratch;
+
+static gpi_vecval_t *get_vector_scratch(size_t n_words) {
+    if (vector_scratch.size() < n_words) {
+        vector_scratch.resize(n_words);
+    }
+    return vector_scratch.data();
+}
+
+// Reads the packed value of a signal into the scratch buffer, sized for the
+// width of the signal, so it is read once unless it turns out to be wider.
+// Returns the number of bits, or -1 if the value is not representable as
+// packed 4-state words.
+static int read_signal_vector(gpi_sim_hdl hdl, int width,
+                              gpi_vecval_t **words) {
+    int n_words = width > 0 ? (width + 31) / 32 : 1;
+    gpi_vecval_t *scratch = get_vector_scratch(static_cast<size_t>(n_words));
+    int n_bits = gpi_get_signal_value_bytes(hdl, scratch, n_words);
+    if (n_bits > 32 * n_words) {
+        n_words = (n_bits + 31) / 32;
+        scratch = get_vector_scratch(static_cast<size_t>(n_words));
+        n_bits = gpi_get_signal_value_bytes(hdl, scratch, n_words);
+    }
+    *words = scratch;
+    return n_bits;
+}
+
+// Writes the aval bytes followed by the bval bytes of a packed value,
+// each in little-endian order.
+static void unpack_signal_vector(const gpi_vecval_t *words, int n_bits,
+                                 unsigned char *out) {
+    size_t n_bytes = static_cast<size_t>((n_bits + 7) / 8);
+    for (size_t i = 0; i < n_bytes; i++) {
+        unsigned shift = static_cast<unsigned>((i % 4) * 8);
+        out[i] = static_cast<unsigned char>(words[i / 4].aval >> shift);
+        out[n_bytes + i] =
+            static_cast<unsigned char>(words[i / 4].bval >> shift);
+    }
+}
+
+// Reads the aval bytes followed by the bval bytes of a packed value, as
+// written by unpack_signal_vector()
+static void pack_signal_vector(const unsigned char *in, int n_bits,
+                               gpi_vecval_t *words) {
+    size_t n_bytes = static_cast<size_t>((n_bits + 7) / 8);
+    memset(words, 0, static_cast<size_t>((n_bits + 31) / 32) * sizeof(*words));
+    for (size_t i = 0; i < n_bytes; i++) {
+        unsigned shift = static_cast<unsigned>((i % 4) * 8);
+        words[i / 4].aval |= static_cast<uint32_t>(in[i]) << shift;
+        words[i / 4].bval |= static_cast<uint32_t>(in[n_bytes + i]) << shift;
+    }
+}
+
+// Bytes of wide ints, reused between calls to avoid allocating
+static std::vector<unsigned char> int_scratch;
+
+// Packs the low n_bits of a non-negative int as 4-state words with no X or Z
+// bits, without building any temporary Python object.
+// Returns false with an exception set on failure.
+static bool pack_signal_int(PyObject *value, int n_bits, gpi_vecval_t *words) {
+    size_t n_words = static_cast<size_t>((n_bits + 31) / 32);
+    memset(words, 0, n_words * sizeof(*words));
+    if (n_bits <= 64) {
+        unsigned long long bits = PyLong_AsUnsignedLongLongMask(value);
+        if (bits == static_cast<unsigned long long>(-1) && PyErr_Occurred()) {
+            return false;
+        }
+        for (size_t i = 0; i < n_words; i++) {
+            words[i].aval = static_cast<uint32_t>(bits >> (32 * i));
+        }
+        return true;
+    }
+
+    size_t n_bytes = static_cast<size_t>((n_bits + 7) / 8);
+    if (int_scratch.size() < n_bytes) {
+        int_scratch.resize(n_bytes);
+    }
+#if PY_VERSION_HEX >= 0x030D0000
+    if (PyLong_AsNativeBytes(value, int_scratch.data(),
+                             static_cast<Py_ssize_t>(n_bytes),
+                             Py_ASNATIVEBYTES_LITTLE_ENDIAN |
+                                 Py_ASNATIVEBYTES_UNSIGNED_BUFFER) < 0) {
+        return false;
+    }
+#else
+    if (_PyLong_AsByteArray(reinterpret_cast<PyLongObject *>(value),
+                            int_scratch.data(), n_bytes, 1, 0) < 0) {
+        return false;
+    }
+#endif
+    for (size_t i = 0; i < n_bytes; i++) {
+        unsigned shift = static_cast<unsigned>((i % 4) * 8);
+        words[i / 4].aval |= static_cast<uint32_t>(int_scratch[i]) << shift;
+    }
+    return true;
+}
+
+static PyObject *get_signal_val_bytes(gpi_hdl_Object<gpi_sim_hdl> *self,
+                                      PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_vecval_t *words;
+    int n_bits =
+        read_signal_vector(self->hdl, gpi_get_num_elems(self->hdl), &words);
+    if (n_bits < 0) {
+        Py_RETURN_NONE;
+    }
+
+    Py_ssize_t n_bytes = (n_bits + 7) / 8;
+    PyObject *result = PyBytes_FromStringAndSize(NULL, 2 * n_bytes);
+    if (result == NULL) {
+        return NULL;
+    }
+    unpack_signal_vector(
+        words, n_bits,
+        reinterpret_cast<unsigned char *>(PyBytes_AS_STRING(result)));
+    return result;
+}
+
+static PyObject *get_signal_val_bytes_into(gpi_hdl_Object<gpi_sim_hdl> *self,
+                                           PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    Py_buffer view;
+
+    if (!PyArg_ParseTuple(args, "w*:get_signal_val_bytes_into", &view)) {
+        return NULL;
+    }
+
+    gpi_vecval_t *words;
+    int n_bits =
+        read_signal_vector(self->hdl, gpi_get_num_elems(self->hdl), &words);
+    if (n_bits >= 0) {
+        Py_ssize_t n_bytes = (n_bits + 7) / 8;
+        if (view.len < 2 * n_bytes) {
+            PyErr_Format(PyExc_ValueError,
+                         "Buffer of %zd bytes is too small, %zd are needed",
+                         view.len, 2 * n_bytes);
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        unpack_signal_vector(words, n_bits,
+                             static_cast<unsigned char *>(view.buf));
+    }
+
+    PyBuffer_Release(&view);
+    return PyLong_FromLong(n_bits);
+}
+
+static PyObject *get_array_val_bytes_into(gpi_hdl_Object<gpi_sim_hdl> *self,
+                                          PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    int first, count;
+    Py_buffer view;
+
+    if (!PyArg_ParseTuple(args, "iiw*:get_array_val_bytes_into", &first,
+                          &count, &view)) {
+        return NULL;
+    }
+
+    int n_bits = gpi_get_array_values(self->hdl, first, count, NULL, 0);
+    if (n_bits >= 0) {
+        Py_ssize_t elem_bytes = 2 * ((n_bits + 7) / 8);
+        if (view.len < elem_bytes * count) {
+            PyErr_Format(PyExc_ValueError,
+                         "Buffer of %zd bytes is too small, %zd are needed",
+                         view.len, elem_bytes * count);
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+
+        size_t elem_words = static_cast<size_t>((n_bits + 31) / 32);
+        gpi_vecval_t *words =
+            get_vector_scratch(elem_words * static_cast<size_t>(count));
+        n_bits = gpi_get_array_values(self->hdl, first, count, words,
+                                      static_cast<int>(vector_scratch.size()));
+        if (n_bits >= 0) {
+            auto out = static_cast<unsigned char *>(view.buf);
+            for (int i = 0; i < count; i++) {
+                unpack_signal_vector(words, n_bits, out);
+                words += elem_words;
+                out += elem_bytes;
+            }
+        }
+    }
+
+    PyBuffer_Release(&view);
+    return PyLong_FromLong(n_bits);
+}
+
+static PyObject *load_array_from_file(gpi_hdl_Object<gpi_sim_hdl> *self,
+                                      PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_set_action_t action;
+    PyObject *path;
+    unsigned long long offset;
+    int first, count;
+
+    if (!PyArg_ParseTuple(args, "iO&Kii:load_array_from_file", &action,
+                          PyUnicode_FSConverter, &path, &offset, &first,
+                          &count)) {
+        return NULL;
+    }
+
+    int ret = gpi_load_array_from_file(self->hdl, PyBytes_AS_STRING(path),
+                                       offset, first, count, action);
+    if (ret) {
+        PyErr_Format(PyExc_RuntimeError,
+                     "Failed to load %d elements of %s from %s", count,
+                     gpi_get_signal_name_str(self->hdl),
+                     PyBytes_AS_STRING(path));
+    }
+    Py_DECREF(path);
+    if (ret) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *dump_array_to_file(gpi_hdl_Object<gpi_sim_hdl> *self,
+                                    PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    PyObject *path;
+    int first, count;
+
+    if (!PyArg_ParseTuple(args, "O&ii:dump_array_to_file",
+                          PyUnicode_FSConverter, &path, &first, &count)) {
+        return NULL;
+    }
+
+    int ret = gpi_dump_array_to_file(self->hdl, PyBytes_AS_STRING(path),
+                                     first, count);
+    if (ret) {
+        PyErr_Format(PyExc_RuntimeError,
+                     "Failed to dump %d elements of %s to %s", count,
+                     gpi_get_signal_name_str(self->hdl),
+                     PyBytes_AS_STRING(path));
+    }
+    Py_DECREF(path);
+    if (ret) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *get_signal_val_str(gpi_hdl_Object<gpi_sim_hdl> *self,
+                                    PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    const char *result = gpi_get_signal_value_str(self->hdl);
+    if (result == NULL) {
+        // LCOV_EXCL_START
         PyErr_SetString(PyExc_RuntimeError,
                         "Simulator yielded a null pointer instead of string");
         return NULL;
@@ -541,82 +1365,451 @@ static PyObject *get_signal_val_str(gpi_hdl_Object<gpi_sim_hdl> *self,
 
 static PyObject *get_signal_val_real(gpi_hdl_Object<gpi_sim_hdl> *self,
                                      PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     double result = gpi_get_signal_value_real(self->hdl);
     return PyFloat_FromDouble(result);
 }
 
 static PyObject *get_signal_val_long(gpi_hdl_Object<gpi_sim_hdl> *self,
                                      PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     long result = gpi_get_signal_value_long(self->hdl);
     return PyLong_FromLong(result);
 }
 
+// The ways a value accessor can read the value of its handle
+enum gpi_access_format_e {
+    ACCESS_INT,     // Python int of a packed value, None if not all 0 or 1
+    ACCESS_BINSTR,  // As get_signal_val_binstr()
+    ACCESS_LONG,    // As get_signal_val_long()
+    ACCESS_REAL,    // As get_signal_val_real()
+    ACCESS_STR,     // As get_signal_val_str()
+    ACCESS_LOGIC,   // As ACCESS_INT, or the binstr if not all 0 or 1
+};
+
+/* A reader of the value of a handle in a fixed format, so that reading a
+ * value is a single call which doesn't have to look up a method or choose
+ * a format again.
+ */
+struct GpiValueAccessor {
+    gpi_sim_hdl hdl;
+    gpi_access_format_e format;
+    int width;  // Number of elements of the handle, to size packed reads
+};
+
+// Clears the bits of packed words above n_bits, returning whether any of the
+// others are X or Z
+static bool mask_packed_words(gpi_vecval_t *words, int n_bits) {
+    int n_words = (n_bits + 31) / 32;
+    if (n_bits % 32) {
+        uint32_t mask = (1u << (n_bits % 32)) - 1;
+        words[n_words - 1].aval &= mask;
+        words[n_words - 1].bval &= mask;
+    }
+    for (int i = 0; i < n_words; i++) {
+        if (words[i].bval) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Converts masked packed words with no X or Z bits to a Python int
+static PyObject *packed_words_to_int(const gpi_vecval_t *words, int n_bits) {
+    int n_words = (n_bits + 31) / 32;
+    if (n_words <= 2) {
+        unsigned long long value = words[0].aval;
+        if (n_words == 2) {
+            value |= static_cast<unsigned long long>(words[1].aval) << 32;
+        }
+        return PyLong_FromUnsignedLongLong(value);
+    }
+
+    // Wider values are built from their hexadecimal digits
+    std::vector<char> hex(static_cast<size_t>(8 * n_words + 1));
+    for (int i = 0; i < n_words; i++) {
+        snprintf(&hex[static_cast<size_t>(8 * i)], 9, "%08x",
+                 words[n_words - 1 - i].aval);
+    }
+    return PyLong_FromString(hex.data(), NULL, 16);
+}
+
+// Converts packed words to the binstr of their value, as read by
+// gpi_get_signal_value_binstr()
+static PyObject *packed_words_to_binstr(const gpi_vecval_t *words,
+                                        int n_bits) {
+    static const char logic_chars[] = "01ZX";
+    PyObject *result = PyUnicode_New(n_bits, 127);
+    if (result == NULL) {
+        return NULL;
+    }
+    // The string starts with the left-most bit
+    auto chars = static_cast<char *>(PyUnicode_DATA(result));
+    for (int i = 0; i < n_bits; i++) {
+        int bit = n_bits - 1 - i;
+        uint32_t a = (words[bit / 32].aval >> (bit % 32)) & 1;
+        uint32_t b = (words[bit / 32].bval >> (bit % 32)) & 1;
+        chars[i] = logic_chars[(b << 1) | a];
+    }
+    return result;
+}
+
+// Converts a value with no X or Z bits to a Python int, or returns None
+static PyObject *packed_value_to_int(gpi_sim_hdl hdl, int width) {
+    gpi_vecval_t *words;
+    int n_bits = read_signal_vector(hdl, width, &words);
+    if (n_bits <= 0 || mask_packed_words(words, n_bits)) {
+        Py_RETURN_NONE;
+    }
+    return packed_words_to_int(words, n_bits);
+}
+
+static PyObject *signal_value_binstr(gpi_sim_hdl hdl) {
+    const char *result = gpi_get_signal_value_binstr(hdl);
+    if (result == NULL) {
+        // LCOV_EXCL_START
+        PyErr_SetString(PyExc_RuntimeError,
+                        "Simulator yielded a null pointer instead of binstr");
+        return NULL;
+        // LCOV_EXCL_STOP
+    }
+    return PyUnicode_FromString(result);
+}
+
+// Converts a value to a Python int if it has no X or Z bits, or else to its
+// binstr. The value is only read again as a binstr if it can't be packed.
+static PyObject *packed_value_to_logic(gpi_sim_hdl hdl, int width) {
+    gpi_vecval_t *words;
+    int n_bits = read_signal_vector(hdl, width, &words);
+    if (n_bits <= 0) {
+        return signal_value_binstr(hdl);
+    }
+    if (mask_packed_words(words, n_bits)) {
+        return packed_words_to_binstr(words, n_bits);
+    }
+    return packed_words_to_int(words, n_bits);
+}
+
+static PyObject *accessor_call(gpi_hdl_Object<gpi_accessor_hdl> *self,
+                               PyObject *args, PyObject *kwargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    if (PyTuple_GET_SIZE(args) || (kwargs && PyDict_Size(kwargs))) {
+        PyErr_SetString(PyExc_TypeError, "accessors take no arguments");
+        return NULL;
+    }
+
+    gpi_sim_hdl hdl = self->hdl->hdl;
+    switch (self->hdl->format) {
+        case ACCESS_INT:
+            return packed_value_to_int(hdl, self->hdl->width);
+        case ACCESS_LOGIC:
+            return packed_value_to_logic(hdl, self->hdl->width);
+        case ACCESS_BINSTR:
+            return signal_value_binstr(hdl);
+        case ACCESS_LONG:
+            return PyLong_FromLong(gpi_get_signal_value_long(hdl));
+        case ACCESS_REAL:
+            return PyFloat_FromDouble(gpi_get_signal_value_real(hdl));
+        case ACCESS_STR: {
+            const char *result = gpi_get_signal_value_str(hdl);
+            if (result == NULL) {
+                // LCOV_EXCL_START
+                PyErr_SetString(
+                    PyExc_RuntimeError,
+                    "Simulator yielded a null pointer instead of string");
+                return NULL;
+                // LCOV_EXCL_STOP
+            }
+            return PyBytes_FromString(result);
+        }
+    }
+    // LCOV_EXCL_START
+    PyErr_SetString(PyExc_RuntimeError, "Invalid accessor format");
+    return NULL;
+    // LCOV_EXCL_STOP
+}
+
+static void accessor_dealloc(PyObject *self) {
+    delete ((gpi_hdl_Object<gpi_accessor_hdl> *)self)->hdl;
+
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *get_accessor(gpi_hdl_Object<gpi_sim_hdl> *self,
+                              PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    int format;
+
+    if (!PyArg_ParseTuple(args, "i:get_accessor", &format)) {
+        return NULL;
+    }
+    if (format < ACCESS_INT || format > ACCESS_LOGIC) {
+        PyErr_Format(PyExc_ValueError, "Invalid accessor format %d", format);
+        return NULL;
+    }
+
+    auto access_format = static_cast<gpi_access_format_e>(format);
+    return gpi_hdl_New(new GpiValueAccessor{self->hdl, access_format,
+                                            gpi_get_num_elems(self->hdl)});
+}
+
+// The set_signal_val_* methods write the value at once. Instantiated as the
+// queue_signal_val_* methods, they queue the write in the GPI instead, to
+// be applied by apply_queued_writes().
+template <bool queued>
 static PyObject *set_signal_val_binstr(gpi_hdl_Object<gpi_sim_hdl> *self,
-                                       PyObject *args) {
+                                       PyObject *const *args,
+                                       Py_ssize_t nargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     const char *binstr;
     gpi_set_action_t action;
 
-    if (!PyArg_ParseTuple(args, "is:set_signal_val_binstr", &action, &binstr)) {
+    if (!check_nargs(queued ? "queue_signal_val_binstr"
+                            : "set_signal_val_binstr",
+                     nargs, 2) ||
+        !parse_action_arg(args[0], &action) ||
+        !(binstr = parse_string_arg(args[1], false))) {
+        return NULL;
+    }
+
+    (queued ? gpi_queue_signal_value_binstr : gpi_set_signal_value_binstr)(
+        self->hdl, binstr, action);
+    Py_RETURN_NONE;
+}
+
+template <bool queued>
+static PyObject *set_signal_val_bytes(gpi_hdl_Object<gpi_sim_hdl> *self,
+                                      PyObject *const *args,
+                                      Py_ssize_t nargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_set_action_t action;
+    int n_bits;
+    Py_buffer view;
+
+    if (!check_nargs(queued ? "queue_signal_val_bytes"
+                            : "set_signal_val_bytes",
+                     nargs, 3) ||
+        !parse_action_arg(args[0], &action) ||
+        !parse_int_arg(args[1], &n_bits)) {
+        return NULL;
+    }
+    if (n_bits < 0) {
+        PyErr_Format(PyExc_ValueError, "Width must be non-negative, got %d",
+                     n_bits);
+        return NULL;
+    }
+
+    gpi_vecval_t *words;
+    if (PyLong_Check(args[2])) {
+        words = get_vector_scratch(static_cast<size_t>((n_bits + 31) / 32));
+        if (!pack_signal_int(args[2], n_bits, words)) {
+            return NULL;
+        }
+        (queued ? gpi_queue_signal_value_vector : gpi_set_signal_value_vector)(
+            self->hdl, words, n_bits, action);
+        Py_RETURN_NONE;
+    }
+
+    if (PyObject_GetBuffer(args[2], &view, PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+    Py_ssize_t n_bytes = (n_bits + 7) / 8;
+    if (view.len != 2 * n_bytes) {
+        PyErr_Format(PyExc_ValueError,
+                     "Expected %zd bytes for a value of %d bits, got %zd",
+                     2 * n_bytes, n_bits, view.len);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    words = get_vector_scratch(static_cast<size_t>((n_bits + 31) / 32));
+    pack_signal_vector(static_cast<const unsigned char *>(view.buf), n_bits,
+                       words);
+    PyBuffer_Release(&view);
+
+    (queued ? gpi_queue_signal_value_vector : gpi_set_signal_value_vector)(
+        self->hdl, words, n_bits, action);
+    Py_RETURN_NONE;
+}
+
+static PyObject *set_array_val_bytes(gpi_hdl_Object<gpi_sim_hdl> *self,
+                                     PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_set_action_t action;
+    int first, count;
+    Py_buffer view;
+
+    if (!PyArg_ParseTuple(args, "iiiy*:set_array_val_bytes", &action, &first,
+                          &count, &view)) {
+        return NULL;
+    }
+
+    int n_bits = gpi_get_array_values(self->hdl, first, count, NULL, 0);
+    if (n_bits < 0) {
+        PyErr_Format(PyExc_ValueError,
+                     "Unable to write %d elements of %s from index %d", count,
+                     gpi_get_signal_name_str(self->hdl), first);
+        PyBuffer_Release(&view);
         return NULL;
     }
 
-    gpi_set_signal_value_binstr(self->hdl, binstr, action);
+    Py_ssize_t elem_bytes = 2 * ((n_bits + 7) / 8);
+    if (view.len != elem_bytes * count) {
+        PyErr_Format(PyExc_ValueError,
+                     "Expected %zd bytes for %d elements of %d bits, got %zd",
+                     elem_bytes * count, count, n_bits, view.len);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    size_t elem_words = static_cast<size_t>((n_bits + 31) / 32);
+    gpi_vecval_t *words =
+        get_vector_scratch(elem_words * static_cast<size_t>(count));
+    auto in = static_cast<const unsigned char *>(view.buf);
+    for (int i = 0; i < count; i++) {
+        pack_signal_vector(in, n_bits,
+                           words + elem_words * static_cast<size_t>(i));
+        in += elem_bytes;
+    }
+    PyBuffer_Release(&view);
+
+    if (gpi_set_array_values(self->hdl, first, count, words, n_bits, action)) {
+        PyErr_Format(PyExc_RuntimeError,
+                     "Failed to write %d elements of %s from index %d", count,
+                     gpi_get_signal_name_str(self->hdl), first);
+        return NULL;
+    }
     Py_RETURN_NONE;
 }
 
+template <bool queued>
 static PyObject *set_signal_val_str(gpi_hdl_Object<gpi_sim_hdl> *self,
-                                    PyObject *args) {
+                                    PyObject *const *args, Py_ssize_t nargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     gpi_set_action_t action;
     const char *str;
 
-    if (!PyArg_ParseTuple(args, "iy:set_signal_val_str", &action, &str)) {
+    if (!check_nargs(queued ? "queue_signal_val_str"
+                            : "set_signal_val_str",
+                     nargs, 2) ||
+        !parse_action_arg(args[0], &action) ||
+        !(str = parse_string_arg(args[1], true))) {
         return NULL;
     }
 
-    gpi_set_signal_value_str(self->hdl, str, action);
+    (queued ? gpi_queue_signal_value_str : gpi_set_signal_value_str)(
+        self->hdl, str, action);
     Py_RETURN_NONE;
 }
 
+template <bool queued>
 static PyObject *set_signal_val_real(gpi_hdl_Object<gpi_sim_hdl> *self,
-                                     PyObject *args) {
+                                     PyObject *const *args,
+                                     Py_ssize_t nargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     double value;
     gpi_set_action_t action;
 
-    if (!PyArg_ParseTuple(args, "id:set_signal_val_real", &action, &value)) {
+    if (!check_nargs(queued ? "queue_signal_val_real"
+                            : "set_signal_val_real",
+                     nargs, 2) ||
+        !parse_action_arg(args[0], &action)) {
+        return NULL;
+    }
+    value = PyFloat_AsDouble(args[1]);
+    if (value == -1.0 && PyErr_Occurred()) {
         return NULL;
     }
 
-    gpi_set_signal_value_real(self->hdl, value, action);
+    (queued ? gpi_queue_signal_value_real : gpi_set_signal_value_real)(
+        self->hdl, value, action);
     Py_RETURN_NONE;
 }
 
+template <bool queued>
 static PyObject *set_signal_val_int(gpi_hdl_Object<gpi_sim_hdl> *self,
-                                    PyObject *args) {
+                                    PyObject *const *args, Py_ssize_t nargs) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     long long value;
     gpi_set_action_t action;
 
-    if (!PyArg_ParseTuple(args, "iL:set_signal_val_int", &action, &value)) {
+    if (!check_nargs(queued ? "queue_signal_val_int"
+                            : "set_signal_val_int",
+                     nargs, 2) ||
+        !parse_action_arg(args[0], &action)) {
+        return NULL;
+    }
+    if (PyFloat_Check(args[1])) {
+        PyErr_SetString(PyExc_TypeError,
+                        "integer argument expected, got float");
+        return NULL;
+    }
+    value = PyLong_AsLongLong(args[1]);
+    if (value == -1 && PyErr_Occurred()) {
         return NULL;
     }
 
-    gpi_set_signal_value_int(self->hdl, static_cast<int32_t>(value), action);
+    (queued ? gpi_queue_signal_value_int : gpi_set_signal_value_int)(
+        self->hdl, static_cast<int32_t>(value), action);
     Py_RETURN_NONE;
 }
 
 static PyObject *get_definition_name(gpi_hdl_Object<gpi_sim_hdl> *self,
                                      PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     const char *result = gpi_get_definition_name(self->hdl);
     return PyUnicode_FromString(result);
 }
 
 static PyObject *get_definition_file(gpi_hdl_Object<gpi_sim_hdl> *self,
                                      PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     const char *result = gpi_get_definition_file(self->hdl);
     return PyUnicode_FromString(result);
 }
 
 static PyObject *get_handle_by_name(gpi_hdl_Object<gpi_sim_hdl> *self,
                                     PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     const char *name;
 
     if (!PyArg_ParseTuple(args, "s:get_handle_by_name", &name)) {
@@ -630,6 +1823,10 @@ static PyObject *get_handle_by_name(gpi_hdl_Object<gpi_sim_hdl> *self,
 
 static PyObject *get_handle_by_index(gpi_hdl_Object<gpi_sim_hdl> *self,
                                      PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     int32_t index;
 
     if (!PyArg_ParseTuple(args, "i:get_handle_by_index", &index)) {
@@ -642,6 +1839,10 @@ static PyObject *get_handle_by_index(gpi_hdl_Object<gpi_sim_hdl> *self,
 }
 
 static PyObject *get_root_handle(PyObject *, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     const char *name;
 
     if (!gpi_has_registered_impl()) {
@@ -663,27 +1864,47 @@ static PyObject *get_root_handle(PyObject *, PyObject *args) {
 
 static PyObject *get_name_string(gpi_hdl_Object<gpi_sim_hdl> *self,
                                  PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     const char *result = gpi_get_signal_name_str(self->hdl);
     return PyUnicode_FromString(result);
 }
 
 static PyObject *get_type(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     gpi_objtype_t result = gpi_get_object_type(self->hdl);
     return PyLong_FromLong(result);
 }
 
 static PyObject *get_const(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     int result = gpi_is_constant(self->hdl);
     return PyBool_FromLong(result);
 }
 
 static PyObject *get_type_string(gpi_hdl_Object<gpi_sim_hdl> *self,
                                  PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     const char *result = gpi_get_signal_type_str(self->hdl);
     return PyUnicode_FromString(result);
 }
 
 static PyObject *is_running(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     return PyBool_FromLong(gpi_has_registered_impl());
 }
 
@@ -691,6 +1912,10 @@ static PyObject *is_running(PyObject *, PyObject *) {
 // Note we can never log from this function since the logging mechanism calls
 // this to annotate log messages with the current simulation time
 static PyObject *get_sim_time(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
@@ -714,7 +1939,39 @@ static PyObject *get_sim_time(PyObject *, PyObject *) {
     return pTuple;
 }
 
+// Returns the simulator time as a single int, re-using the int object while
+// the time doesn't change. Like get_sim_time() this must never log.
+static PyObject *get_sim_steps(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    static PyObject *cached_steps = NULL;
+    static uint64_t cached_time = 0;
+
+    if (!gpi_has_registered_impl()) {
+        PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
+        return NULL;
+    }
+
+    uint64_t time = gpi_get_sim_time64();
+    if (!cached_steps || time != cached_time) {
+        PyObject *steps = PyLong_FromUnsignedLongLong(time);
+        if (!steps) {
+            return NULL;
+        }
+        Py_XSETREF(cached_steps, steps);
+        cached_time = time;
+    }
+    Py_INCREF(cached_steps);
+    return cached_steps;
+}
+
 static PyObject *get_precision(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     if (!gpi_has_registered_impl()) {
         char const *msg =
             "Simulator is not available! Defaulting precision to 1 fs.";
@@ -732,6 +1989,10 @@ static PyObject *get_precision(PyObject *, PyObject *) {
 }
 
 static PyObject *get_simulator_product(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
@@ -741,6 +2002,10 @@ static PyObject *get_simulator_product(PyObject *, PyObject *) {
 }
 
 static PyObject *get_simulator_version(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
@@ -749,12 +2014,186 @@ static PyObject *get_simulator_version(PyObject *, PyObject *) {
     return PyUnicode_FromString(gpi_get_simulator_version());
 }
 
+static PyObject *get_handle_store_stats(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_handle_store_stats_t stats;
+
+    gpi_get_handle_store_stats(&stats);
+
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:K}", "handles",
+                         (unsigned long long)stats.handles, "capacity",
+                         (unsigned long long)stats.capacity, "lookups",
+                         (unsigned long long)stats.lookups, "hits",
+                         (unsigned long long)stats.hits, "probes",
+                         (unsigned long long)stats.probes);
+}
+
+static PyObject *apply_queued_writes(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    return PyLong_FromLong(gpi_apply_queued_writes());
+}
+
+static PyObject *clear_queued_writes(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_clear_queued_writes();
+    Py_RETURN_NONE;
+}
+
+static PyObject *get_num_queued_writes(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    return PyLong_FromLong(gpi_get_num_queued_writes());
+}
+
+static PyObject *get_cb_pool_stats(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_cb_pool_stats_t stats;
+
+    gpi_get_cb_pool_stats(&stats);
+
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:K}", "allocations",
+                         (unsigned long long)stats.allocations, "reused",
+                         (unsigned long long)stats.reused, "cached",
+                         (unsigned long long)stats.cached, "types",
+                         (unsigned long long)stats.types, "capacity",
+                         (unsigned long long)stats.capacity);
+}
+
+static PyObject *get_stats(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_stats_t stats;
+
+    int enabled = gpi_get_stats(&stats);
+
+    auto latency = PyList_New(GPI_STATS_LATENCY_BUCKETS);
+    if (!latency) {
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < GPI_STATS_LATENCY_BUCKETS; i++) {
+        auto count = PyLong_FromUnsignedLongLong(
+            (unsigned long long)stats.cb_latency[i]);
+        if (!count) {
+            Py_DECREF(latency);
+            return NULL;
+        }
+        PyList_SET_ITEM(latency, i, count);
+    }
+
+    return Py_BuildValue(
+        "{s:O,s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:N}", "enabled",
+        enabled ? Py_True : Py_False, "value_gets",
+        (unsigned long long)stats.value_gets, "value_sets",
+        (unsigned long long)stats.value_sets, "handle_lookups",
+        (unsigned long long)stats.handle_lookups, "native_lookups",
+        (unsigned long long)stats.native_lookups, "iterations",
+        (unsigned long long)stats.iterations, "cb_registrations",
+        (unsigned long long)stats.cb_registrations, "cb_runs",
+        (unsigned long long)stats.cb_runs, "user_ns",
+        (unsigned long long)stats.user_ns, "simulator_ns",
+        (unsigned long long)stats.simulator_ns, "cb_latency", latency);
+}
+
+static PyObject *set_stats_enabled(PyObject *, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    int enable;
+
+    if (!PyArg_ParseTuple(args, "p:set_stats_enabled", &enable)) {
+        return NULL;
+    }
+
+    gpi_set_stats_enabled(enable);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *is_profile_enabled(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    return PyBool_FromLong(gpi_profile_is_enabled());
+}
+
+static PyObject *profile_begin(PyObject *, PyObject *args) {
+    const char *name;
+    const char *category;
+
+    if (!PyArg_ParseTuple(args, "ss:profile_begin", &name, &category)) {
+        return NULL;
+    }
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_profile_begin(name, category);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *profile_end(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_profile_end();
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *set_cb_pool_capacity(PyObject *, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    Py_ssize_t capacity;
+
+    if (!PyArg_ParseTuple(args, "n:set_cb_pool_capacity", &capacity)) {
+        return NULL;
+    }
+    if (capacity < 0) {
+        PyErr_SetString(PyExc_ValueError, "Capacity must not be negative");
+        return NULL;
+    }
+
+    gpi_set_cb_pool_capacity(static_cast<size_t>(capacity));
+
+    Py_RETURN_NONE;
+}
+
 static PyObject *get_num_elems(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     int elems = gpi_get_num_elems(self->hdl);
     return PyLong_FromLong(elems);
 }
 
 static PyObject *get_range(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     int rng_left = gpi_get_range_left(self->hdl);
     int rng_right = gpi_get_range_right(self->hdl);
     int rng_dir = gpi_get_range_dir(self->hdl);
@@ -763,12 +2202,20 @@ static PyObject *get_range(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *) {
 }
 
 static PyObject *get_indexable(gpi_hdl_Object<gpi_sim_hdl> *self, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     int indexable = gpi_is_indexable(self->hdl);
 
     return PyBool_FromLong(indexable);
 }
 
 static PyObject *stop_simulator(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     if (!gpi_has_registered_impl()) {
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
         return NULL;
@@ -778,7 +2225,59 @@ static PyObject *stop_simulator(PyObject *, PyObject *) {
     Py_RETURN_NONE;
 }
 
+static PyObject *set_trace_enabled(PyObject *, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    int enable;
+
+    if (!PyArg_ParseTuple(args, "p:set_trace_enabled", &enable)) {
+        return NULL;
+    }
+    if (!gpi_has_registered_impl()) {
+        PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
+        return NULL;
+    }
+
+    if (gpi_set_trace_enabled(enable)) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "The simulator cannot control its trace");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *save_checkpoint(PyObject *, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    const char *path;
+
+    if (!PyArg_ParseTuple(args, "s:save_checkpoint", &path)) {
+        return NULL;
+    }
+    if (!gpi_has_registered_impl()) {
+        PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
+        return NULL;
+    }
+
+    if (gpi_save_checkpoint(path)) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "The simulator cannot save checkpoints");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
 static PyObject *deregister(gpi_hdl_Object<gpi_cb_hdl> *self, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     // cleanup uncalled callback
     auto cb = static_cast<PythonCallback *>(gpi_get_callback_data(self->hdl));
     delete cb;
@@ -789,6 +2288,35 @@ static PyObject *deregister(gpi_hdl_Object<gpi_cb_hdl> *self, PyObject *) {
     Py_RETURN_NONE;
 }
 
+static PyObject *get_value_bytes(gpi_hdl_Object<gpi_cb_hdl> *self,
+                                 PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    int n_bits = gpi_get_callback_value(self->hdl, NULL, 0);
+    if (n_bits < 0) {
+        Py_RETURN_NONE;
+    }
+
+    std::vector<gpi_vecval_t> words(static_cast<size_t>((n_bits + 31) / 32));
+    if (gpi_get_callback_value(self->hdl, words.data(),
+                               static_cast<int>(words.size())) != n_bits) {
+        Py_RETURN_NONE;
+    }
+
+    Py_ssize_t n_bytes = (n_bits + 7) / 8;
+    PyObject *result = PyBytes_FromStringAndSize(NULL, 2 * n_bytes);
+    if (result == NULL) {
+        return NULL;
+    }
+    unpack_signal_vector(
+        words.data(), n_bits,
+        reinterpret_cast<unsigned char *>(PyBytes_AS_STRING(result)));
+    return result;
+}
+
+// The level is set whenever that of any logger is, from any thread
 static PyObject *log_level(PyObject *, PyObject *args) {
     int l_level;
 
@@ -801,91 +2329,206 @@ static PyObject *log_level(PyObject *, PyObject *args) {
     Py_RETURN_NONE;
 }
 
+class GpiClock;
+
+// Drives every running clock from a single timed callback, armed for the
+// earliest pending edge and re-armed in place after each edge, so no
+// callback is allocated per edge.
+class GpiClockSchedule {
+  public:
+    // Add a clock whose next edge is already set. Returns nonzero if the
+    // timed callback could not be registered.
+    int add(GpiClock *clk, uint64_t now);
+    void remove(GpiClock *clk);
+
+  private:
+    std::vector<GpiClock *> m_clocks;
+    GpiCbHdl *m_cb_hdl = nullptr;
+    uint64_t m_cb_time = 0;  // Simulation time the callback is armed for
+
+    int arm(uint64_t now, uint64_t edge_time);
+    void run();
+    static int timer_cb(void *schedule);
+};
+
+static GpiClockSchedule clock_schedule;
+
 class GpiClock {
   public:
     GpiClock(GpiObjHdl *clk_sig) : clk_signal(clk_sig) {}
 
     ~GpiClock() { stop(); }
 
-    // Start the clock. Returns nonzero in case of failure:
+    // Start the clock. If *n_cycles* is nonzero the clock stops by itself,
+    // back at its starting value, after that many periods.
+    // Returns nonzero in case of failure:
     //  - EBUSY if the clock was already started (stop first)
     //  - EINVAL if the parameters are invalid
     //  - EAGAIN if registering the toggle callback failed
-    int start(uint64_t period_steps, uint64_t high_steps, bool start_high);
+    int start(uint64_t period_steps, uint64_t high_steps, bool start_high,
+              uint64_t n_cycles);
 
     int stop();
 
   private:
+    friend class GpiClockSchedule;
+
     GpiObjHdl *clk_signal = nullptr;
-    GpiCbHdl *clk_toggle_cb_hdl = nullptr;
+    bool running = false;
 
     uint64_t period = 0;
     uint64_t t_high = 0;
 
+    uint64_t next_edge = 0;   // Simulation time of the next toggle
+    uint64_t edges_left = 0;  // Toggles until the clock stops, 0 is forever
+
     int clk_val = 0;
 
-    int toggle(bool initialSet);
-    static int toggle_cb(void *gpi_clk);
+    // Drive the next edge. Returns false once the clock has finished.
+    bool toggle();
 };
 
 int GpiClock::start(uint64_t period_steps, uint64_t high_steps,
-                    bool start_high) {
-    if (clk_toggle_cb_hdl) {
+                    bool start_high, uint64_t n_cycles) {
+    if (running) {
         return EBUSY;
     }
     if ((period_steps < 2) || (high_steps < 1) ||
-        (high_steps >= period_steps)) {
+        (high_steps >= period_steps) ||
+        (n_cycles > std::numeric_limits<uint64_t>::max() / 2)) {
         return EINVAL;
     }
 
     period = period_steps;
     t_high = high_steps;
+    edges_left = n_cycles * 2;
 
     clk_val = start_high;
-    return toggle(true);
+    gpi_set_signal_value_int(clk_signal, clk_val, GPI_DEPOSIT);
+
+    uint64_t now = gpi_get_sim_time64();
+    next_edge = now + (clk_val ? t_high : (period - t_high));
+
+    if (clock_schedule.add(this, now)) {
+        return EAGAIN;  // LCOV_EXCL_LINE
+    }
+    running = true;
+    return 0;
 }
 
 int GpiClock::stop() {
-    if (!clk_toggle_cb_hdl) {
+    if (!running) {
         return -1;
     }
-    gpi_deregister_callback(clk_toggle_cb_hdl);
-    clk_toggle_cb_hdl = nullptr;
+    clock_schedule.remove(this);
+    running = false;
     return 0;
 }
 
-int GpiClock::toggle(bool initialSet) {
-    if (!initialSet) {
-        clk_val = !clk_val;
-    }
+bool GpiClock::toggle() {
+    clk_val = !clk_val;
     gpi_set_signal_value_int(clk_signal, clk_val, GPI_DEPOSIT);
 
-    uint64_t to_next_edge = clk_val ? t_high : (period - t_high);
+    if (edges_left && --edges_left == 0) {
+        running = false;
+        return false;
+    }
+
+    next_edge += clk_val ? t_high : (period - t_high);
+    return true;
+}
 
-    clk_toggle_cb_hdl =
-        gpi_register_timed_callback(&GpiClock::toggle_cb, this, to_next_edge);
-    if (!clk_toggle_cb_hdl) {
-        // LCOV_EXCL_START
-        if (!initialSet) {
-            // Failing when called from start() will be reported via
-            // exception, but log in case of later failure that would
-            // otherwise be silent.
-            LOG_ERROR("Clock will be stopped: failed to register toggle cb");
+int GpiClockSchedule::add(GpiClock *clk, uint64_t now) {
+    if (!m_cb_hdl || clk->next_edge < m_cb_time) {
+        if (arm(now, clk->next_edge)) {
+            return -1;  // LCOV_EXCL_LINE
         }
-        return EAGAIN;
-        // LCOV_EXCL_STOP
     }
+    m_clocks.push_back(clk);
+    return 0;
+}
+
+void GpiClockSchedule::remove(GpiClock *clk) {
+    auto it = std::find(m_clocks.begin(), m_clocks.end(), clk);
+    if (it == m_clocks.end()) {
+        return;
+    }
+    *it = m_clocks.back();
+    m_clocks.pop_back();
+
+    // Any remaining clocks will move the callback to their next edge when it
+    // fires.
+    if (m_clocks.empty() && m_cb_hdl) {
+        gpi_deregister_callback(m_cb_hdl);
+        m_cb_hdl = nullptr;
+    }
+}
 
+int GpiClockSchedule::arm(uint64_t now, uint64_t edge_time) {
+    // Register the new callback before dropping the old one so the running
+    // clocks keep going if this fails.
+    GpiCbHdl *cb_hdl = gpi_register_timed_callback(
+        &GpiClockSchedule::timer_cb, this, edge_time - now);
+    if (!cb_hdl) {
+        return -1;  // LCOV_EXCL_LINE
+    }
+    if (m_cb_hdl) {
+        gpi_deregister_callback(m_cb_hdl);
+    }
+    m_cb_hdl = cb_hdl;
+    m_cb_time = edge_time;
     return 0;
 }
 
-int GpiClock::toggle_cb(void *gpi_clk) {
-    GpiClock *clk_obj = (GpiClock *)gpi_clk;
-    return clk_obj->toggle(false);
+void GpiClockSchedule::run() {
+    uint64_t now = m_cb_time;
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+
+    for (size_t i = 0; i < m_clocks.size();) {
+        GpiClock *clk = m_clocks[i];
+        if (clk->next_edge == now && !clk->toggle()) {
+            m_clocks[i] = m_clocks.back();
+            m_clocks.pop_back();
+            continue;
+        }
+        next = std::min(next, clk->next_edge);
+        ++i;
+    }
+
+    if (m_clocks.empty()) {
+        // Not re-armed, so the GPI frees the callback on return
+        m_cb_hdl = nullptr;
+        return;
+    }
+
+    if (gpi_rearm_timed_callback(m_cb_hdl, next - now)) {
+        m_cb_hdl = gpi_register_timed_callback(&GpiClockSchedule::timer_cb,
+                                               this, next - now);
+        if (!m_cb_hdl) {
+            // LCOV_EXCL_START
+            LOG_ERROR("Clocks will be stopped: failed to register toggle cb");
+            for (GpiClock *clk : m_clocks) {
+                clk->running = false;
+            }
+            m_clocks.clear();
+            return;
+            // LCOV_EXCL_STOP
+        }
+    }
+    m_cb_time = next;
+}
+
+int GpiClockSchedule::timer_cb(void *schedule) {
+    static_cast<GpiClockSchedule *>(schedule)->run();
+    return 0;
 }
 
 // Create a new clock object
 static PyObject *clock_create(PyObject *, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
     if (!gpi_has_registered_impl()) {
         // LCOV_EXCL_START
         PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
@@ -928,45 +2571,827 @@ static void clock_dealloc(PyObject *self) {
         // LCOV_EXCL_STOP
     }
 
-    GpiClock *gpi_clk = ((gpi_hdl_Object<gpi_clk_hdl> *)self)->hdl;
+    GpiClock *gpi_clk = ((gpi_hdl_Object<gpi_clk_hdl> *)self)->hdl;
+
+    delete gpi_clk;
+
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *clk_start(gpi_hdl_Object<gpi_clk_hdl> *self, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    unsigned long long period, t_high;
+    int start_high;
+    unsigned long long n_cycles = 0;
+
+    if (!PyArg_ParseTuple(args, "KKp|K:start", &period, &t_high, &start_high,
+                          &n_cycles)) {
+        return NULL;
+    }
+
+    int ret = self->hdl->start(period, t_high, start_high, n_cycles);
+
+    if (ret != 0) {
+        if (ret == EINVAL) {
+            PyErr_SetString(PyExc_ValueError,
+                            "Failed to start clock: invalid arguments!\n");
+        } else if (ret == EBUSY) {
+            PyErr_SetString(PyExc_RuntimeError,
+                            "Failed to start clock: already started!\n");
+        } else {
+            // LCOV_EXCL_START
+            PyErr_SetString(PyExc_RuntimeError, "Failed to start clock!\n");
+            // LCOV_EXCL_STOP
+        }
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *clk_stop(gpi_hdl_Object<gpi_clk_hdl> *self, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    self->hdl->stop();
+
+    Py_RETURN_NONE;
+}
+
+/* A fixed group of signals which are read and written together, so that a
+ * monitor sampling many signals only crosses into the GPI once per sample.
+ *
+ * Values are exchanged through contiguous buffers, either one 64-bit integer
+ * per member, or the packed 4-state bytes of each member laid out one after
+ * the other as for get_signal_val_bytes().
+ */
+class GpiSignalGroup {
+  public:
+    GpiSignalGroup(std::vector<gpi_sim_hdl> signals);
+
+    size_t size() const { return m_signals.size(); }
+
+    // Number of bytes taken by the packed values of all members, -1 if a
+    // member has no packed value
+    Py_ssize_t packed_size() const { return m_packed_size; }
+
+    void read_int(int64_t *values);
+    void write_int(const int64_t *values, gpi_set_action_t action);
+    void read_packed(unsigned char *values);
+    void write_packed(const unsigned char *values, gpi_set_action_t action);
+
+  private:
+    std::vector<gpi_sim_hdl> m_signals;
+    std::vector<int> m_widths;
+    Py_ssize_t m_packed_size = 0;
+    int m_max_width = 0;
+};
+
+GpiSignalGroup::GpiSignalGroup(std::vector<gpi_sim_hdl> signals)
+    : m_signals(std::move(signals)) {
+    for (auto sig : m_signals) {
+        int width = gpi_get_signal_value_bytes(sig, NULL, 0);
+        m_widths.push_back(width);
+        if (width < 0) {
+            m_packed_size = -1;
+        } else if (m_packed_size >= 0) {
+            m_packed_size += 2 * ((width + 7) / 8);
+            m_max_width = std::max(m_max_width, width);
+        }
+    }
+}
+
+void GpiSignalGroup::read_int(int64_t *values) {
+    for (size_t i = 0; i < m_signals.size(); i++) {
+        values[i] = gpi_get_signal_value_long(m_signals[i]);
+    }
+}
+
+void GpiSignalGroup::write_int(const int64_t *values,
+                               gpi_set_action_t action) {
+    for (size_t i = 0; i < m_signals.size(); i++) {
+        gpi_set_signal_value_int(m_signals[i], static_cast<int32_t>(values[i]),
+                                 action);
+    }
+}
+
+void GpiSignalGroup::read_packed(unsigned char *values) {
+    gpi_vecval_t *words =
+        get_vector_scratch(static_cast<size_t>((m_max_width + 31) / 32));
+    int n_words = static_cast<int>(vector_scratch.size());
+
+    for (size_t i = 0; i < m_signals.size(); i++) {
+        int width = m_widths[i];
+        if (gpi_get_signal_value_bytes(m_signals[i], words, n_words) < 0) {
+            // States that can't be packed are read as X
+            for (int w = 0; w < (width + 31) / 32; w++) {
+                words[w].aval = words[w].bval = 0xFFFFFFFFu;
+            }
+            if (width % 32) {
+                uint32_t mask = (1u << (width % 32)) - 1;
+                words[(width - 1) / 32].aval &= mask;
+                words[(width - 1) / 32].bval &= mask;
+            }
+        }
+        unpack_signal_vector(words, width, values);
+        values += 2 * ((width + 7) / 8);
+    }
+}
+
+void GpiSignalGroup::write_packed(const unsigned char *values,
+                                  gpi_set_action_t action) {
+    gpi_vecval_t *words =
+        get_vector_scratch(static_cast<size_t>((m_max_width + 31) / 32));
+
+    for (size_t i = 0; i < m_signals.size(); i++) {
+        int width = m_widths[i];
+        pack_signal_vector(values, width, words);
+        gpi_set_signal_value_vector(m_signals[i], words, width, action);
+        values += 2 * ((width + 7) / 8);
+    }
+}
+
+// Create a new signal group object
+static PyObject *signal_group_create(PyObject *, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    if (!gpi_has_registered_impl()) {
+        // LCOV_EXCL_START
+        PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
+        return NULL;
+        // LCOV_EXCL_STOP
+    }
+
+    PyObject *pSigs;
+    if (!PyArg_ParseTuple(args, "O:signal_group_create", &pSigs)) {
+        return NULL;
+    }
+
+    PyObject *seq = PySequence_Fast(pSigs, "signals must be a sequence");
+    if (seq == NULL) {
+        return NULL;
+    }
+
+    std::vector<gpi_sim_hdl> signals;
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+        if (Py_TYPE(item) != &gpi_hdl_Object<gpi_sim_hdl>::py_type) {
+            PyErr_Format(PyExc_TypeError,
+                         "signals[%zd] must be a gpi_sim_hdl, not %s", i,
+                         Py_TYPE(item)->tp_name);
+            Py_DECREF(seq);
+            return NULL;
+        }
+        signals.push_back(((gpi_hdl_Object<gpi_sim_hdl> *)item)->hdl);
+    }
+    Py_DECREF(seq);
+
+    return gpi_hdl_New(new GpiSignalGroup(std::move(signals)));
+}
+
+static void signal_group_dealloc(PyObject *self) {
+    GpiSignalGroup *group = ((gpi_hdl_Object<gpi_group_hdl> *)self)->hdl;
+
+    delete group;
+
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+// Gets a buffer of at least `size` bytes, raising ValueError if it's smaller
+static int get_group_buffer(PyObject *obj, Py_buffer *view, Py_ssize_t size,
+                            bool writable) {
+    if (PyObject_GetBuffer(obj, view,
+                           writable ? PyBUF_WRITABLE : PyBUF_SIMPLE) < 0) {
+        return -1;
+    }
+    if (view->len < size) {
+        PyErr_Format(PyExc_ValueError,
+                     "Buffer of %zd bytes is too small, %zd are needed",
+                     view->len, size);
+        PyBuffer_Release(view);
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject *group_read_int_into(gpi_hdl_Object<gpi_group_hdl> *self,
+                                     PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    PyObject *pBuf;
+    Py_buffer view;
+
+    if (!PyArg_ParseTuple(args, "O:read_int_into", &pBuf)) {
+        return NULL;
+    }
+
+    Py_ssize_t size =
+        static_cast<Py_ssize_t>(self->hdl->size() * sizeof(int64_t));
+    if (get_group_buffer(pBuf, &view, size, true) < 0) {
+        return NULL;
+    }
+
+    if (reinterpret_cast<uintptr_t>(view.buf) % alignof(int64_t)) {
+        std::vector<int64_t> values(self->hdl->size());
+        self->hdl->read_int(values.data());
+        memcpy(view.buf, values.data(), static_cast<size_t>(size));
+    } else {
+        self->hdl->read_int(static_cast<int64_t *>(view.buf));
+    }
+
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+static PyObject *group_write_int(gpi_hdl_Object<gpi_group_hdl> *self,
+                                 PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_set_action_t action;
+    PyObject *pBuf;
+    Py_buffer view;
+
+    if (!PyArg_ParseTuple(args, "iO:write_int", &action, &pBuf)) {
+        return NULL;
+    }
+
+    Py_ssize_t size =
+        static_cast<Py_ssize_t>(self->hdl->size() * sizeof(int64_t));
+    if (get_group_buffer(pBuf, &view, size, false) < 0) {
+        return NULL;
+    }
+
+    std::vector<int64_t> values(self->hdl->size());
+    memcpy(values.data(), view.buf, static_cast<size_t>(size));
+    PyBuffer_Release(&view);
+
+    for (size_t i = 0; i < values.size(); i++) {
+        if (values[i] < std::numeric_limits<int32_t>::min() ||
+            values[i] > std::numeric_limits<uint32_t>::max()) {
+            PyErr_Format(PyExc_OverflowError,
+                         "Value %lld of member %zu does not fit in 32 bits",
+                         static_cast<long long>(values[i]), i);
+            return NULL;
+        }
+    }
+
+    self->hdl->write_int(values.data(), action);
+    Py_RETURN_NONE;
+}
+
+static PyObject *group_read_bytes_into(gpi_hdl_Object<gpi_group_hdl> *self,
+                                       PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    PyObject *pBuf;
+    Py_buffer view;
+
+    if (!PyArg_ParseTuple(args, "O:read_bytes_into", &pBuf)) {
+        return NULL;
+    }
+
+    if (self->hdl->packed_size() < 0) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Not all signals of the group have packed values");
+        return NULL;
+    }
+
+    if (get_group_buffer(pBuf, &view, self->hdl->packed_size(), true) < 0) {
+        return NULL;
+    }
+
+    self->hdl->read_packed(static_cast<unsigned char *>(view.buf));
+
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+static PyObject *group_write_bytes(gpi_hdl_Object<gpi_group_hdl> *self,
+                                   PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    gpi_set_action_t action;
+    PyObject *pBuf;
+    Py_buffer view;
+
+    if (!PyArg_ParseTuple(args, "iO:write_bytes", &action, &pBuf)) {
+        return NULL;
+    }
+
+    if (self->hdl->packed_size() < 0) {
+        PyErr_SetString(PyExc_TypeError,
+                        "Not all signals of the group have packed values");
+        return NULL;
+    }
+
+    if (get_group_buffer(pBuf, &view, self->hdl->packed_size(), false) < 0) {
+        return NULL;
+    }
+
+    self->hdl->write_packed(static_cast<const unsigned char *>(view.buf),
+                            action);
+
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+}
+
+static PyObject *group_get_num_signals(gpi_hdl_Object<gpi_group_hdl> *self,
+                                       PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    return PyLong_FromSize_t(self->hdl->size());
+}
+
+static PyObject *group_get_packed_size(gpi_hdl_Object<gpi_group_hdl> *self,
+                                       PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    return PyLong_FromSsize_t(self->hdl->packed_size());
+}
+
+/* Records the changes of a fixed set of signals from persistent value change
+ * callbacks, without calling into Python, so that the history of many
+ * signals can be kept at the cost of a few copies per change.
+ *
+ * Records are kept in columns: the simulation time, the index of the signal
+ * in the recorder, and the packed 4-state words of its value, padded to the
+ * size of the widest signal.
+ */
+class GpiRecorder {
+  public:
+    GpiRecorder(std::vector<gpi_sim_hdl> signals);
+    ~GpiRecorder() {
+        // The callbacks are gone with the simulator
+        if (gpi_has_registered_impl()) {
+            stop();
+        }
+    }
+
+    // Record the current value of every signal, then every change of value.
+    // Returns nonzero if a callback could not be registered.
+    int start();
+    void stop();
+    bool running() const { return m_running; }
+
+    size_t size() const { return m_times.size(); }
+    size_t num_signals() const { return m_probes.size(); }
+    // Number of words of each value
+    size_t stride() const { return m_stride; }
+
+    // Index of the first record at or after time *t*
+    size_t find(uint64_t t) const;
+    // Copy the records [first, last) into buffers of the sizes given by
+    // size() and stride()
+    void copy(size_t first, size_t last, uint64_t *times, uint32_t *ids,
+              gpi_vecval_t *values) const;
+    void clear();
+
+  private:
+    struct Probe {
+        GpiRecorder *recorder;
+        gpi_sim_hdl signal;
+        uint32_t id;
+        int width;
+        gpi_cb_hdl cb_hdl;
+    };
+
+    static int value_change_cb(void *probe);
+    void record(const Probe &probe, uint64_t t);
+
+    std::vector<Probe> m_probes;
+    size_t m_stride = 1;
+    bool m_running = false;
+    std::vector<uint64_t> m_times;
+    std::vector<uint32_t> m_ids;
+    std::vector<gpi_vecval_t> m_values;
+};
+
+// The signals are logic signals of known width, see recorder_create()
+GpiRecorder::GpiRecorder(std::vector<gpi_sim_hdl> signals) {
+    m_probes.reserve(signals.size());
+    for (auto sig : signals) {
+        int width = gpi_get_signal_value_bytes(sig, NULL, 0);
+        m_probes.push_back({this, sig, static_cast<uint32_t>(m_probes.size()),
+                            width, nullptr});
+        m_stride = std::max(m_stride, static_cast<size_t>((width + 31) / 32));
+    }
+}
+
+int GpiRecorder::start() {
+    if (m_running) {
+        return 0;
+    }
+    uint64_t now = gpi_get_sim_time64();
+    for (auto &probe : m_probes) {
+        probe.cb_hdl = gpi_register_value_change_callback(
+            value_change_cb, &probe, probe.signal, GPI_VALUE_CHANGE);
+        if (!probe.cb_hdl) {
+            m_running = true;
+            stop();
+            return -1;
+        }
+        record(probe, now);
+    }
+    m_running = true;
+    return 0;
+}
+
+void GpiRecorder::stop() {
+    if (!m_running) {
+        return;
+    }
+    for (auto &probe : m_probes) {
+        if (probe.cb_hdl) {
+            gpi_deregister_callback(probe.cb_hdl);
+            probe.cb_hdl = nullptr;
+        }
+    }
+    m_running = false;
+}
+
+int GpiRecorder::value_change_cb(void *data) {
+    auto &probe = *static_cast<Probe *>(data);
+    probe.recorder->record(probe, gpi_get_sim_time64());
+    gpi_rearm_value_change_callback(probe.cb_hdl);
+    return 0;
+}
+
+void GpiRecorder::record(const Probe &probe, uint64_t t) {
+    m_times.push_back(t);
+    m_ids.push_back(probe.id);
+    size_t offset = m_values.size();
+    m_values.resize(offset + m_stride, {0, 0});
+    gpi_vecval_t *words = &m_values[offset];
+
+    int width = probe.width;
+    int n_words = static_cast<int>(m_stride);
+    // Use the value delivered with the change if the simulator provided one
+    int n_bits = probe.cb_hdl
+                     ? gpi_get_callback_value(probe.cb_hdl, words, n_words)
+                     : -1;
+    if (n_bits < 0) {
+        n_bits = gpi_get_signal_value_bytes(probe.signal, words, n_words);
+    }
+    if (n_bits < 0) {
+        // States that can't be packed are recorded as X
+        for (int w = 0; w < (width + 31) / 32; w++) {
+            words[w].aval = words[w].bval = 0xFFFFFFFFu;
+        }
+        if (width % 32) {
+            uint32_t mask = (1u << (width % 32)) - 1;
+            words[(width - 1) / 32].aval &= mask;
+            words[(width - 1) / 32].bval &= mask;
+        }
+    }
+}
+
+size_t GpiRecorder::find(uint64_t t) const {
+    return static_cast<size_t>(
+        std::lower_bound(m_times.begin(), m_times.end(), t) - m_times.begin());
+}
+
+void GpiRecorder::copy(size_t first, size_t last, uint64_t *times,
+                       uint32_t *ids, gpi_vecval_t *values) const {
+    size_t n = last - first;
+    if (!n) {
+        return;
+    }
+    memcpy(times, m_times.data() + first, n * sizeof(*times));
+    memcpy(ids, m_ids.data() + first, n * sizeof(*ids));
+    memcpy(values, m_values.data() + first * m_stride,
+           n * m_stride * sizeof(*values));
+}
+
+void GpiRecorder::clear() {
+    m_times.clear();
+    m_ids.clear();
+    m_values.clear();
+}
+
+// Create a new recorder object
+static PyObject *recorder_create(PyObject *, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    if (!gpi_has_registered_impl()) {
+        // LCOV_EXCL_START
+        PyErr_SetString(PyExc_RuntimeError, "No simulator available!");
+        return NULL;
+        // LCOV_EXCL_STOP
+    }
+
+    PyObject *pSigs;
+    if (!PyArg_ParseTuple(args, "O:recorder_create", &pSigs)) {
+        return NULL;
+    }
+
+    PyObject *seq = PySequence_Fast(pSigs, "signals must be a sequence");
+    if (seq == NULL) {
+        return NULL;
+    }
+
+    std::vector<gpi_sim_hdl> signals;
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+        if (Py_TYPE(item) != &gpi_hdl_Object<gpi_sim_hdl>::py_type) {
+            PyErr_Format(PyExc_TypeError,
+                         "signals[%zd] must be a gpi_sim_hdl, not %s", i,
+                         Py_TYPE(item)->tp_name);
+            Py_DECREF(seq);
+            return NULL;
+        }
+        gpi_sim_hdl sig = ((gpi_hdl_Object<gpi_sim_hdl> *)item)->hdl;
+        // Values are recorded packed, so only logic signals of known width
+        gpi_objtype_t type = gpi_get_object_type(sig);
+        if ((type != GPI_NET && type != GPI_REGISTER &&
+             type != GPI_PACKED_STRUCTURE) ||
+            gpi_get_signal_value_bytes(sig, NULL, 0) <= 0) {
+            PyErr_Format(PyExc_TypeError,
+                         "signals[%zd] must be a logic signal of known width",
+                         i);
+            Py_DECREF(seq);
+            return NULL;
+        }
+        signals.push_back(sig);
+    }
+    Py_DECREF(seq);
+
+    return gpi_hdl_New(new GpiRecorder(std::move(signals)));
+}
+
+static void recorder_dealloc(PyObject *self) {
+    GpiRecorder *recorder = ((gpi_hdl_Object<gpi_rec_hdl> *)self)->hdl;
+
+    delete recorder;
+
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *recorder_start(gpi_hdl_Object<gpi_rec_hdl> *self,
+                                PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    if (self->hdl->start()) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "Failed to register value change callbacks");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *recorder_stop(gpi_hdl_Object<gpi_rec_hdl> *self,
+                               PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    self->hdl->stop();
+    Py_RETURN_NONE;
+}
+
+// Returns a (times, ids, values) tuple of bytes objects holding the records
+// [first, last)
+static PyObject *recorder_records(GpiRecorder *recorder, size_t first,
+                                  size_t last) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    size_t n = last - first;
+    PyObject *times = PyBytes_FromStringAndSize(
+        NULL, static_cast<Py_ssize_t>(n * sizeof(uint64_t)));
+    PyObject *ids = PyBytes_FromStringAndSize(
+        NULL, static_cast<Py_ssize_t>(n * sizeof(uint32_t)));
+    PyObject *values = PyBytes_FromStringAndSize(
+        NULL,
+        static_cast<Py_ssize_t>(n * recorder->stride() * sizeof(gpi_vecval_t)));
+    if (!times || !ids || !values) {
+        Py_XDECREF(times);
+        Py_XDECREF(ids);
+        Py_XDECREF(values);
+        return NULL;
+    }
+
+    // bytes objects are aligned for any type
+    recorder->copy(first, last,
+                   reinterpret_cast<uint64_t *>(PyBytes_AS_STRING(times)),
+                   reinterpret_cast<uint32_t *>(PyBytes_AS_STRING(ids)),
+                   reinterpret_cast<gpi_vecval_t *>(PyBytes_AS_STRING(values)));
+
+    PyObject *result = PyTuple_New(3);
+    if (!result) {
+        Py_DECREF(times);
+        Py_DECREF(ids);
+        Py_DECREF(values);
+        return NULL;
+    }
+    PyTuple_SET_ITEM(result, 0, times);
+    PyTuple_SET_ITEM(result, 1, ids);
+    PyTuple_SET_ITEM(result, 2, values);
+    return result;
+}
+
+static PyObject *recorder_query(gpi_hdl_Object<gpi_rec_hdl> *self,
+                                PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    unsigned long long start, end;
+
+    if (!PyArg_ParseTuple(args, "KK:query", &start, &end)) {
+        return NULL;
+    }
+
+    size_t first = self->hdl->find(start);
+    size_t last = std::max(first, self->hdl->find(end));
+    return recorder_records(self->hdl, first, last);
+}
+
+static PyObject *recorder_drain(gpi_hdl_Object<gpi_rec_hdl> *self,
+                                PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    PyObject *result = recorder_records(self->hdl, 0, self->hdl->size());
+    if (result) {
+        self->hdl->clear();
+    }
+    return result;
+}
+
+static PyObject *recorder_get_num_records(gpi_hdl_Object<gpi_rec_hdl> *self,
+                                          PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    return PyLong_FromSize_t(self->hdl->size());
+}
+
+static PyObject *recorder_get_num_signals(gpi_hdl_Object<gpi_rec_hdl> *self,
+                                          PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    return PyLong_FromSize_t(self->hdl->num_signals());
+}
+
+static PyObject *recorder_get_value_words(gpi_hdl_Object<gpi_rec_hdl> *self,
+                                          PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    return PyLong_FromSize_t(self->hdl->stride());
+}
+
+// A Python callable run on the worker pool of the GPI
+struct GpiPyWork {
+    gpi_work_hdl work = nullptr;
+    PyObject *func;
+    // Set by the worker before the work is done
+    PyObject *result = nullptr;
+    PyObject *exc = nullptr;
+};
+
+// Runs on a worker thread. The work object is kept alive until here by the
+// reference taken in submit_work().
+static void pywork_run(void *data) {
+    PyGILState_STATE gstate = PyGILState_Ensure();
+
+    auto *self = static_cast<gpi_hdl_Object<gpi_pywork_hdl> *>(data);
+    GpiPyWork *pywork = self->hdl;
+    pywork->result = PyObject_CallObject(pywork->func, NULL);
+    if (pywork->result == NULL) {
+#if PY_VERSION_HEX >= 0x030C0000
+        pywork->exc = PyErr_GetRaisedException();
+#else
+        PyObject *exc_type, *exc_tb;
+        PyErr_Fetch(&exc_type, &pywork->exc, &exc_tb);
+        PyErr_NormalizeException(&exc_type, &pywork->exc, &exc_tb);
+        if (exc_tb) {
+            PyException_SetTraceback(pywork->exc, exc_tb);
+        }
+        Py_XDECREF(exc_type);
+        Py_XDECREF(exc_tb);
+#endif
+    }
+    Py_CLEAR(pywork->func);
+    Py_DECREF(self);
+
+    PyGILState_Release(gstate);
+}
+
+static PyObject *submit_work(PyObject *, PyObject *args) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
+
+    PyObject *func;
+    if (!PyArg_ParseTuple(args, "O:submit_work", &func)) {
+        return NULL;
+    }
+    if (!PyCallable_Check(func)) {
+        PyErr_SetString(PyExc_TypeError, "func must be callable");
+        return NULL;
+    }
+
+    GpiPyWork *pywork = new GpiPyWork;
+    Py_INCREF(func);
+    pywork->func = func;
+    PyObject *self = gpi_hdl_New(pywork);
+    if (self == NULL) {
+        Py_DECREF(func);
+        delete pywork;
+        return NULL;
+    }
+
+    // Released by pywork_run()
+    Py_INCREF(self);
+    pywork->work = gpi_submit_work(pywork_run, self);
+    if (pywork->work == NULL) {
+        Py_DECREF(self);
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_RuntimeError,
+                        "Unable to start the GPI worker pool");
+        return NULL;
+    }
+    return self;
+}
+
+static void pywork_dealloc(PyObject *self) {
+    GpiPyWork *pywork = ((gpi_hdl_Object<gpi_pywork_hdl> *)self)->hdl;
 
-    delete gpi_clk;
+    if (pywork->work) {
+        gpi_release_work(pywork->work);
+    }
+    Py_XDECREF(pywork->func);
+    Py_XDECREF(pywork->result);
+    Py_XDECREF(pywork->exc);
+    delete pywork;
 
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
-static PyObject *clk_start(gpi_hdl_Object<gpi_clk_hdl> *self, PyObject *args) {
-    unsigned long long period, t_high;
-    int start_high;
+static PyObject *pywork_done(gpi_hdl_Object<gpi_pywork_hdl> *self,
+                             PyObject *) {
+    return PyBool_FromLong(gpi_work_done(self->hdl->work));
+}
 
-    if (!PyArg_ParseTuple(args, "KKp:start", &period, &t_high, &start_high)) {
+static PyObject *pywork_result(gpi_hdl_Object<gpi_pywork_hdl> *self,
+                               PyObject *) {
+    if (!check_sim_thread()) {
         return NULL;
     }
 
-    int ret = self->hdl->start(period, t_high, start_high);
+    GpiPyWork *pywork = self->hdl;
+    if (!gpi_work_done(pywork->work)) {
+        // The worker needs the GIL to finish
+        Py_BEGIN_ALLOW_THREADS;
+        gpi_wait_work(pywork->work);
+        Py_END_ALLOW_THREADS;
+    }
 
-    if (ret != 0) {
-        if (ret == EINVAL) {
-            PyErr_SetString(PyExc_ValueError,
-                            "Failed to start clock: invalid arguments!\n");
-        } else if (ret == EBUSY) {
-            PyErr_SetString(PyExc_RuntimeError,
-                            "Failed to start clock: already started!\n");
-        } else {
-            // LCOV_EXCL_START
-            PyErr_SetString(PyExc_RuntimeError, "Failed to start clock!\n");
-            // LCOV_EXCL_STOP
-        }
+    if (pywork->result == NULL) {
+        PyErr_SetObject((PyObject *)Py_TYPE(pywork->exc), pywork->exc);
         return NULL;
     }
-
-    Py_RETURN_NONE;
+    Py_INCREF(pywork->result);
+    return pywork->result;
 }
 
-static PyObject *clk_stop(gpi_hdl_Object<gpi_clk_hdl> *self, PyObject *) {
-    self->hdl->stop();
+static PyObject *get_num_worker_threads(PyObject *, PyObject *) {
+    if (!check_sim_thread()) {
+        return NULL;
+    }
 
-    Py_RETURN_NONE;
+    return PyLong_FromLong(gpi_get_num_worker_threads());
 }
 
 static int add_module_constants(PyObject *simulator) {
@@ -997,6 +3422,13 @@ static int add_module_constants(PyObject *simulator) {
         PyModule_AddIntConstant(simulator, "RANGE_DOWN", GPI_RANGE_DOWN) < 0 ||
         PyModule_AddIntConstant(simulator, "RANGE_NO_DIR", GPI_RANGE_NO_DIR) <
             0 ||
+        PyModule_AddIntConstant(simulator, "ACCESS_INT", ACCESS_INT) < 0 ||
+        PyModule_AddIntConstant(simulator, "ACCESS_BINSTR", ACCESS_BINSTR) <
+            0 ||
+        PyModule_AddIntConstant(simulator, "ACCESS_LONG", ACCESS_LONG) < 0 ||
+        PyModule_AddIntConstant(simulator, "ACCESS_REAL", ACCESS_REAL) < 0 ||
+        PyModule_AddIntConstant(simulator, "ACCESS_STR", ACCESS_STR) < 0 ||
+        PyModule_AddIntConstant(simulator, "ACCESS_LOGIC", ACCESS_LOGIC) < 0 ||
         false) {
         return -1;
     }
@@ -1038,6 +3470,42 @@ static int add_module_types(PyObject *simulator) {
         // LCOV_EXCL_STOP
     }
 
+    typ = (PyObject *)&gpi_hdl_Object<gpi_group_hdl>::py_type;
+    Py_INCREF(typ);
+    if (PyModule_AddObject(simulator, "GpiSignalGroup", typ) < 0) {
+        // LCOV_EXCL_START
+        Py_DECREF(typ);
+        return -1;
+        // LCOV_EXCL_STOP
+    }
+
+    typ = (PyObject *)&gpi_hdl_Object<gpi_rec_hdl>::py_type;
+    Py_INCREF(typ);
+    if (PyModule_AddObject(simulator, "GpiRecorder", typ) < 0) {
+        // LCOV_EXCL_START
+        Py_DECREF(typ);
+        return -1;
+        // LCOV_EXCL_STOP
+    }
+
+    typ = (PyObject *)&gpi_hdl_Object<gpi_accessor_hdl>::py_type;
+    Py_INCREF(typ);
+    if (PyModule_AddObject(simulator, "GpiValueAccessor", typ) < 0) {
+        // LCOV_EXCL_START
+        Py_DECREF(typ);
+        return -1;
+        // LCOV_EXCL_STOP
+    }
+
+    typ = (PyObject *)&gpi_hdl_Object<gpi_pywork_hdl>::py_type;
+    Py_INCREF(typ);
+    if (PyModule_AddObject(simulator, "GpiWork", typ) < 0) {
+        // LCOV_EXCL_START
+        Py_DECREF(typ);
+        return -1;
+        // LCOV_EXCL_STOP
+    }
+
     return 0;
 }
 
@@ -1063,33 +3531,53 @@ static PyMethodDef SimulatorMethods[] = {
                "Get an iterator handle to loop over all packages.\n"
                "\n"
                ".. versionadded:: 2.0")},
-    {"register_timed_callback", register_timed_callback, METH_VARARGS,
+    {"register_timed_callback", FASTCALL_METHOD(register_timed_callback),
      PyDoc_STR("register_timed_callback(time, func, /, *args)\n"
                "--\n\n"
                "register_timed_callback(time: int, func: Callable[..., None], "
                "*args: Any) -> cocotb.simulator.gpi_cb_hdl\n"
                "Register a timed callback.")},
-    {"register_value_change_callback", register_value_change_callback,
-     METH_VARARGS,
+    {"register_value_change_callback",
+     FASTCALL_METHOD(register_value_change_callback),
      PyDoc_STR("register_value_change_callback(signal, func, edge, /, *args)\n"
                "--\n\n"
                "register_value_change_callback(signal: "
                "cocotb.simulator.gpi_sim_hdl, func: Callable[..., None], edge: "
                "int, *args: Any) -> cocotb.simulator.gpi_cb_hdl\n"
                "Register a signal change callback.")},
-    {"register_readonly_callback", register_readonly_callback, METH_VARARGS,
+    {"register_value_match_callback",
+     FASTCALL_METHOD(register_value_match_callback),
+     PyDoc_STR(
+         "register_value_match_callback(signal, edge_signal, edge, value, "
+         "mask, negate, func, /, *args)\n"
+         "--\n\n"
+         "register_value_match_callback(signal: cocotb.simulator.gpi_sim_hdl, "
+         "edge_signal: cocotb.simulator.gpi_sim_hdl | None, edge: int, "
+         "value: bytes, mask: bytes, negate: bool, func: Callable[..., None], "
+         "*args: Any) -> cocotb.simulator.gpi_cb_hdl\n"
+         "Register a callback for the first *edge* of *edge_signal*, or "
+         "change of *signal* if it is ``None``, at which the bits of "
+         "*signal* set in *mask* equal those of *value*, or differ if "
+         "*negate* is true.\n"
+         "*value* and *mask* are little-endian, one byte per 8 bits of "
+         "*signal*.\n"
+         "\n"
+         "The value is compared without calling into Python.\n"
+         "\n"
+         ".. versionadded:: 2.0")},
+    {"register_readonly_callback", FASTCALL_METHOD(register_readonly_callback),
      PyDoc_STR("register_readonly_callback(func, /, *args)\n"
                "--\n\n"
                "register_readonly_callback(func: Callable[..., None], *args: "
                "Any) -> cocotb.simulator.gpi_cb_hdl\n"
                "Register a callback for the read-only section.")},
-    {"register_nextstep_callback", register_nextstep_callback, METH_VARARGS,
+    {"register_nextstep_callback", FASTCALL_METHOD(register_nextstep_callback),
      PyDoc_STR("register_nextstep_callback(func, /, *args)\n"
                "--\n\n"
                "register_nextstep_callback(func: Callable[..., None], *args: "
                "Any) -> cocotb.simulator.gpi_cb_hdl\n"
                "Register a callback for the cbNextSimTime callback.")},
-    {"register_rwsynch_callback", register_rwsynch_callback, METH_VARARGS,
+    {"register_rwsynch_callback", FASTCALL_METHOD(register_rwsynch_callback),
      PyDoc_STR("register_rwsynch_callback(func, /, *args)\n"
                "--\n\n"
                "register_rwsynch_callback(func: Callable[..., None], *args: "
@@ -1101,6 +3589,38 @@ static PyMethodDef SimulatorMethods[] = {
                "stop_simulator() -> None\n"
                "Instruct the attached simulator to stop. Users should not call "
                "this function.")},
+    {"set_trace_enabled", set_trace_enabled, METH_VARARGS,
+     PyDoc_STR("set_trace_enabled(enabled, /)\n"
+               "--\n\n"
+               "set_trace_enabled(enabled: bool) -> None\n"
+               "Start or stop dumping waveforms to the trace of the "
+               "simulator.\n"
+               "\n"
+               "Only supported by Verilator simulations started with "
+               "``--trace``.\n"
+               "\n"
+               "Raises:\n"
+               "    RuntimeError: If the simulator cannot control its trace.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"save_checkpoint", save_checkpoint, METH_VARARGS,
+     PyDoc_STR("save_checkpoint(path, /)\n"
+               "--\n\n"
+               "save_checkpoint(path: str) -> None\n"
+               "Save a checkpoint of the state of the simulation to *path* at "
+               "the end of the current time step.\n"
+               "\n"
+               "Simulations started from the checkpoint continue at the saved "
+               "time, for\n"
+               "example to run many tests from the state after the reset of "
+               "the design.\n"
+               "Only supported by Verilator models verilated with "
+               "``--savable``.\n"
+               "\n"
+               "Raises:\n"
+               "    RuntimeError: If the simulator cannot save checkpoints.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
     {"log_level", log_level, METH_VARARGS,
      PyDoc_STR("log_level(level, /)\n"
                "--\n\n"
@@ -1121,6 +3641,13 @@ static PyMethodDef SimulatorMethods[] = {
                "\n"
                "Time is represented as a tuple of 32 bit integers ([low32, "
                "high32]) comprising a single 64 bit integer.")},
+    {"get_sim_steps", get_sim_steps, METH_NOARGS,
+     PyDoc_STR("get_sim_steps()\n"
+               "--\n\n"
+               "get_sim_steps() -> int\n"
+               "Get the current simulation time in simulator time steps.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
     {"get_precision", get_precision, METH_NOARGS,
      PyDoc_STR("get_precision()\n"
                "--\n\n"
@@ -1139,6 +3666,133 @@ static PyMethodDef SimulatorMethods[] = {
                "--\n\n"
                "get_simulator_version() -> str\n"
                "Get the simulator's product version string.")},
+    {"get_handle_store_stats", get_handle_store_stats, METH_NOARGS,
+     PyDoc_STR("get_handle_store_stats()\n"
+               "--\n\n"
+               "get_handle_store_stats() -> Dict[str, int]\n"
+               "Get statistics of the store of unique simulator object "
+               "handles.\n"
+               "\n"
+               "The returned dictionary has the keys ``handles``, "
+               "``capacity``, ``lookups``, ``hits`` and ``probes``.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"apply_queued_writes", apply_queued_writes, METH_NOARGS,
+     PyDoc_STR("apply_queued_writes()\n"
+               "--\n\n"
+               "apply_queued_writes() -> int\n"
+               "Apply the writes queued by the ``queue_signal_val_*`` methods "
+               "of :class:`gpi_sim_hdl`.\n"
+               "\n"
+               "Only the last write queued to each handle is applied, in the "
+               "order the writes were queued.\n"
+               "Returns the number of writes applied.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"clear_queued_writes", clear_queued_writes, METH_NOARGS,
+     PyDoc_STR("clear_queued_writes()\n"
+               "--\n\n"
+               "clear_queued_writes() -> None\n"
+               "Discard the queued writes.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"get_num_queued_writes", get_num_queued_writes, METH_NOARGS,
+     PyDoc_STR("get_num_queued_writes()\n"
+               "--\n\n"
+               "get_num_queued_writes() -> int\n"
+               "Get the number of queued writes.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"set_callback_batching", set_callback_batching, METH_VARARGS,
+     PyDoc_STR(
+         "set_callback_batching(function, handler, /)\n"
+         "--\n\n"
+         "set_callback_batching(function: Callable[[Any], None] | None, "
+         "handler: Callable[[List[Any]], None] | None) -> None\n"
+         "Coalesce value change callbacks delivered together.\n"
+         "\n"
+         "Value change callbacks registered with *function* and a single "
+         "argument that fire together within one simulator callback are "
+         "deferred, and *handler* is called once with the list of their "
+         "arguments instead. Pass ``None`` to disable batching.\n"
+         "\n"
+         ".. versionadded:: 2.0")},
+    {"get_stats", get_stats, METH_NOARGS,
+     PyDoc_STR("get_stats()\n"
+               "--\n\n"
+               "get_stats() -> Dict[str, Any]\n"
+               "Get statistics of the calls made through the GPI.\n"
+               "\n"
+               "The returned dictionary has the keys ``enabled``, "
+               "``value_gets``, ``value_sets``, ``handle_lookups``, "
+               "``native_lookups``, the names looked up in the simulator "
+               "rather than found in the lookup cache, ``iterations``, "
+               "``cb_registrations`` and ``cb_runs``, "
+               "the time spent in callbacks and in the simulator in "
+               "``user_ns`` and ``simulator_ns``, and ``cb_latency``, the "
+               "histogram of callback run times: element 0 counts those under "
+               "1 microsecond, element *i* those under ``2**i`` "
+               "microseconds, and the last one all longer ones.\n"
+               "\n"
+               "Statistics are only counted while enabled, see "
+               ":envvar:`GPI_STATS`.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"set_stats_enabled", set_stats_enabled, METH_VARARGS,
+     PyDoc_STR("set_stats_enabled(enabled, /)\n"
+               "--\n\n"
+               "set_stats_enabled(enabled: bool) -> None\n"
+               "Start or stop counting the statistics returned by "
+               ":func:`get_stats`.\n"
+               "\n"
+               "Starting resets them.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"is_profile_enabled", is_profile_enabled, METH_NOARGS,
+     PyDoc_STR("is_profile_enabled()\n"
+               "--\n\n"
+               "is_profile_enabled() -> bool\n"
+               "Whether the simulation is being profiled to the file set with "
+               ":envvar:`GPI_PROFILE_FILE`.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"profile_begin", profile_begin, METH_VARARGS,
+     PyDoc_STR("profile_begin(name, category, /)\n"
+               "--\n\n"
+               "profile_begin(name: str, category: str) -> None\n"
+               "Begin a slice of the profile, nested in the slices already "
+               "begun.\n"
+               "\n"
+               "Does nothing if :func:`is_profile_enabled` is ``False``.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"profile_end", profile_end, METH_NOARGS,
+     PyDoc_STR("profile_end()\n"
+               "--\n\n"
+               "profile_end() -> None\n"
+               "End the slice last begun with :func:`profile_begin`.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"get_cb_pool_stats", get_cb_pool_stats, METH_NOARGS,
+     PyDoc_STR("get_cb_pool_stats()\n"
+               "--\n\n"
+               "get_cb_pool_stats() -> Dict[str, int]\n"
+               "Get statistics of the pool recycling GPI callback objects.\n"
+               "\n"
+               "The returned dictionary has the keys ``allocations``, "
+               "``reused``, ``cached``, ``types`` and ``capacity``.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"set_cb_pool_capacity", set_cb_pool_capacity, METH_VARARGS,
+     PyDoc_STR("set_cb_pool_capacity(capacity, /)\n"
+               "--\n\n"
+               "set_cb_pool_capacity(capacity: int) -> None\n"
+               "Set how many freed GPI callback objects of each type are kept "
+               "for re-use.\n"
+               "\n"
+               "``0`` disables pooling.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
     {"clock_create", clock_create, METH_VARARGS,
      PyDoc_STR("clock_create(signal, /)\n"
                "--\n\n"
@@ -1147,6 +3801,46 @@ static PyMethodDef SimulatorMethods[] = {
                "Create a clock driver on a signal.\n"
                "\n"
                ".. versionadded:: 2.0")},
+    {"signal_group_create", signal_group_create, METH_VARARGS,
+     PyDoc_STR("signal_group_create(signals, /)\n"
+               "--\n\n"
+               "signal_group_create(signals: Sequence[cocotb.simulator."
+               "gpi_sim_hdl]) -> cocotb.simulator.GpiSignalGroup\n"
+               "Create a group of signals which are read and written "
+               "together.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"submit_work", submit_work, METH_VARARGS,
+     PyDoc_STR("submit_work(func, /)\n"
+               "--\n\n"
+               "submit_work(func: Callable[[], Any]) -> "
+               "cocotb.simulator.GpiWork\n"
+               "Call *func* on a thread of the GPI worker pool.\n"
+               "\n"
+               "*func* must not access the simulator. The pool is started on "
+               "the first call.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"get_num_worker_threads", get_num_worker_threads, METH_NOARGS,
+     PyDoc_STR("get_num_worker_threads()\n"
+               "--\n\n"
+               "get_num_worker_threads() -> int\n"
+               "Get the number of threads of the GPI worker pool, ``0`` if it "
+               "is not started.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"recorder_create", recorder_create, METH_VARARGS,
+     PyDoc_STR("recorder_create(signals, /)\n"
+               "--\n\n"
+               "recorder_create(signals: Sequence[cocotb.simulator."
+               "gpi_sim_hdl]) -> cocotb.simulator.GpiRecorder\n"
+               "Create a recorder of the value changes of signals, which is "
+               "started with :meth:`GpiRecorder.start`.\n"
+               "\n"
+               "Raises :exc:`TypeError` if a signal is not a logic signal "
+               "of known width.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
     {NULL, NULL, 0, NULL} /* Sentinel */
 };
 
@@ -1183,11 +3877,36 @@ PyMODINIT_FUNC PyInit_simulator(void) {
         return NULL;
         // LCOV_EXCL_STOP
     }
+    if (PyType_Ready(&gpi_hdl_Object<gpi_group_hdl>::py_type) < 0) {
+        // LCOV_EXCL_START
+        return NULL;
+        // LCOV_EXCL_STOP
+    }
+    if (PyType_Ready(&gpi_hdl_Object<gpi_rec_hdl>::py_type) < 0) {
+        // LCOV_EXCL_START
+        return NULL;
+        // LCOV_EXCL_STOP
+    }
+    if (PyType_Ready(&gpi_hdl_Object<gpi_accessor_hdl>::py_type) < 0) {
+        // LCOV_EXCL_START
+        return NULL;
+        // LCOV_EXCL_STOP
+    }
+    if (PyType_Ready(&gpi_hdl_Object<gpi_pywork_hdl>::py_type) < 0) {
+        // LCOV_EXCL_START
+        return NULL;
+        // LCOV_EXCL_STOP
+    }
 
     PyObject *simulator = PyModule_Create(&moduledef);
     if (simulator == NULL) {
         return NULL;
     }
+#ifdef Py_GIL_DISABLED
+    // Nothing here relies on the GIL, the entry points call check_sim_thread()
+    PyUnstable_Module_SetGIL(simulator, Py_MOD_GIL_NOT_USED);
+#endif
+    sim_thread_ident = PyThread_get_thread_ident();
 
     if (add_module_constants(simulator) < 0) {
         Py_DECREF(simulator);
@@ -1212,6 +3931,29 @@ PyMODINIT_FUNC PyInit_simulator(void) {
  */
 
 static PyMethodDef gpi_sim_hdl_methods[] = {
+    {"get_accessor", (PyCFunction)get_accessor, METH_VARARGS,
+     PyDoc_STR("get_accessor($self, format, /)\n"
+               "--\n\n"
+               "get_accessor(format: int) -> "
+               "cocotb.simulator.GpiValueAccessor\n"
+               "Get a callable reading the value of this object.\n"
+               "\n"
+               "*format* is one of :data:`ACCESS_INT`, which reads the packed "
+               "value of a logic object as an :class:`int`, or ``None`` if it "
+               "holds states other than ``0`` and ``1``, "
+               ":data:`ACCESS_LOGIC`, which reads it the same but returns "
+               "the binary string of the value if it holds other states, "
+               "reading the value only once where the simulator can pack "
+               "it, or "
+               ":data:`ACCESS_BINSTR`, :data:`ACCESS_LONG`, "
+               ":data:`ACCESS_REAL` and :data:`ACCESS_STR`, which read the "
+               "value as :meth:`get_signal_val_binstr`, "
+               ":meth:`get_signal_val_long`, :meth:`get_signal_val_real` and "
+               ":meth:`get_signal_val_str` do.\n"
+               "Calling the accessor is faster than calling those methods, "
+               "so it is worth keeping for values that are read often.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
     {"get_signal_val_long", (PyCFunction)get_signal_val_long, METH_NOARGS,
      PyDoc_STR("get_signal_val_long($self)\n"
                "--\n\n"
@@ -1228,32 +3970,141 @@ static PyMethodDef gpi_sim_hdl_methods[] = {
                "get_signal_val_binstr() -> str\n"
                "Get the value of a logic vector signal as a string of (``0``, "
                "``1``, ``X``, etc.), one element per character.")},
+    {"get_signal_val_bytes", (PyCFunction)get_signal_val_bytes, METH_NOARGS,
+     PyDoc_STR("get_signal_val_bytes($self)\n"
+               "--\n\n"
+               "get_signal_val_bytes() -> Optional[bytes]\n"
+               "Get the value of a logic vector signal as packed 4-state "
+               "bytes.\n"
+               "\n"
+               "The first half of the result holds the ``aval`` bits and the "
+               "second half the ``bval`` bits, each in little-endian order. "
+               "A bit is ``0`` for (0, 0), ``1`` for (1, 0), ``Z`` for (0, 1) "
+               "and ``X`` for (1, 1).\n"
+               "Returns ``None`` if the value holds other states.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"get_signal_val_bytes_into", (PyCFunction)get_signal_val_bytes_into,
+     METH_VARARGS,
+     PyDoc_STR("get_signal_val_bytes_into($self, buffer, /)\n"
+               "--\n\n"
+               "get_signal_val_bytes_into(buffer: bytearray) -> int\n"
+               "Like :meth:`get_signal_val_bytes`, but writes into a "
+               "writable buffer instead of allocating.\n"
+               "Returns the number of bits, or ``-1`` if the value holds "
+               "states other than ``0``, ``1``, ``X`` and ``Z``.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"get_array_val_bytes_into", (PyCFunction)get_array_val_bytes_into,
+     METH_VARARGS,
+     PyDoc_STR("get_array_val_bytes_into($self, first, count, buffer, /)\n"
+               "--\n\n"
+               "get_array_val_bytes_into(first: int, count: int, buffer: "
+               "bytearray) -> int\n"
+               "Read the *count* elements of an array of logic objects at "
+               "indices *first*, *first* + 1, ... into a writable buffer.\n"
+               "Each element takes the bytes returned by "
+               ":meth:`get_signal_val_bytes` for it, one after the other.\n"
+               "Returns the number of bits of each element, or ``-1`` if they "
+               "can't be read this way.\n"
+               "\n"
+               "This is much faster than reading the elements one by one, "
+               "e.g. to check the contents of a memory.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
     {"get_signal_val_real", (PyCFunction)get_signal_val_real, METH_NOARGS,
      PyDoc_STR("get_signal_val_real($self)\n"
                "--\n\n"
                "get_signal_val_real() -> float\n"
                "Get the value of a signal as a float.")},
-    {"set_signal_val_int", (PyCFunction)set_signal_val_int, METH_VARARGS,
+    {"set_signal_val_int", FASTCALL_METHOD(set_signal_val_int<false>),
      PyDoc_STR("set_signal_val_int($self, action, value, /)\n"
                "--\n\n"
                "set_signal_val_int(action: int, value: int) -> None\n"
                "Set the value of a signal using an int.")},
-    {"set_signal_val_str", (PyCFunction)set_signal_val_str, METH_VARARGS,
+    {"set_signal_val_str", FASTCALL_METHOD(set_signal_val_str<false>),
      PyDoc_STR("set_signal_val_str($self, action, value, /)\n"
                "--\n\n"
                "set_signal_val_str(action: int, value: bytes) -> None\n"
                "Set the value of a signal using a user-encoded string.")},
-    {"set_signal_val_binstr", (PyCFunction)set_signal_val_binstr, METH_VARARGS,
+    {"set_signal_val_binstr", FASTCALL_METHOD(set_signal_val_binstr<false>),
      PyDoc_STR("set_signal_val_binstr($self, action, value, /)\n"
                "--\n\n"
                "set_signal_val_binstr(action: int, value: str) -> None\n"
                "Set the value of a logic vector signal using a string of "
                "(``0``, ``1``, ``X``, etc.), one element per character.")},
-    {"set_signal_val_real", (PyCFunction)set_signal_val_real, METH_VARARGS,
+    {"set_signal_val_bytes", FASTCALL_METHOD(set_signal_val_bytes<false>),
+     PyDoc_STR("set_signal_val_bytes($self, action, width, value, /)\n"
+               "--\n\n"
+               "set_signal_val_bytes(action: int, width: int, "
+               "value: bytes | int) -> None\n"
+               "Set the value of a logic vector signal of *width* bits from "
+               "packed 4-state bytes, laid out as returned by "
+               ":meth:`get_signal_val_bytes`.\n"
+               "\n"
+               "*value* may be any object supporting the buffer protocol, "
+               "or an :class:`int` whose low *width* bits are written with "
+               "no ``X`` or ``Z`` bits.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"set_array_val_bytes", (PyCFunction)set_array_val_bytes, METH_VARARGS,
+     PyDoc_STR("set_array_val_bytes($self, action, first, count, values, /)\n"
+               "--\n\n"
+               "set_array_val_bytes(action: int, first: int, count: int, "
+               "values: bytes) -> None\n"
+               "Write the *count* elements of an array of logic objects at "
+               "indices *first*, *first* + 1, ... from packed 4-state bytes, "
+               "laid out as read by :meth:`get_array_val_bytes_into`.\n"
+               "\n"
+               "*values* may be any object supporting the buffer protocol.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"set_signal_val_real", FASTCALL_METHOD(set_signal_val_real<false>),
      PyDoc_STR("set_signal_val_real($self, action, value, /)\n"
                "--\n\n"
                "set_signal_val_real(action: int, value: float) -> None\n"
                "Set the value of a signal using a float.")},
+    {"queue_signal_val_int", FASTCALL_METHOD(set_signal_val_int<true>),
+     PyDoc_STR("queue_signal_val_int($self, action, value, /)\n"
+               "--\n\n"
+               "queue_signal_val_int(action: int, value: int) -> None\n"
+               "Queue a write as :meth:`set_signal_val_int`, replacing any "
+               "write queued for this handle.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"queue_signal_val_str", FASTCALL_METHOD(set_signal_val_str<true>),
+     PyDoc_STR("queue_signal_val_str($self, action, value, /)\n"
+               "--\n\n"
+               "queue_signal_val_str(action: int, value: bytes) -> None\n"
+               "Queue a write as :meth:`set_signal_val_str`, replacing any "
+               "write queued for this handle.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"queue_signal_val_binstr", FASTCALL_METHOD(set_signal_val_binstr<true>),
+     PyDoc_STR("queue_signal_val_binstr($self, action, value, /)\n"
+               "--\n\n"
+               "queue_signal_val_binstr(action: int, value: str) -> None\n"
+               "Queue a write as :meth:`set_signal_val_binstr`, replacing any "
+               "write queued for this handle.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"queue_signal_val_bytes", FASTCALL_METHOD(set_signal_val_bytes<true>),
+     PyDoc_STR("queue_signal_val_bytes($self, action, width, value, /)\n"
+               "--\n\n"
+               "queue_signal_val_bytes(action: int, width: int, "
+               "value: bytes | int) -> None\n"
+               "Queue a write as :meth:`set_signal_val_bytes`, replacing any "
+               "write queued for this handle.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"queue_signal_val_real", FASTCALL_METHOD(set_signal_val_real<true>),
+     PyDoc_STR("queue_signal_val_real($self, action, value, /)\n"
+               "--\n\n"
+               "queue_signal_val_real(action: int, value: float) -> None\n"
+               "Queue a write as :meth:`set_signal_val_real`, replacing any "
+               "write queued for this handle.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
     {"get_definition_name", (PyCFunction)get_definition_name, METH_NOARGS,
      PyDoc_STR("get_definition_name($self)\n"
                "--\n\n"
@@ -1313,6 +4164,34 @@ static PyMethodDef gpi_sim_hdl_methods[] = {
                "--\n\n"
                "get_indexable() -> bool\n"
                "Return ``True`` if indexable.")},
+    {"load_array_from_file", (PyCFunction)load_array_from_file, METH_VARARGS,
+     PyDoc_STR("load_array_from_file($self, action, path, offset, first, "
+               "count, /)\n"
+               "--\n\n"
+               "load_array_from_file(action: int, path: str | os.PathLike, "
+               "offset: int, first: int, count: int) -> None\n"
+               "Load *count* elements of an array of logic objects, starting "
+               "at index *first*, from a raw image *offset* bytes into the "
+               "file at *path*.\n"
+               "Each element is stored in the smallest whole number of bytes, "
+               "least significant byte first.\n"
+               "\n"
+               "The file is mapped and streamed into the array without "
+               "creating Python objects for its contents, e.g. to preload a "
+               "ROM or DRAM model.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {"dump_array_to_file", (PyCFunction)dump_array_to_file, METH_VARARGS,
+     PyDoc_STR("dump_array_to_file($self, path, first, count, /)\n"
+               "--\n\n"
+               "dump_array_to_file(path: str | os.PathLike, first: int, "
+               "count: int) -> None\n"
+               "Write *count* elements of an array of logic objects, starting "
+               "at index *first*, to the file at *path* as a raw image laid "
+               "out as read by :meth:`load_array_from_file`.\n"
+               "X and Z bits are written as ``0``.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
     {"iterate", (PyCFunction)iterate, METH_VARARGS,
      PyDoc_STR(
          "iterate($self, mode, /)\n"
@@ -1336,6 +4215,27 @@ PyTypeObject gpi_hdl_Object<gpi_sim_hdl>::py_type = []() -> PyTypeObject {
     return type;
 }();
 
+static PyMethodDef gpi_iterator_hdl_methods[] = {
+    {"next_names", (PyCFunction)next_names, METH_VARARGS,
+     PyDoc_STR("next_names($self, count, /)\n"
+               "--\n\n"
+               "next_names(count: int) -> list[tuple[str, int]]\n"
+               "Get the names and types of up to *count* next objects, without "
+               "creating their handles.\n"
+               "\n"
+               "The handles can be created later with "
+               ":meth:`gpi_sim_hdl.get_handle_by_name` on the iterated "
+               "object.\n"
+               "The type is :data:`UNKNOWN` if it is not known without "
+               "creating the handle, and the same name can be returned more "
+               "than once.\n"
+               "Fewer than *count* objects are returned once the iterator is "
+               "exhausted, after which it must not be used again.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
+    {NULL, NULL, 0, NULL} /* Sentinel */
+};
+
 template <>
 PyTypeObject gpi_hdl_Object<gpi_iterator_hdl>::py_type = []() -> PyTypeObject {
     auto type = fill_common_slots<gpi_iterator_hdl>();
@@ -1343,6 +4243,7 @@ PyTypeObject gpi_hdl_Object<gpi_iterator_hdl>::py_type = []() -> PyTypeObject {
     type.tp_doc = "GPI iterator handle.";
     type.tp_iter = PyObject_SelfIter;
     type.tp_iternext = (iternextfunc)next;
+    type.tp_methods = gpi_iterator_hdl_methods;
     return type;
 }();
 
@@ -1352,6 +4253,20 @@ static PyMethodDef gpi_cb_hdl_methods[] = {
                "--\n\n"
                "deregister() -> None\n"
                "De-register this callback.")},
+    {"get_value_bytes", (PyCFunction)get_value_bytes, METH_NOARGS,
+     PyDoc_STR("get_value_bytes($self)\n"
+               "--\n\n"
+               "get_value_bytes() -> bytes | None\n"
+               "Get the value a value change callback was delivered with.\n"
+               "\n"
+               "The value is packed as by "
+               ":meth:`gpi_sim_hdl.get_signal_val_bytes`.\n"
+               "Only valid while the callback function runs. Returns ``None`` "
+               "if the simulator\n"
+               "did not deliver a value, in which case the signal has to be "
+               "read instead.\n"
+               "\n"
+               ".. versionadded:: 2.0")},
     {NULL, NULL, 0, NULL} /* Sentinel */
 };
 
@@ -1367,9 +4282,10 @@ PyTypeObject gpi_hdl_Object<gpi_cb_hdl>::py_type = []() -> PyTypeObject {
 static PyMethodDef gpi_clk_methods[] = {
     {"start", (PyCFunction)clk_start, METH_VARARGS,
      PyDoc_STR(
-         "start($self, period_steps, high_steps, start_high)\n"
+         "start($self, period_steps, high_steps, start_high, cycles=0)\n"
          "--\n\n"
-         "start(period_steps: int, high_steps: int, start_high: bool) -> None\n"
+         "start(period_steps: int, high_steps: int, start_high: bool, "
+         "cycles: int = 0) -> None\n"
          "Start this clock now.\n"
          "\n"
          "The clock will have a period of *period_steps* time steps, "
@@ -1377,6 +4293,14 @@ static PyMethodDef gpi_clk_methods[] = {
          "If *start_high* is ``True``, start at the beginning of the high "
          "state, "
          "otherwise start at the beginning of the low state.\n"
+         "If *cycles* is nonzero, the clock stops by itself after that many "
+         "periods, at its starting value.\n"
+         "\n"
+         "All running clocks share a single timed callback which is re-armed "
+         "after each edge.\n"
+         "\n"
+         ".. versionchanged:: 2.0\n"
+         "    Added the *cycles* argument.\n"
          "\n"
          "Raises:\n"
          "    TypeError: If there are an incorrect number of arguments or "
@@ -1404,3 +4328,157 @@ PyTypeObject gpi_hdl_Object<gpi_clk_hdl>::py_type = []() -> PyTypeObject {
     type.tp_dealloc = clock_dealloc;
     return type;
 }();
+
+static PyMethodDef gpi_group_methods[] = {
+    {"read_int_into", (PyCFunction)group_read_int_into, METH_VARARGS,
+     PyDoc_STR("read_int_into($self, buffer, /)\n"
+               "--\n\n"
+               "read_int_into(buffer: array.array) -> None\n"
+               "Read the value of every signal as an integer into *buffer*, "
+               "which holds one native 64-bit integer per signal, such as an "
+               "``array.array('q')``.")},
+    {"write_int", (PyCFunction)group_write_int, METH_VARARGS,
+     PyDoc_STR("write_int($self, action, buffer, /)\n"
+               "--\n\n"
+               "write_int(action: int, buffer: array.array) -> None\n"
+               "Write every signal from *buffer*, laid out as for "
+               ":meth:`read_int_into`.\n"
+               "\n"
+               "Raises:\n"
+               "    OverflowError: If a value does not fit in 32 bits. No "
+               "signal is written in that case.")},
+    {"read_bytes_into", (PyCFunction)group_read_bytes_into, METH_VARARGS,
+     PyDoc_STR("read_bytes_into($self, buffer, /)\n"
+               "--\n\n"
+               "read_bytes_into(buffer: bytearray) -> None\n"
+               "Read the packed value of every signal into *buffer*, one "
+               "after the other, each laid out as returned by "
+               ":meth:`gpi_sim_hdl.get_signal_val_bytes`.\n"
+               "\n"
+               "States other than ``0``, ``1``, ``X`` and ``Z`` are read as "
+               "``X``.")},
+    {"write_bytes", (PyCFunction)group_write_bytes, METH_VARARGS,
+     PyDoc_STR("write_bytes($self, action, buffer, /)\n"
+               "--\n\n"
+               "write_bytes(action: int, buffer: bytes) -> None\n"
+               "Write every signal from *buffer*, laid out as for "
+               ":meth:`read_bytes_into`.")},
+    {"get_num_signals", (PyCFunction)group_get_num_signals, METH_NOARGS,
+     PyDoc_STR("get_num_signals($self)\n"
+               "--\n\n"
+               "get_num_signals() -> int\n"
+               "Get the number of signals in the group.")},
+    {"get_packed_size", (PyCFunction)group_get_packed_size, METH_NOARGS,
+     PyDoc_STR("get_packed_size($self)\n"
+               "--\n\n"
+               "get_packed_size() -> int\n"
+               "Get the size in bytes of the buffer used by "
+               ":meth:`read_bytes_into` and :meth:`write_bytes`, or ``-1`` "
+               "if not all signals have packed values.")},
+    {NULL, NULL, 0, NULL} /* Sentinel */
+};
+
+template <>
+PyTypeObject gpi_hdl_Object<gpi_group_hdl>::py_type = []() -> PyTypeObject {
+    auto type = fill_common_slots<gpi_group_hdl>();
+    type.tp_name = "cocotb.simulator.GpiSignalGroup";
+    type.tp_doc = "Group of signals read and written together using the GPI.";
+    type.tp_methods = gpi_group_methods;
+    type.tp_dealloc = signal_group_dealloc;
+    return type;
+}();
+
+static PyMethodDef gpi_rec_methods[] = {
+    {"start", (PyCFunction)recorder_start, METH_NOARGS,
+     PyDoc_STR("start($self)\n"
+               "--\n\n"
+               "start() -> None\n"
+               "Record the current value of every signal, then each change "
+               "of value until :meth:`stop` is called.")},
+    {"stop", (PyCFunction)recorder_stop, METH_NOARGS,
+     PyDoc_STR("stop($self)\n"
+               "--\n\n"
+               "stop() -> None\n"
+               "Stop recording. The records are kept.")},
+    {"query", (PyCFunction)recorder_query, METH_VARARGS,
+     PyDoc_STR("query($self, start, end, /)\n"
+               "--\n\n"
+               "query(start: int, end: int) -> Tuple[bytes, bytes, bytes]\n"
+               "Get the records from simulation time *start* up to but not "
+               "including *end*, as ``(times, ids, values)`` columns.\n"
+               "\n"
+               "*times* holds a 64-bit unsigned time per record, *ids* a "
+               "32-bit unsigned index of the signal in the recorder, and "
+               "*values* :meth:`get_value_words` pairs of 32-bit unsigned "
+               "``aval``, ``bval`` words per record, least significant word "
+               "first, in native byte order. "
+               "They can be viewed with e.g. ``numpy.frombuffer``.")},
+    {"drain", (PyCFunction)recorder_drain, METH_NOARGS,
+     PyDoc_STR("drain($self)\n"
+               "--\n\n"
+               "drain() -> Tuple[bytes, bytes, bytes]\n"
+               "Get all records, laid out as for :meth:`query`, and remove "
+               "them from the recorder.")},
+    {"get_num_records", (PyCFunction)recorder_get_num_records, METH_NOARGS,
+     PyDoc_STR("get_num_records($self)\n"
+               "--\n\n"
+               "get_num_records() -> int\n"
+               "Get the number of records held.")},
+    {"get_num_signals", (PyCFunction)recorder_get_num_signals, METH_NOARGS,
+     PyDoc_STR("get_num_signals($self)\n"
+               "--\n\n"
+               "get_num_signals() -> int\n"
+               "Get the number of signals recorded.")},
+    {"get_value_words", (PyCFunction)recorder_get_value_words, METH_NOARGS,
+     PyDoc_STR("get_value_words($self)\n"
+               "--\n\n"
+               "get_value_words() -> int\n"
+               "Get the number of 32-bit words of each recorded value, enough "
+               "for the widest signal.")},
+    {NULL, NULL, 0, NULL} /* Sentinel */
+};
+
+template <>
+PyTypeObject gpi_hdl_Object<gpi_rec_hdl>::py_type = []() -> PyTypeObject {
+    auto type = fill_common_slots<gpi_rec_hdl>();
+    type.tp_name = "cocotb.simulator.GpiRecorder";
+    type.tp_doc = "Recorder of the value changes of signals using the GPI.";
+    type.tp_methods = gpi_rec_methods;
+    type.tp_dealloc = recorder_dealloc;
+    return type;
+}();
+
+template <>
+PyTypeObject gpi_hdl_Object<gpi_accessor_hdl>::py_type = []() -> PyTypeObject {
+    auto type = fill_common_slots<gpi_accessor_hdl>();
+    type.tp_name = "cocotb.simulator.GpiValueAccessor";
+    type.tp_doc = "Reader of the value of a GPI object in a fixed format.";
+    type.tp_call = (ternaryfunc)accessor_call;
+    type.tp_dealloc = accessor_dealloc;
+    return type;
+}();
+
+static PyMethodDef gpi_pywork_methods[] = {
+    {"done", (PyCFunction)pywork_done, METH_NOARGS,
+     PyDoc_STR("done($self)\n"
+               "--\n\n"
+               "done() -> bool\n"
+               "Get whether the function has returned.")},
+    {"result", (PyCFunction)pywork_result, METH_NOARGS,
+     PyDoc_STR("result($self)\n"
+               "--\n\n"
+               "result() -> Any\n"
+               "Wait for the function to return and get its result, or raise "
+               "the exception it raised.")},
+    {NULL, NULL, 0, NULL} /* Sentinel */
+};
+
+template <>
+PyTypeObject gpi_hdl_Object<gpi_pywork_hdl>::py_type = []() -> PyTypeObject {
+    auto type = fill_common_slots<gpi_pywork_hdl>();
+    type.tp_name = "cocotb.simulator.GpiWork";
+    type.tp_doc = "Python function run on the GPI worker pool.";
+    type.tp_methods = gpi_pywork_methods;
+    type.tp_dealloc = pywork_dealloc;
+    return type;
+}();
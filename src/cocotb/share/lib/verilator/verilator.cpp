@@ -4,12 +4,15 @@
 
 #include <libgen.h>  // basename
 #include <stdio.h>   // stderr, fprintf
+#include <stdlib.h>  // strtoul, strtoull
+#include <string.h>  // strrchr
 
 #include <memory>  // std::unique_ptr
 #include <string>  // std::string
 
 #include "Vtop.h"
 #include "verilated.h"
+#include "verilated_syms.h"
 #include "verilated_vpi.h"
 
 #ifndef VM_TRACE_FST
@@ -25,6 +28,11 @@
 #endif
 #endif
 
+// Set by the cocotb makefile for models verilated with --savable
+#ifdef COCOTB_VERILATOR_SAVABLE
+#include <verilated_save.h>
+#endif
+
 static vluint64_t main_time = 0;  // Current simulation time
 
 double sc_time_stamp() {  // Called by $time in Verilog
@@ -34,11 +42,32 @@ double sc_time_stamp() {  // Called by $time in Verilog
 
 extern "C" {
 void vlog_startup_routines_bootstrap(void);
+unsigned int cocotbvpi_armed_callbacks(PLI_INT32 reason);
+void cocotbvpi_set_trace_state(int state);
+int cocotbvpi_trace_state(void);
+void cocotbvpi_set_checkpoints_supported(void);
+const char* cocotbvpi_take_checkpoint_request(void);
+void cocotbvpi_set_direct_lookup(void* (*lookup)(const char*, int*, int*,
+                                                 int*));
+void cocotbvpi_apply_direct_writes(void);
+int cocotbvpi_take_direct_writes(void);
+}
+
+// When set, every region is run on every time step, even if cocotb has no
+// callbacks registered for it
+static bool all_regions = false;
+
+static inline bool region_armed(PLI_INT32 reason) {
+    return all_regions || cocotbvpi_armed_callbacks(reason) != 0;
 }
 
 static inline bool settle_value_callbacks() {
     bool cbs_called, again;
 
+    if (!region_armed(cbValueChange)) {
+        return false;
+    }
+
     // Call Value Change callbacks
     // These can modify signal values so we loop
     // until there are no more changes
@@ -52,8 +81,119 @@ static inline bool settle_value_callbacks() {
 
 static void clean_exit_cb(void*) { VerilatedVpi::callCbs(cbEndOfSimulation); }
 
+// Finds a public variable of the model for cocotb to access in place, rather
+// than through VerilatedVpi, the same way vpi_handle_by_name() does
+static void* direct_lookup(const char* fq_name, int* n_bits, int* unit,
+                           int* writable) {
+    const char* dot = strrchr(fq_name, '.');
+    if (!dot) {
+        return NULL;
+    }
+    std::string scope_name(fq_name, static_cast<size_t>(dot - fq_name));
+    const char* var_name = dot + 1;
+
+    const VerilatedContext* contextp = Verilated::threadContextp();
+    const VerilatedVar* varp = NULL;
+    // Ports of the toplevel are in the TOP scope
+    if (scope_name.find('.') == std::string::npos) {
+        if (const VerilatedScope* scopep = contextp->scopeFind("TOP")) {
+            varp = scopep->varFind(var_name);
+        }
+    }
+    if (!varp) {
+        if (const VerilatedScope* scopep =
+                contextp->scopeFind(scope_name.c_str())) {
+            varp = scopep->varFind(var_name);
+        }
+    }
+    // Unpacked arrays are left to VPI
+    if (!varp || varp->udims() != 0) {
+        return NULL;
+    }
+
+    switch (varp->vltype()) {
+        case VLVT_UINT8:
+            *unit = 1;
+            break;
+        case VLVT_UINT16:
+            *unit = 2;
+            break;
+        case VLVT_UINT32:
+        case VLVT_WDATA:
+            *unit = 4;
+            break;
+        case VLVT_UINT64:
+            *unit = 8;
+            break;
+        default:
+            return NULL;
+    }
+    *n_bits = varp->packed().elements();
+    *writable = varp->isPublicRW();
+    return varp->datap();
+}
+
+// Applies the values put by cocotb through VPI and directly
+static inline void do_puts() {
+    VerilatedVpi::doInertialPuts();
+    cocotbvpi_apply_direct_writes();
+}
+
+static inline void clear_eval_needed() {
+    VerilatedVpi::clearEvalNeeded();
+    cocotbvpi_take_direct_writes();
+}
+
+static inline bool eval_needed() {
+    // Always taken, as it's cleared along with evalNeeded()
+    bool direct = cocotbvpi_take_direct_writes() != 0;
+    return VerilatedVpi::evalNeeded() || direct;
+}
+
+static bool parse_time(const char* str, vluint64_t* time) {
+    char* end = NULL;
+    *time = static_cast<vluint64_t>(strtoull(str, &end, 10));
+    return end != str && *end == '\0';
+}
+
+#ifdef COCOTB_VERILATOR_SAVABLE
+// The simulation time is not part of the model, so is saved with it
+static void save_checkpoint(Vtop* top, const char* path) {
+    VerilatedSave os;
+    os.open(path);
+    if (!os.isOpen()) {
+        fprintf(stderr, "Error: Unable to save checkpoint %s\n", path);
+        return;
+    }
+    os << main_time;
+    os << *top;
+    os.close();
+}
+
+static bool restore_checkpoint(Vtop* top, const char* path) {
+    VerilatedRestore os;
+    os.open(path);
+    if (!os.isOpen()) {
+        return false;
+    }
+    os >> main_time;
+    os >> *top;
+    os.close();
+    return true;
+}
+#endif
+
 int main(int argc, char** argv) {
     bool traceOn = false;
+    bool directAccess = true;
+    unsigned threads = 0;
+    // Window of simulation time in which the trace is dumped, the end is
+    // exclusive and 0 means the end of the simulation
+    vluint64_t traceStart = 0;
+    vluint64_t traceStop = 0;
+#ifdef COCOTB_VERILATOR_SAVABLE
+    const char* restoreFile = NULL;
+#endif
 #if VM_TRACE_FST
     const char* traceFile = "dump.fst";
 #else
@@ -64,6 +204,28 @@ int main(int argc, char** argv) {
         std::string arg = std::string(argv[i]);
         if (arg == "--trace") {
             traceOn = true;
+        } else if (arg == "--all-regions") {
+            all_regions = true;
+        } else if (arg == "--no-direct-access") {
+            directAccess = false;
+        } else if (arg == "--threads") {
+            char* end = NULL;
+            if (++i < argc) {
+                threads = static_cast<unsigned>(strtoul(argv[i], &end, 10));
+            }
+            if (!end || *end != '\0' || threads == 0) {
+                fprintf(stderr,
+                        "Error: --threads requires a positive integer\n");
+                return -1;
+            }
+        } else if (arg == "--trace-start" || arg == "--trace-stop") {
+            vluint64_t* time =
+                arg == "--trace-start" ? &traceStart : &traceStop;
+            if (++i >= argc || !parse_time(argv[i], time)) {
+                fprintf(stderr, "Error: %s requires a simulation time\n",
+                        arg.c_str());
+                return -1;
+            }
         } else if (arg == "--trace-file") {
             if (++i < argc) {
                 traceFile = argv[i];
@@ -71,32 +233,92 @@ int main(int argc, char** argv) {
                 fprintf(stderr, "Error: --trace-file requires a parameter\n");
                 return -1;
             }
+        } else if (arg == "--restore") {
+#ifdef COCOTB_VERILATOR_SAVABLE
+            if (++i < argc) {
+                restoreFile = argv[i];
+            } else {
+                fprintf(stderr, "Error: --restore requires a parameter\n");
+                return -1;
+            }
+#else
+            fprintf(stderr,
+                    "Error: --restore requires a model verilated with "
+                    "--savable\n");
+            return -1;
+#endif
         } else if (arg == "--help") {
             fprintf(stderr,
-                    "usage: %s [--trace] [--trace-file TRACEFILE]\n"
+                    "usage: %s [--trace] [--trace-file TRACEFILE] "
+                    "[--trace-start TIME] [--trace-stop TIME] "
+                    "[--all-regions] [--no-direct-access] "
+                    "[--threads THREADS] [--restore CHECKPOINT]\n"
                     "\n"
                     "Cocotb + Verilator sim\n"
                     "\n"
                     "options:\n"
-                    "  --trace      Enables tracing (VCD or FST)\n"
-                    "  --trace-file Specifies the trace file name (%s by "
-                    "default)\n",
+                    "  --trace       Enables tracing (VCD or FST)\n"
+                    "  --trace-file  Specifies the trace file name (%s by "
+                    "default)\n"
+                    "  --trace-start Starts dumping the trace at TIME, in "
+                    "simulation steps\n"
+                    "  --trace-stop  Stops dumping the trace at TIME, in "
+                    "simulation steps\n"
+                    "  --all-regions Runs every VPI region on every time "
+                    "step, for\n"
+                    "                VPI libraries other than cocotb's\n"
+                    "  --no-direct-access\n"
+                    "                Accesses the signals through VPI, rather "
+                    "than in place\n"
+                    "                in the model\n"
+                    "  --threads     Number of threads evaluating the model, "
+                    "which must be\n"
+                    "                verilated with at least as many "
+                    "--threads\n"
+                    "  --restore     Starts from a checkpoint saved by "
+                    "cocotb, which must\n"
+                    "                be verilated with --savable\n",
                     basename(argv[0]), traceFile);
             return 0;
         }
     }
 
-    Verilated::commandArgs(argc, argv);
+    std::unique_ptr<VerilatedContext> contextp(new VerilatedContext);
+    // VPI calls made by cocotb look up the context of the calling thread
+    Verilated::threadContextp(contextp.get());
+    contextp->commandArgs(argc, argv);
+    if (threads) {
+        // Must be set before the model is constructed
+        contextp->threads(threads);
+    }
 #ifdef VERILATOR_SIM_DEBUG
     Verilated::debug(99);
 #endif
-    std::unique_ptr<Vtop> top(new Vtop(""));
-    Verilated::fatalOnVpiError(false);  // otherwise it will fail on systemtf
+    std::unique_ptr<Vtop> top(new Vtop(contextp.get(), ""));
+    contextp->fatalOnVpiError(false);  // otherwise it will fail on systemtf
 
 #ifdef VERILATOR_SIM_DEBUG
-    Verilated::internalsDump();
+    contextp->internalsDump();
+#endif
+
+#ifdef COCOTB_VERILATOR_SAVABLE
+    // Restored before cocotb starts, so it starts at the time of the
+    // checkpoint
+    if (restoreFile) {
+        if (!restore_checkpoint(top.get(), restoreFile)) {
+            fprintf(stderr, "Error: Unable to restore checkpoint %s\n",
+                    restoreFile);
+            return -1;
+        }
+        contextp->time(main_time);
+    }
+    cocotbvpi_set_checkpoints_supported();
 #endif
 
+    if (directAccess) {
+        // Before cocotb creates any handle
+        cocotbvpi_set_direct_lookup(direct_lookup);
+    }
     vlog_startup_routines_bootstrap();
     Verilated::addExitCb(clean_exit_cb, NULL);
     VerilatedVpi::callCbs(cbStartOfSimulation);
@@ -110,37 +332,71 @@ int main(int argc, char** argv) {
 #endif
 
     if (traceOn) {
-        Verilated::traceEverOn(true);
+        contextp->traceEverOn(true);
         top->trace(tfp.get(), 99);
         tfp->open(traceFile);
+        // Dumping can be started and stopped from cocotb through this
+        // state, see gpi_set_trace_enabled()
+        cocotbvpi_set_trace_state(traceStart == 0);
     }
+    bool traceDumping = false;
 #endif
 
-    while (!Verilated::gotFinish()) {
+    while (!contextp->gotFinish()) {
         do {
             // We must evaluate whole design until we process all 'events' for
-            // this time step
+            // this time step.
+            // A multithreaded model runs its eval on the worker threads of
+            // the context, but eval_step() only returns once they are all
+            // done, so the VPI callbacks below are always run serialized on
+            // this thread.
             do {
                 top->eval_step();
-                VerilatedVpi::clearEvalNeeded();
-                VerilatedVpi::doInertialPuts();
+                clear_eval_needed();
+                do_puts();
                 settle_value_callbacks();
-            } while (VerilatedVpi::evalNeeded());
+            } while (eval_needed());
 
             // Run ReadWrite callback as we are done processing this eval step
-            VerilatedVpi::callCbs(cbReadWriteSynch);
-            VerilatedVpi::doInertialPuts();
-            settle_value_callbacks();
-        } while (VerilatedVpi::evalNeeded());
+            if (region_armed(cbReadWriteSynch)) {
+                VerilatedVpi::callCbs(cbReadWriteSynch);
+                do_puts();
+                settle_value_callbacks();
+            }
+        } while (eval_needed());
 
         top->eval_end_step();
 
         // Call ReadOnly callbacks
-        VerilatedVpi::callCbs(cbReadOnlySynch);
+        if (region_armed(cbReadOnlySynch)) {
+            VerilatedVpi::callCbs(cbReadOnlySynch);
+        }
 
 #if VM_TRACE
         if (traceOn) {
-            tfp->dump(main_time);
+            if (traceStart != 0 && main_time >= traceStart) {
+                cocotbvpi_set_trace_state(1);
+                traceStart = 0;
+            }
+            if (traceStop != 0 && main_time >= traceStop) {
+                cocotbvpi_set_trace_state(0);
+                traceStop = 0;
+            }
+            bool dump = cocotbvpi_trace_state() > 0;
+            if (dump) {
+                tfp->dump(main_time);
+            } else if (traceDumping) {
+                // Make everything dumped so far available while paused
+                tfp->flush();
+            }
+            traceDumping = dump;
+        }
+#endif
+
+#ifdef COCOTB_VERILATOR_SAVABLE
+        // Saved once the time step is done, see gpi_save_checkpoint()
+        if (const char* path = cocotbvpi_take_checkpoint_request()) {
+            save_checkpoint(top.get(), path);
         }
 #endif
         // cocotb controls the clock inputs using cbAfterDelay so
@@ -157,13 +413,16 @@ int main(int argc, char** argv) {
             break;
         } else {
             main_time = next_time;
+            contextp->time(main_time);
         }
 
         // Call registered NextSimTime
         // It should be called in simulation cycle before everything else
         // but not on first cycle
-        VerilatedVpi::callCbs(cbNextSimTime);
-        settle_value_callbacks();
+        if (region_armed(cbNextSimTime)) {
+            VerilatedVpi::callCbs(cbNextSimTime);
+            settle_value_callbacks();
+        }
 
         // Call registered timed callbacks (e.g. clock timer)
         // These are called at the beginning of the time step
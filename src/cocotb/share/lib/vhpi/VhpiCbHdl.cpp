@@ -66,8 +66,6 @@ VhpiSignalObjHdl::~VhpiSignalObjHdl() {
             break;
     }
 
-    if (m_binvalue.value.str) delete[] m_binvalue.value.str;
-
     LOG_DEBUG("VHPI: Releasing VhpiSignalObjHdl handle for %s at %p",
               get_fullname_str(), (void *)get_handle<vhpiHandleT>());
     if (vhpi_release_handle(get_handle<vhpiHandleT>())) check_vhpi_error();
@@ -277,10 +275,10 @@ int VhpiObjHdl::initialise(const std::string &name,
             if (pu_handle != NULL) {
                 const char *str;
                 str = vhpi_get_str(vhpiNameP, pu_handle);
-                if (str != NULL) m_definition_name = str;
+                if (str != NULL) m_definition_name = gpi_intern_string(str);
 
                 str = vhpi_get_str(vhpiFileNameP, pu_handle);
-                if (str != NULL) m_definition_file = str;
+                if (str != NULL) m_definition_file = gpi_intern_string(str);
             }
         }
     }
@@ -295,12 +293,6 @@ int VhpiSignalObjHdl::initialise(const std::string &name,
     m_value.bufSize = 0;
     m_value.value.str = NULL;
     m_value.numElems = 0;
-    /* We also alloc a second value member for use with read string operations
-     */
-    m_binvalue.format = vhpiBinStrVal;
-    m_binvalue.bufSize = 0;
-    m_binvalue.numElems = 0;
-    m_binvalue.value.str = NULL;
 
     vhpiHandleT handle = GpiObjHdl::get_handle<vhpiHandleT>();
 
@@ -356,12 +348,6 @@ int VhpiSignalObjHdl::initialise(const std::string &name,
         m_indexable = false;
     }
 
-    if (m_num_elems) {
-        int bufSize = m_num_elems * static_cast<int>(sizeof(vhpiCharT)) + 1;
-        m_binvalue.bufSize = static_cast<bufSize_type>(bufSize);
-        m_binvalue.value.str = new vhpiCharT[bufSize];
-    }
-
     return GpiObjHdl::initialise(name, fq_name);
 }
 
@@ -372,12 +358,6 @@ int VhpiLogicSignalObjHdl::initialise(const std::string &name,
     m_value.bufSize = 0;
     m_value.value.str = NULL;
     m_value.numElems = 0;
-    /* We also alloc a second value member for use with read string operations
-     */
-    m_binvalue.format = vhpiBinStrVal;
-    m_binvalue.bufSize = 0;
-    m_binvalue.numElems = 0;
-    m_binvalue.value.str = NULL;
 
     vhpiHandleT handle = GpiObjHdl::get_handle<vhpiHandleT>();
     vhpiHandleT base_hdl = vhpi_handle(vhpiBaseType, handle);
@@ -396,7 +376,7 @@ int VhpiLogicSignalObjHdl::initialise(const std::string &name,
     m_num_elems = static_cast<int>(vhpi_get(vhpiSizeP, handle));
 
     if (m_num_elems == 0) {
-        LOG_DEBUG("VHPI: Null vector... Delete object")
+        LOG_DEBUG("VHPI: Null vector... Delete object");
         return -1;
     }
 
@@ -405,7 +385,7 @@ int VhpiLogicSignalObjHdl::initialise(const std::string &name,
         m_value.format = vhpiLogicVecVal;
         int bufSize = m_num_elems * static_cast<int>(sizeof(vhpiEnumT));
         m_value.bufSize = static_cast<bufSize_type>(bufSize);
-        m_value.value.enumvs = new vhpiEnumT[bufSize];
+        m_value.value.enumvs = new vhpiEnumT[m_num_elems];
     }
 
     if (m_indexable &&
@@ -413,12 +393,6 @@ int VhpiLogicSignalObjHdl::initialise(const std::string &name,
         m_indexable = false;
     }
 
-    if (m_num_elems) {
-        int bufSize = m_num_elems * static_cast<int>(sizeof(vhpiCharT)) + 1;
-        m_binvalue.bufSize = static_cast<bufSize_type>(bufSize);
-        m_binvalue.value.str = new vhpiCharT[bufSize];
-    }
-
     return GpiObjHdl::initialise(name, fq_name);
 }
 
@@ -613,6 +587,101 @@ int VhpiLogicSignalObjHdl::set_signal_value_binstr(std::string &value,
     return 0;
 }
 
+int VhpiLogicSignalObjHdl::set_signal_value_vector(const gpi_vecval_t *buf,
+                                                   int n_bits,
+                                                   gpi_set_action_t action) {
+    if (n_bits != m_num_elems) {
+        LOG_ERROR(
+            "VHPI: Unable to set logic vector from a vector of %d bits, %d "
+            "are needed",
+            n_bits, m_num_elems);
+        return -1;
+    }
+
+    switch (m_value.format) {
+        case vhpiEnumVal:
+        case vhpiLogicVal: {
+            m_value.value.enumv = chr2vhpi(unpack_logic_bit(buf, 0));
+            break;
+        }
+
+        case vhpiEnumVecVal:
+        case vhpiLogicVecVal: {
+            m_value.numElems = m_num_elems;
+
+            for (int i = 0; i < m_num_elems; i++) {
+                // Element 0 is the left-most bit
+                m_value.value.enumvs[i] =
+                    chr2vhpi(unpack_logic_bit(buf, m_num_elems - 1 - i));
+            }
+            break;
+        }
+
+        default: {
+            LOG_ERROR(
+                "VHPI: Unable to set a std_logic signal with a raw value");
+            return -1;
+        }
+    }
+
+    if (vhpi_put_value(GpiObjHdl::get_handle<vhpiHandleT>(), &m_value,
+                       map_put_value_mode(action))) {
+        check_vhpi_error();
+        return -1;
+    }
+
+    return 0;
+}
+
+int VhpiLogicSignalObjHdl::get_signal_value_bytes(gpi_vecval_t *buf,
+                                                  int n_words) {
+    int words = (m_num_elems + 31) / 32;
+    if (!buf || n_words < words) {
+        return m_num_elems;
+    }
+
+    /* Indexed by the std_logic enumeration vhpiU .. vhpiDontCare */
+    static const char logic_chars[] = "UX01ZWLH-";
+
+    if (vhpi_get_value(GpiObjHdl::get_handle<vhpiHandleT>(), &m_value)) {
+        check_vhpi_error();
+        return -1;
+    }
+
+    memset(buf, 0, sizeof(gpi_vecval_t) * static_cast<size_t>(words));
+
+    switch (m_value.format) {
+        case vhpiEnumVal:
+        case vhpiLogicVal: {
+            vhpiEnumT value = m_value.value.enumv;
+            if (value > vhpiDontCare ||
+                !pack_logic_bit(buf, 0, logic_chars[value])) {
+                return -1;
+            }
+            break;
+        }
+
+        case vhpiEnumVecVal:
+        case vhpiLogicVecVal: {
+            for (int i = 0; i < m_num_elems; i++) {
+                // Element 0 is the left-most bit
+                vhpiEnumT value = m_value.value.enumvs[i];
+                if (value > vhpiDontCare ||
+                    !pack_logic_bit(buf, m_num_elems - 1 - i,
+                                    logic_chars[value])) {
+                    return -1;
+                }
+            }
+            break;
+        }
+
+        default:
+            return -1;
+    }
+
+    return m_num_elems;
+}
+
 // Value related functions
 int VhpiSignalObjHdl::set_signal_value(int32_t value, gpi_set_action_t action) {
     switch (m_value.format) {
@@ -785,19 +854,44 @@ const char *VhpiSignalObjHdl::get_signal_value_binstr() {
         default: {
             /* Some simulators do not support BinaryValues so we fake up here
              * for them */
+            // The callers copy the value before the next read, so all
+            // signals share one buffer, grown to the largest value read
+            static std::vector<vhpiCharT> binstr_buf(1);
+            size_t needed = static_cast<size_t>(m_num_elems) + 1;
+            if (binstr_buf.size() < needed) {
+                binstr_buf.resize(needed);
+            }
+
+            vhpiValueT binvalue;
+            binvalue.format = vhpiBinStrVal;
+            binvalue.numElems = 0;
+            binvalue.bufSize = static_cast<bufSize_type>(binstr_buf.size() *
+                                                         sizeof(vhpiCharT));
+            binvalue.value.str = binstr_buf.data();
+
             int ret = vhpi_get_value(GpiObjHdl::get_handle<vhpiHandleT>(),
-                                     &m_binvalue);
+                                     &binvalue);
+            if (ret > 0) {
+                // Returns the size required when the buffer is too small
+                binstr_buf.resize(static_cast<size_t>(ret));
+                binvalue.bufSize = static_cast<bufSize_type>(
+                    binstr_buf.size() * sizeof(vhpiCharT));
+                binvalue.value.str = binstr_buf.data();
+                ret = vhpi_get_value(GpiObjHdl::get_handle<vhpiHandleT>(),
+                                     &binvalue);
+            }
             if (ret) {
                 check_vhpi_error();
                 LOG_ERROR(
-                    "VHPI: Size of m_binvalue.value.str was not large enough: "
-                    "req=%d have=%d for type %s",
-                    ret, m_binvalue.bufSize,
+                    "VHPI: Unable to read the binary value: req=%d have=%d "
+                    "for type %s",
+                    ret, binvalue.bufSize,
                     ((VhpiImpl *)GpiObjHdl::m_impl)
                         ->format_to_string(m_value.format));
+                return "";
             }
 
-            return m_binvalue.value.str;
+            return binvalue.value.str;
         }
     }
 }
@@ -867,6 +961,62 @@ VhpiValueCbHdl::VhpiValueCbHdl(GpiImplInterface *impl, VhpiSignalObjHdl *sig,
     cb_data.reason = vhpiCbValueChange;
     cb_data.time = &vhpi_time;
     cb_data.obj = m_signal->get_handle<vhpiHandleT>();
+
+    if (dynamic_cast<VhpiLogicSignalObjHdl *>(sig) && !sig->get_indexable() &&
+        sig->get_num_elems() == 1) {
+        m_cb_value.format = vhpiLogicVal;
+        m_cb_value.bufSize = 0;
+        m_cb_value.numElems = 0;
+        m_cb_value.value.enumv = vhpiU;
+        cb_data.value = &m_cb_value;
+    }
+}
+
+void VhpiValueCbHdl::set_delivered_value(const vhpiValueT *value) {
+    m_has_value = value && (value->format == vhpiLogicVal ||
+                            value->format == vhpiEnumVal);
+    if (m_has_value) {
+        m_delivered = value->value.enumv;
+    }
+}
+
+int VhpiValueCbHdl::get_delivered_value(gpi_vecval_t *buf, int n_words) {
+    if (!m_has_value) {
+        return -1;
+    }
+    if (!buf || n_words < 1) {
+        return 1;
+    }
+
+    switch (m_delivered) {
+        case vhpi0:
+            buf->aval = 0;
+            buf->bval = 0;
+            break;
+        case vhpi1:
+            buf->aval = 1;
+            buf->bval = 0;
+            break;
+        case vhpiZ:
+            buf->aval = 0;
+            buf->bval = 1;
+            break;
+        case vhpiX:
+            buf->aval = 1;
+            buf->bval = 1;
+            break;
+        default:
+            /* As get_signal_value_bytes(), which only packs 0, 1, X and Z */
+            return -1;
+    }
+    return 1;
+}
+
+bool VhpiValueCbHdl::edge_matches() {
+    if (!m_has_value) {
+        return GpiValueCbHdl::edge_matches();
+    }
+    return m_delivered == (m_edge == GPI_RISING ? vhpi1 : vhpi0);
 }
 
 VhpiStartupCbHdl::VhpiStartupCbHdl(GpiImplInterface *impl)
@@ -934,6 +1084,15 @@ int VhpiTimedCbHdl::cleanup_callback() {
     return 1;
 }
 
+int VhpiTimedCbHdl::rearm_timer(uint64_t time) {
+    /* After-delay callbacks are one-shot, so remove the fired callback and
+     * register again with the new delay, keeping this object. */
+    cleanup_callback();
+    vhpi_time.high = (uint32_t)(time >> 32);
+    vhpi_time.low = (uint32_t)(time);
+    return arm_callback();
+}
+
 VhpiReadWriteCbHdl::VhpiReadWriteCbHdl(GpiImplInterface *impl)
     : GpiCbHdl(impl), VhpiCbHdl(impl) {
     cb_data.reason = vhpiCbRepLastKnownDeltaCycle;
@@ -1073,10 +1232,11 @@ VhpiIterator::~VhpiIterator() {
 
 #define VHPI_TYPE_MIN (1000)
 
-GpiIterator::Status VhpiIterator::next_handle(std::string &name,
-                                              GpiObjHdl **hdl, void **raw_hdl) {
+GpiIterator::Status VhpiIterator::next_object(std::string &name,
+                                              std::string &fq_name,
+                                              vhpiHandleT *next_obj,
+                                              void **raw_hdl) {
     vhpiHandleT obj;
-    GpiObjHdl *new_obj;
 
     if (!selected) return GpiIterator::END;
 
@@ -1207,7 +1367,7 @@ GpiIterator::Status VhpiIterator::next_handle(std::string &name,
     /* We try and create a handle internally, if this is not possible we
        return and GPI will try other implementations with the name
        */
-    std::string fq_name = m_parent->get_fullname();
+    fq_name = m_parent->get_fullname();
     if (fq_name == ":") {
         fq_name += name;
     } else if (obj_type == GPI_GENARRAY) {
@@ -1232,11 +1392,51 @@ GpiIterator::Status VhpiIterator::next_handle(std::string &name,
     } else {
         fq_name += "." + name;
     }
+    *next_obj = obj;
+    return GpiIterator::NATIVE;
+}
+
+GpiIterator::Status VhpiIterator::next_handle(std::string &name,
+                                              GpiObjHdl **hdl, void **raw_hdl) {
+    std::string fq_name;
+    vhpiHandleT obj;
+
+    GpiIterator::Status ret = next_object(name, fq_name, &obj, raw_hdl);
+    if (ret != GpiIterator::NATIVE) {
+        return ret;
+    }
+
     VhpiImpl *vhpi_impl = reinterpret_cast<VhpiImpl *>(m_impl);
-    new_obj = vhpi_impl->create_gpi_obj_from_handle(obj, name, fq_name);
+    GpiObjHdl *new_obj =
+        vhpi_impl->create_gpi_obj_from_handle(obj, name, fq_name);
     if (new_obj) {
         *hdl = new_obj;
         return GpiIterator::NATIVE;
     } else
         return GpiIterator::NOT_NATIVE;
 }
+
+GpiIterator::Status VhpiIterator::next_name(std::string &name,
+                                            gpi_objtype_t *type,
+                                            void **raw_hdl) {
+    std::string fq_name;
+    vhpiHandleT obj;
+
+    GpiIterator::Status ret = next_object(name, fq_name, &obj, raw_hdl);
+    if (ret != GpiIterator::NATIVE) {
+        return ret;
+    }
+
+    VhpiImpl *vhpi_impl = reinterpret_cast<VhpiImpl *>(m_impl);
+    *type = vhpi_impl->get_gpi_obj_type(obj, name, fq_name);
+
+    /* The handle is looked up again by name if the object is needed */
+    if (obj != m_parent->get_handle<vhpiHandleT>()) {
+        vhpi_release_handle(obj);
+    }
+
+    if (*type == GPI_UNKNOWN) {
+        return GpiIterator::NOT_NATIVE;
+    }
+    return GpiIterator::NATIVE;
+}
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 extern "C" {
 static VhpiCbHdl *sim_init_cb;
@@ -279,16 +280,15 @@ static bool compare_names(const std::string &a, const std::string &b) {
 #endif
 }
 
-GpiObjHdl *VhpiImpl::create_gpi_obj_from_handle(vhpiHandleT new_hdl,
-                                                const std::string &name,
-                                                const std::string &fq_name) {
+gpi_objtype_t VhpiImpl::get_gpi_obj_type(vhpiHandleT new_hdl,
+                                         const std::string &name,
+                                         const std::string &fq_name) {
     vhpiIntT type;
     gpi_objtype_t gpi_type;
-    GpiObjHdl *new_obj = NULL;
 
     if (vhpiVerilog == (type = vhpi_get(vhpiKindP, new_hdl))) {
-        LOG_DEBUG("VHPI: vhpiVerilog returned from vhpi_get(vhpiType, ...)")
-        return NULL;
+        LOG_DEBUG("VHPI: vhpiVerilog returned from vhpi_get(vhpiType, ...)");
+        return GPI_UNKNOWN;
     }
 
     /* We need to delve further here to determine how to later set
@@ -455,14 +455,29 @@ GpiObjHdl *VhpiImpl::create_gpi_obj_from_handle(vhpiHandleT new_hdl,
 
             LOG_ERROR("VHPI: Not able to map type (%s) %u to object",
                       vhpi_get_str(vhpiKindStrP, query_hdl), type);
-            new_obj = NULL;
-            goto out;
+            gpi_type = GPI_UNKNOWN;
+            break;
         }
     }
 
+    if (base_hdl != NULL) vhpi_release_handle(base_hdl);
+
+    return gpi_type;
+}
+
+GpiObjHdl *VhpiImpl::create_gpi_obj_from_handle(vhpiHandleT new_hdl,
+                                                const std::string &name,
+                                                const std::string &fq_name) {
+    GpiObjHdl *new_obj = NULL;
+
+    gpi_objtype_t gpi_type = get_gpi_obj_type(new_hdl, name, fq_name);
+    if (gpi_type == GPI_UNKNOWN) {
+        return NULL;
+    }
+
     LOG_DEBUG("VHPI: Creating %s of type %d (%s)",
               vhpi_get_str(vhpiFullCaseNameP, new_hdl), gpi_type,
-              vhpi_get_str(vhpiKindStrP, query_hdl));
+              vhpi_get_str(vhpiKindStrP, new_hdl));
 
     if (gpi_type != GPI_ARRAY && gpi_type != GPI_GENARRAY &&
         gpi_type != GPI_MODULE && gpi_type != GPI_STRUCTURE) {
@@ -483,9 +498,6 @@ GpiObjHdl *VhpiImpl::create_gpi_obj_from_handle(vhpiHandleT new_hdl,
         new_obj = NULL;
     }
 
-out:
-    if (base_hdl != NULL) vhpi_release_handle(base_hdl);
-
     return new_obj;
 }
 
@@ -680,9 +692,9 @@ GpiObjHdl *VhpiImpl::native_check_create(int32_t index, GpiObjHdl *parent) {
              *    parent->get_name():   sig_name(x)(y)...  where x,y,... are the
              * indices to a multi-dimensional array. pseudo_idx:   (x)(y)...
              */
-            if (hdl_name.length() < parent->get_name().length()) {
-                std::string pseudo_idx =
-                    parent->get_name().substr(hdl_name.length());
+            const char *parent_name = parent->get_name_str();
+            if (hdl_name.length() < strlen(parent_name)) {
+                std::string pseudo_idx = parent_name + hdl_name.length();
 
                 while (pseudo_idx.length() > 0) {
                     std::size_t found = pseudo_idx.find_first_of(")");
@@ -1021,6 +1033,7 @@ GpiCbHdl *VhpiImpl::register_nexttime_callback(int (*function)(void *),
 }
 
 int VhpiImpl::deregister_callback(GpiCbHdl *gpi_hdl) {
+    gpi_unqueue_callback(gpi_hdl);
     gpi_hdl->cleanup_callback();
     return 0;
 }
@@ -1045,10 +1058,25 @@ bool VhpiImpl::compare_generate_labels(const std::string &a,
 
 extern "C" {
 
+static bool run_vhpi_callback(GpiCbHdl *cb_hdl) {
+    gpi_cb_state_e old_state = cb_hdl->get_call_state();
+
+    if (old_state == GPI_PRIMED) {
+        cb_hdl->set_call_state(GPI_CALL);
+        gpi_run_callback(cb_hdl);
+
+        gpi_cb_state_e new_state = cb_hdl->get_call_state();
+
+        /* We have re-primed in the handler */
+        if (new_state != GPI_PRIMED) {
+            return cb_hdl->cleanup_callback() != 0;
+        }
+    }
+    return false;
+}
+
 // Main entry point for callbacks from simulator
 void handle_vhpi_callback(const vhpiCbDataT *cb_data) {
-    gpi_to_user();
-
     VhpiCbHdl *cb_hdl = (VhpiCbHdl *)cb_data->user_data;
 
     if (!cb_hdl) {
@@ -1057,22 +1085,12 @@ void handle_vhpi_callback(const vhpiCbDataT *cb_data) {
         return;
     }
 
-    gpi_cb_state_e old_state = cb_hdl->get_call_state();
-
-    if (old_state == GPI_PRIMED) {
-        cb_hdl->set_call_state(GPI_CALL);
-        cb_hdl->run_callback();
-
-        gpi_cb_state_e new_state = cb_hdl->get_call_state();
-
-        /* We have re-primed in the handler */
-        if (new_state != GPI_PRIMED)
-            if (cb_hdl->cleanup_callback()) {
-                delete cb_hdl;
-            }
+    // The delivered value is only valid during this call, so it is kept
+    // before the callback can be queued
+    if (cb_hdl->get_call_state() == GPI_PRIMED) {
+        cb_hdl->set_delivered_value(cb_data->value);
     }
-
-    gpi_to_simulator();
+    gpi_deliver_callback(cb_hdl, run_vhpi_callback);
 };
 
 static void register_initial_callback() {
@@ -86,7 +86,7 @@ static inline int __check_vhpi_error(const char *file, const char *func,
             break;
     }
 
-    gpi_log("gpi", loglevel, file, func, line,
+    gpi_log(gpi_logger_name, loglevel, file, func, line,
             "VHPI Error level %d: %s\nFILE %s:%d", info.severity, info.message,
             info.file, info.line);
 
@@ -106,6 +106,9 @@ class VhpiCbHdl : public virtual GpiCbHdl {
     int arm_callback() override;
     int cleanup_callback() override;
 
+    // Called with the value of the callback data before the callback is run
+    virtual void set_delivered_value(const vhpiValueT *) {}
+
   protected:
     vhpiCbDataT cb_data;
     vhpiTimeT vhpi_time;
@@ -119,14 +122,26 @@ class VhpiValueCbHdl : public VhpiCbHdl, public GpiValueCbHdl {
                    gpi_edge_e edge);
     int cleanup_callback() override { return VhpiCbHdl::cleanup_callback(); }
 
+    void set_delivered_value(const vhpiValueT *value) override;
+    int get_delivered_value(gpi_vecval_t *buf, int n_words) override;
+
+  protected:
+    bool edge_matches() override;
+
   private:
     std::string initial_value;
+    /* Scalar logic signals have their new value delivered with the callback,
+     * so the edge can be filtered without reading the signal again */
+    vhpiValueT m_cb_value;
+    bool m_has_value = false;
+    vhpiEnumT m_delivered = vhpiU;
 };
 
 class VhpiTimedCbHdl : public VhpiCbHdl {
   public:
     VhpiTimedCbHdl(GpiImplInterface *impl, uint64_t time);
     int cleanup_callback() override;
+    int rearm_timer(uint64_t time) override;
 };
 
 class VhpiReadOnlyCbHdl : public VhpiCbHdl {
@@ -217,7 +232,6 @@ class VhpiSignalObjHdl : public GpiSignalObjHdl {
   protected:
     vhpiEnumT chr2vhpi(char value);
     vhpiValueT m_value;
-    vhpiValueT m_binvalue;
 };
 
 class VhpiLogicSignalObjHdl : public VhpiSignalObjHdl {
@@ -226,10 +240,14 @@ class VhpiLogicSignalObjHdl : public VhpiSignalObjHdl {
                           gpi_objtype_t objtype, bool is_const)
         : VhpiSignalObjHdl(impl, hdl, objtype, is_const) {}
 
+    int get_signal_value_bytes(gpi_vecval_t *buf, int n_words) override;
+
     using GpiSignalObjHdl::set_signal_value;
     int set_signal_value(int32_t value, gpi_set_action_t action) override;
     int set_signal_value_binstr(std::string &value,
                                 gpi_set_action_t action) override;
+    int set_signal_value_vector(const gpi_vecval_t *buf, int n_bits,
+                                gpi_set_action_t action) override;
 
     int initialise(const std::string &name,
                    const std::string &fq_name) override;
@@ -243,8 +261,15 @@ class VhpiIterator : public GpiIterator {
 
     Status next_handle(std::string &name, GpiObjHdl **hdl,
                        void **raw_hdl) override;
+    bool supports_next_name() override { return true; }
+    Status next_name(std::string &name, gpi_objtype_t *type,
+                     void **raw_hdl) override;
 
   private:
+    // Finds the next object and its name, without creating a handle for it
+    Status next_object(std::string &name, std::string &fq_name,
+                       vhpiHandleT *next_obj, void **raw_hdl);
+
     vhpiHandleT m_iterator;
     vhpiHandleT m_iter_obj;
     static std::map<vhpiClassKindT, std::vector<vhpiOneToManyT>>
@@ -294,6 +319,10 @@ class VhpiImpl : public GpiImplInterface {
     GpiObjHdl *create_gpi_obj_from_handle(vhpiHandleT new_hdl,
                                           const std::string &name,
                                           const std::string &fq_name);
+    // The type of the object create_gpi_obj_from_handle() would create,
+    // GPI_UNKNOWN if it would not create one
+    gpi_objtype_t get_gpi_obj_type(vhpiHandleT new_hdl, const std::string &name,
+                                   const std::string &fq_name);
 
     static bool compare_generate_labels(const std::string &a,
                                         const std::string &b);
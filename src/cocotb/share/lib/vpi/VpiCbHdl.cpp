@@ -35,6 +35,29 @@
 
 extern "C" int32_t handle_vpi_callback(p_cb_data cb_data);
 
+#ifdef VERILATOR
+/* Number of callbacks cocotb has registered for each of the standard reasons,
+ * so the Verilator main loop can skip the regions nobody is waiting on */
+static unsigned int armed_callbacks[cbAtEndOfSimTime + 1];
+
+static inline void count_armed_callback(PLI_INT32 reason, int delta) {
+    if (reason >= 0 && reason <= cbAtEndOfSimTime) {
+        armed_callbacks[reason] += delta;
+    }
+}
+
+extern "C" COCOTBVPI_EXPORT unsigned int cocotbvpi_armed_callbacks(
+    PLI_INT32 reason) {
+    if (reason < 0 || reason > cbAtEndOfSimTime) {
+        // Unknown reasons are reported as armed so they are never skipped
+        return 1;
+    }
+    return armed_callbacks[reason];
+}
+#else
+static inline void count_armed_callback(PLI_INT32, int) {}
+#endif
+
 VpiCbHdl::VpiCbHdl(GpiImplInterface *impl) : GpiCbHdl(impl) {
     vpi_time.high = 0;
     vpi_time.low = 0;
@@ -80,6 +103,7 @@ int VpiCbHdl::arm_callback() {
     }
 
     m_obj_hdl = new_hdl;
+    count_armed_callback(cb_data.reason, 1);
 
     return 0;
 }
@@ -113,6 +137,7 @@ int VpiCbHdl::cleanup_callback() {
 #endif
     }
 
+    count_armed_callback(cb_data.reason, -1);
     m_obj_hdl = NULL;
     m_state = GPI_FREE;
 
@@ -123,7 +148,13 @@ VpiValueCbHdl::VpiValueCbHdl(GpiImplInterface *impl, VpiSignalObjHdl *sig,
                              gpi_edge_e edge)
     : GpiCbHdl(impl), VpiCbHdl(impl), GpiValueCbHdl(impl, sig, edge) {
     vpi_time.type = vpiSuppressTime;
-    m_vpi_value.format = vpiIntVal;
+    // Edges of single bit signals are filtered on the scalar value delivered
+    // with the callback
+    if (edge != GPI_VALUE_CHANGE && sig->m_length == 1) {
+        m_vpi_value.format = vpiScalarVal;
+    } else {
+        m_vpi_value.format = vpiIntVal;
+    }
 
     cb_data.reason = cbValueChange;
     cb_data.time = &vpi_time;
@@ -131,6 +162,21 @@ VpiValueCbHdl::VpiValueCbHdl(GpiImplInterface *impl, VpiSignalObjHdl *sig,
     cb_data.obj = m_signal->get_handle<vpiHandle>();
 }
 
+void VpiValueCbHdl::set_delivered_value(p_vpi_value value) {
+    if (value && value->format == vpiScalarVal) {
+        m_vpi_value.value.scalar = value->value.scalar;
+        m_value_delivered = true;
+    }
+}
+
+bool VpiValueCbHdl::edge_matches() {
+    if (!m_value_delivered) {
+        return GpiValueCbHdl::edge_matches();
+    }
+    m_value_delivered = false;
+    return m_vpi_value.value.scalar == (m_edge == GPI_RISING ? vpi1 : vpi0);
+}
+
 int VpiValueCbHdl::cleanup_callback() {
     if (m_state == GPI_FREE) return 0;
 
@@ -141,6 +187,7 @@ int VpiValueCbHdl::cleanup_callback() {
         return -1;
     }
 
+    count_armed_callback(cb_data.reason, -1);
     m_obj_hdl = NULL;
     m_state = GPI_FREE;
     return 0;
@@ -210,6 +257,17 @@ int VpiTimedCbHdl::cleanup_callback() {
     return 1;
 }
 
+int VpiTimedCbHdl::rearm_timer(uint64_t time) {
+    /* The fired callback is one-shot, so free its handle and register again
+     * with the new delay, keeping this object. */
+    if (VpiCbHdl::cleanup_callback()) {
+        return -1;
+    }
+    vpi_time.high = (uint32_t)(time >> 32);
+    vpi_time.low = (uint32_t)(time);
+    return arm_callback();
+}
+
 VpiReadWriteCbHdl::VpiReadWriteCbHdl(GpiImplInterface *impl)
     : GpiCbHdl(impl), VpiCbHdl(impl) {
     cb_data.reason = cbReadWriteSynch;
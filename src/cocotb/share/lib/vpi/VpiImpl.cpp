@@ -28,10 +28,6 @@
 #include "VpiImpl.h"
 
 #include <cstring>
-#ifndef VPI_NO_QUEUE_SETIMMEDIATE_CALLBACKS
-#include <algorithm>
-#include <queue>
-#endif
 
 #include "_vendor/vpi/vpi_user.h"
 
@@ -40,10 +36,6 @@ extern "C" {
 static VpiCbHdl *sim_init_cb;
 static VpiCbHdl *sim_finish_cb;
 static VpiImpl *vpi_table;
-
-#ifndef VPI_NO_QUEUE_SETIMMEDIATE_CALLBACKS
-static std::deque<GpiCbHdl *> cb_queue;
-#endif
 }
 
 #define CASE_STR(_X) \
@@ -101,6 +93,61 @@ const char *VpiImpl::get_simulator_version() {
     return m_version.c_str();
 }
 
+#ifdef VERILATOR
+/* Whether the Verilator harness should dump its trace, -1 if it has not
+ * opened one */
+static int trace_state = -1;
+
+extern "C" COCOTBVPI_EXPORT void cocotbvpi_set_trace_state(int state) {
+    trace_state = state;
+}
+
+extern "C" COCOTBVPI_EXPORT int cocotbvpi_trace_state() { return trace_state; }
+
+int VpiImpl::set_trace_enabled(bool enable) {
+    if (trace_state < 0) {
+        LOG_ERROR(
+            "VPI: No trace to control, the simulation was not started with "
+            "--trace");
+        return -1;
+    }
+    trace_state = enable;
+    return 0;
+}
+
+/* Whether the Verilator harness can save checkpoints, which the model must be
+ * verilated with --savable for */
+static bool checkpoints_supported = false;
+static bool checkpoint_requested = false;
+static std::string checkpoint_path;
+
+extern "C" COCOTBVPI_EXPORT void cocotbvpi_set_checkpoints_supported() {
+    checkpoints_supported = true;
+}
+
+/* Returns the path of the checkpoint to save at the end of this time step, or
+ * NULL if none was requested */
+extern "C" COCOTBVPI_EXPORT const char *cocotbvpi_take_checkpoint_request() {
+    if (!checkpoint_requested) {
+        return NULL;
+    }
+    checkpoint_requested = false;
+    return checkpoint_path.c_str();
+}
+
+int VpiImpl::save_checkpoint(const std::string &path) {
+    if (!checkpoints_supported) {
+        LOG_ERROR(
+            "VPI: Cannot save checkpoints, the model was not verilated with "
+            "--savable");
+        return -1;
+    }
+    checkpoint_path = path;
+    checkpoint_requested = true;
+    return 0;
+}
+#endif
+
 static gpi_objtype_t to_gpi_objtype(int32_t vpitype) {
     switch (vpitype) {
         case vpiNet:
@@ -200,7 +247,7 @@ GpiObjHdl *VpiImpl::create_gpi_obj_from_handle(vpiHandle new_hdl,
     int32_t type;
     GpiObjHdl *new_obj = NULL;
     if (vpiUnknown == (type = vpi_get(vpiType, new_hdl))) {
-        LOG_DEBUG("vpiUnknown returned from vpi_get(vpiType, ...)")
+        LOG_DEBUG("vpiUnknown returned from vpi_get(vpiType, ...)");
         return NULL;
     }
 
@@ -292,7 +339,12 @@ GpiObjHdl *VpiImpl::create_gpi_obj_from_handle(vpiHandle new_hdl,
             return NULL;
     }
 
-    new_obj->initialise(name, fq_name);
+    new_obj->initialise_from_cache(name, fq_name);
+#ifdef VERILATOR
+    if (auto signal = dynamic_cast<VpiSignalObjHdl *>(new_obj)) {
+        signal->init_direct_access(fq_name);
+    }
+#endif
 
     LOG_DEBUG("VPI: Created GPI object from type %s(%d)",
               vpi_get_str(vpiType, new_hdl), type);
@@ -300,6 +352,67 @@ GpiObjHdl *VpiImpl::create_gpi_obj_from_handle(vpiHandle new_hdl,
     return new_obj;
 }
 
+gpi_objtype_t VpiImpl::get_gpi_obj_type(vpiHandle new_hdl,
+                                        const std::string &name) {
+    int32_t type = vpi_get(vpiType, new_hdl);
+
+    /* Must match the objects made by create_gpi_obj_from_handle() */
+    switch (type) {
+        case vpiNet:
+        case vpiNetBit:
+        case vpiBitVar:
+        case vpiReg:
+        case vpiRegBit:
+        case vpiEnumNet:
+        case vpiEnumVar:
+        case vpiIntVar:
+        case vpiIntegerVar:
+        case vpiIntegerNet:
+        case vpiRealVar:
+        case vpiRealNet:
+        case vpiStringVar:
+        case vpiMemoryWord:
+        case vpiInterconnectNet:
+        case vpiRegArray:
+        case vpiNetArray:
+        case vpiInterfaceArray:
+        case vpiPackedArrayVar:
+        case vpiPackedArrayNet:
+        case vpiMemory:
+        case vpiInterconnectArray:
+            return to_gpi_objtype(type);
+        case vpiParameter:
+        case vpiConstant:
+            return const_type_to_gpi_objtype(vpi_get(vpiConstType, new_hdl));
+        case vpiStructVar:
+        case vpiStructNet:
+        case vpiUnionVar:
+        case vpiUnionNet:
+            if (vpi_get(vpiPacked, new_hdl)) {
+                return GPI_PACKED_STRUCTURE;
+            }
+            return to_gpi_objtype(type);
+        case vpiModule:
+        case vpiInterface:
+        case vpiModport:
+        case vpiRefObj:
+        case vpiPort:
+        case vpiAlways:
+        case vpiFunction:
+        case vpiInitial:
+        case vpiGate:
+        case vpiPrimTerm:
+        case vpiGenScope:
+        case vpiGenScopeArray:
+            if (name != vpi_get_str(vpiName, new_hdl)) {
+                return GPI_GENARRAY;
+            }
+            return to_gpi_objtype(type);
+        default:
+            return GPI_UNKNOWN;
+    }
+}
+
 GpiObjHdl *VpiImpl::native_check_create(void *raw_hdl, GpiObjHdl *parent) {
     LOG_DEBUG("Trying to convert raw to VPI handle");
 
@@ -505,9 +618,9 @@ GpiObjHdl *VpiImpl::native_check_create(int32_t index, GpiObjHdl *parent) {
 
             /* Removing the act_hdl_name from the parent->get_name() will leave
              * the pseudo-indices */
-            if (act_hdl_name.length() < parent->get_name().length()) {
-                std::string idx_str =
-                    parent->get_name().substr(act_hdl_name.length());
+            const char *parent_name = parent->get_name_str();
+            if (act_hdl_name.length() < strlen(parent_name)) {
+                std::string idx_str = parent_name + act_hdl_name.length();
 
                 while (idx_str.length() > 0) {
                     std::size_t found = idx_str.find_first_of("]");
@@ -554,7 +667,7 @@ GpiObjHdl *VpiImpl::native_check_create(int32_t index, GpiObjHdl *parent) {
     snprintf(buff, 14, "[%d]", index);
 
     std::string idx = buff;
-    std::string name = parent->get_name() + idx;
+    std::string name = parent->get_name_str() + idx;
     std::string fq_name = parent->get_fullname() + idx;
     GpiObjHdl *new_obj = create_gpi_obj_from_handle(new_hdl, name, fq_name);
     if (new_obj == NULL) {
@@ -679,13 +792,7 @@ GpiCbHdl *VpiImpl::register_nexttime_callback(int (*function)(void *),
 }
 
 int VpiImpl::deregister_callback(GpiCbHdl *gpi_hdl) {
-#ifndef VPI_NO_QUEUE_SETIMMEDIATE_CALLBACKS
-    auto it = std::find(cb_queue.begin(), cb_queue.end(), gpi_hdl);
-    if (it != cb_queue.end()) {
-        cb_queue.erase(it);
-    }
-#endif
-
+    gpi_unqueue_callback(gpi_hdl);
     return gpi_hdl->cleanup_callback();
 }
 
@@ -716,68 +823,47 @@ const char *VpiImpl::get_type_delimiter(GpiObjHdl *obj_hdl) {
 
 extern "C" {
 
-static int32_t handle_vpi_callback_(GpiCbHdl *cb_hdl) {
-    gpi_to_user();
-
-    if (!cb_hdl) {
-        // LCOV_EXCL_START
-        LOG_CRITICAL("VPI: Callback data corrupted: ABORTING");
-        gpi_embed_end();
-        return -1;
-        // LCOV_EXCL_STOP
-    }
-
+static bool run_vpi_callback(GpiCbHdl *cb_hdl) {
     gpi_cb_state_e old_state = cb_hdl->get_call_state();
 
     if (old_state == GPI_PRIMED) {
         cb_hdl->set_call_state(GPI_CALL);
-        cb_hdl->run_callback();
+        gpi_run_callback(cb_hdl);
 
         gpi_cb_state_e new_state = cb_hdl->get_call_state();
 
         /* We have re-primed in the handler */
-        if (new_state != GPI_PRIMED)
-            if (cb_hdl->cleanup_callback()) {
-                delete cb_hdl;
-            }
-
-    } else {
-        /* Issue #188: This is a work around for a modelsim */
-        if (cb_hdl->cleanup_callback()) {
-            delete cb_hdl;
+        if (new_state != GPI_PRIMED) {
+            return cb_hdl->cleanup_callback() != 0;
         }
+        return false;
     }
-
-    gpi_to_simulator();
-
-    return 0;
+    /* Issue #188: This is a work around for a modelsim */
+    return cb_hdl->cleanup_callback() != 0;
 }
 
 // Main re-entry point for callbacks from simulator
 int32_t handle_vpi_callback(p_cb_data cb_data) {
-#ifdef VPI_NO_QUEUE_SETIMMEDIATE_CALLBACKS
     VpiCbHdl *cb_hdl = (VpiCbHdl *)cb_data->user_data;
-    return handle_vpi_callback_(cb_hdl);
-#else
-    // must push things into a queue because Icaurus (gh-4067), Xcelium
-    // (gh-4013), and Questa (gh-4105) react to value changes on signals that
-    // are set with vpiNoDelay immediately, and not after the current callback
-    // has ended, causing re-entrancy.
-    static bool reacting = false;
-    VpiCbHdl *cb_hdl = (VpiCbHdl *)cb_data->user_data;
-    if (reacting) {
-        cb_queue.push_back(cb_hdl);
-        return 0;
-    }
-    reacting = true;
-    int32_t ret = handle_vpi_callback_(cb_hdl);
-    while (!cb_queue.empty()) {
-        handle_vpi_callback_(cb_queue.front());
-        cb_queue.pop_front();
-    }
-    reacting = false;
-    return ret;
-#endif
+
+    if (!cb_hdl) {
+        // LCOV_EXCL_START
+        LOG_CRITICAL("VPI: Callback data corrupted: ABORTING");
+        gpi_embed_end();
+        return -1;
+        // LCOV_EXCL_STOP
+    }
+
+    // The delivered value is only valid during this call, so it is kept
+    // before the callback can be queued
+    if (cb_data->reason == cbValueChange) {
+        cb_hdl->set_delivered_value(cb_data->value);
+    }
+    // Icarus (gh-4067), Xcelium (gh-4013) and Questa (gh-4105) react to value
+    // changes on signals that are set with vpiNoDelay immediately, and not
+    // after the current callback has ended, so these are queued
+    gpi_deliver_callback(cb_hdl, run_vpi_callback);
+    return 0;
 }
 
 static void register_impl() {
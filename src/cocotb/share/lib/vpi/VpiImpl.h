@@ -74,8 +74,9 @@ static inline int __check_vpi_error(const char *file, const char *func,
             loglevel = GPIWarning;
     }
 
-    gpi_log("gpi", loglevel, file, func, line, "VPI error");
-    gpi_log("gpi", loglevel, info.file, info.product, info.line, info.message);
+    gpi_log(gpi_logger_name, loglevel, file, func, line, "VPI error");
+    gpi_log(gpi_logger_name, loglevel, info.file, info.product, info.line,
+            info.message);
 
 #endif
     return level;
@@ -97,6 +98,9 @@ class VpiCbHdl : public virtual GpiCbHdl {
     int arm_callback() override;
     int cleanup_callback() override;
 
+    // Called with the value delivered by the simulator for the callback
+    virtual void set_delivered_value(p_vpi_value) {}
+
   protected:
     s_cb_data cb_data;
     s_vpi_time vpi_time;
@@ -109,15 +113,21 @@ class VpiValueCbHdl : public VpiCbHdl, public GpiValueCbHdl {
     VpiValueCbHdl(GpiImplInterface *impl, VpiSignalObjHdl *sig,
                   gpi_edge_e edge);
     int cleanup_callback() override;
+    void set_delivered_value(p_vpi_value value) override;
+
+  protected:
+    bool edge_matches() override;
 
   private:
     s_vpi_value m_vpi_value;
+    bool m_value_delivered = false;
 };
 
 class VpiTimedCbHdl : public VpiCbHdl {
   public:
     VpiTimedCbHdl(GpiImplInterface *impl, uint64_t time);
     int cleanup_callback() override;
+    int rearm_timer(uint64_t time) override;
 };
 
 class VpiReadOnlyCbHdl : public VpiCbHdl {
@@ -162,6 +172,14 @@ class VpiArrayObjHdl : public GpiObjHdl {
 
     int initialise(const std::string &name,
                    const std::string &fq_name) override;
+
+    bool get_array_values(int32_t first, int count,
+                          gpi_vecval_t *buf) override;
+    bool set_array_values(int32_t first, int count, const gpi_vecval_t *buf,
+                          gpi_set_action_t action) override;
+
+  private:
+    bool is_whole_array();
 };
 
 class VpiObjHdl : public GpiObjHdl {
@@ -177,12 +195,21 @@ class VpiSignalObjHdl : public GpiSignalObjHdl {
   public:
     VpiSignalObjHdl(GpiImplInterface *impl, vpiHandle hdl,
                     gpi_objtype_t objtype, bool is_const)
-        : GpiSignalObjHdl(impl, hdl, objtype, is_const) {}
+        : GpiSignalObjHdl(impl, hdl, objtype, is_const) {
+#if defined(MODELSIM) || defined(IUS)
+        // Xcelium and Questa do not like setting string variables using
+        // vpiInertialDelay.
+        if (objtype == GPI_STRING) {
+            m_deposit_flag = vpiNoDelay;
+        }
+#endif
+    }
 
     const char *get_signal_value_binstr() override;
     const char *get_signal_value_str() override;
     double get_signal_value_real() override;
     long get_signal_value_long() override;
+    int get_signal_value_bytes(gpi_vecval_t *buf, int n_words) override;
 
     int set_signal_value(const int32_t value, gpi_set_action_t action) override;
     int set_signal_value(const double value, gpi_set_action_t action) override;
@@ -190,6 +217,8 @@ class VpiSignalObjHdl : public GpiSignalObjHdl {
                                 gpi_set_action_t action) override;
     int set_signal_value_str(std::string &value,
                              gpi_set_action_t action) override;
+    int set_signal_value_vector(const gpi_vecval_t *buf, int n_bits,
+                                gpi_set_action_t action) override;
 
     /* Value change callback accessor */
     int initialise(const std::string &name,
@@ -198,8 +227,38 @@ class VpiSignalObjHdl : public GpiSignalObjHdl {
                                              int (*function)(void *),
                                              void *cb_data) override;
 
+#ifdef VERILATOR
+    ~VpiSignalObjHdl() override;
+
+    // Find the storage of the signal in the model, so its value is accessed
+    // directly rather than through VPI, see cocotbvpi_set_direct_lookup()
+    void init_direct_access(const std::string &fq_name);
+    // Write the value deposited in this time step
+    void apply_direct_deposit();
+#endif
+
   private:
     int set_signal_value(s_vpi_value value, gpi_set_action_t action);
+
+    // Flag of vpi_put_value() for GPI_DEPOSIT, resolved at creation so
+    // deposits don't query the object
+    PLI_INT32 m_deposit_flag = vpiInertialDelay;
+
+#ifdef VERILATOR
+    bool can_write_direct(gpi_set_action_t action) const;
+    uint32_t read_direct_word(size_t index) const;
+    void write_direct(const uint32_t *words);
+    // Write m_direct_value now or at the end of the region, as VPI would
+    int set_direct_value(gpi_set_action_t action);
+    // Forget the pending direct deposit, which a later put replaces
+    void cancel_direct_deposit();
+
+    void *m_direct = nullptr;  // Storage in the model, NULL to use VPI
+    int m_direct_unit = 0;     // Size of the words of the storage, in bytes
+    bool m_direct_writable = false;
+    bool m_direct_queued = false;
+    std::vector<uint32_t> m_direct_value;
+#endif
 };
 
 class VpiIterator : public GpiIterator {
@@ -210,8 +269,15 @@ class VpiIterator : public GpiIterator {
 
     Status next_handle(std::string &name, GpiObjHdl **hdl,
                        void **raw_hdl) override;
+    bool supports_next_name() override { return true; }
+    Status next_name(std::string &name, gpi_objtype_t *type,
+                     void **raw_hdl) override;
 
   private:
+    // Finds the next object and its name, without creating a handle for it
+    Status next_object(std::string &name, std::string &fq_name,
+                       vpiHandle *next_obj, void **raw_hdl);
+
     vpiHandle m_iterator;
     static std::map<int32_t, std::vector<int32_t>>
         iterate_over;               /* Possible mappings */
@@ -281,6 +347,10 @@ class VpiImpl : public GpiImplInterface {
     void get_sim_precision(int32_t *precision) override;
     const char *get_simulator_product() override;
     const char *get_simulator_version() override;
+#ifdef VERILATOR
+    int set_trace_enabled(bool enable) override;
+    int save_checkpoint(const std::string &path) override;
+#endif
 
     /* Hierarchy related */
     GpiObjHdl *get_root_handle(const char *name) override;
@@ -306,6 +376,9 @@ class VpiImpl : public GpiImplInterface {
     GpiObjHdl *create_gpi_obj_from_handle(vpiHandle new_hdl,
                                           const std::string &name,
                                           const std::string &fq_name);
+    // The type of the object create_gpi_obj_from_handle() would create,
+    // GPI_UNKNOWN if it would not create one
+    gpi_objtype_t get_gpi_obj_type(vpiHandle new_hdl, const std::string &name);
 
     static bool compare_generate_labels(const std::string &a,
                                         const std::string &b);
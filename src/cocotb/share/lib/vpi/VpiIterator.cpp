@@ -262,9 +262,10 @@ GpiIterator::Status VpiPackageIterator::next_handle(std::string &,
     return GpiIterator::NATIVE;
 }
 
-GpiIterator::Status VpiIterator::next_handle(std::string &name, GpiObjHdl **hdl,
+GpiIterator::Status VpiIterator::next_object(std::string &name,
+                                             std::string &fq_name,
+                                             vpiHandle *next_obj,
                                              void **raw_hdl) {
-    GpiObjHdl *new_obj;
     vpiHandle obj;
     vpiHandle iter_obj = m_parent->get_handle<vpiHandle>();
 
@@ -379,7 +380,7 @@ GpiIterator::Status VpiIterator::next_handle(std::string &name, GpiObjHdl **hdl,
        return and GPI will try other implementations with the name
        */
 
-    std::string fq_name = m_parent->get_fullname();
+    fq_name = m_parent->get_fullname();
     VpiImpl *vpi_impl = reinterpret_cast<VpiImpl *>(m_impl);
 
     if (obj_type == GPI_GENARRAY) {
@@ -406,10 +407,51 @@ GpiIterator::Status VpiIterator::next_handle(std::string &name, GpiObjHdl **hdl,
     }
 
     LOG_DEBUG("vpi_scan found '%s'", fq_name.c_str());
-    new_obj = vpi_impl->create_gpi_obj_from_handle(obj, name, fq_name);
+    *next_obj = obj;
+    return GpiIterator::NATIVE;
+}
+
+GpiIterator::Status VpiIterator::next_handle(std::string &name, GpiObjHdl **hdl,
+                                             void **raw_hdl) {
+    std::string fq_name;
+    vpiHandle obj;
+
+    GpiIterator::Status ret = next_object(name, fq_name, &obj, raw_hdl);
+    if (ret != GpiIterator::NATIVE) {
+        return ret;
+    }
+
+    VpiImpl *vpi_impl = reinterpret_cast<VpiImpl *>(m_impl);
+    GpiObjHdl *new_obj =
+        vpi_impl->create_gpi_obj_from_handle(obj, name, fq_name);
     if (new_obj) {
         *hdl = new_obj;
         return GpiIterator::NATIVE;
     } else
         return GpiIterator::NOT_NATIVE;
 }
+
+GpiIterator::Status VpiIterator::next_name(std::string &name,
+                                           gpi_objtype_t *type,
+                                           void **raw_hdl) {
+    std::string fq_name;
+    vpiHandle obj;
+
+    GpiIterator::Status ret = next_object(name, fq_name, &obj, raw_hdl);
+    if (ret != GpiIterator::NATIVE) {
+        return ret;
+    }
+
+    VpiImpl *vpi_impl = reinterpret_cast<VpiImpl *>(m_impl);
+    *type = vpi_impl->get_gpi_obj_type(obj, name);
+
+    /* The handle is looked up again by name if the object is needed */
+    if (obj != m_parent->get_handle<vpiHandle>()) {
+        vpi_free_object(obj);
+    }
+
+    if (*type == GPI_UNKNOWN) {
+        return GpiIterator::NOT_NATIVE;
+    }
+    return GpiIterator::NATIVE;
+}
@@ -30,10 +30,84 @@
 #include <assert.h>
 
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 #include "VpiImpl.h"
 
+/* vpi_get_value_array() and vpi_put_value_array() are only provided by some
+ * simulators, so are referenced weakly to check for them at runtime, where the
+ * platform allows it. Simulators may also provide stubs only reporting an
+ * error, so the first error disables them for the rest of the simulation. */
+#if defined(__ELF__)
+#pragma weak vpi_get_value_array
+#pragma weak vpi_put_value_array
+#define VPI_HAS_VALUE_ARRAY() (vpi_get_value_array && vpi_put_value_array)
+#else
+#define VPI_HAS_VALUE_ARRAY() false
+#endif
+
+static bool value_array_supported = true;
+
+static bool check_value_array_error(const char *func) {
+    s_vpi_error_info info;
+    memset(&info, 0, sizeof(info));
+    if (vpi_chk_error(&info) == 0 && info.code == 0) {
+        return true;
+    }
+    LOG_DEBUG("VPI: %s failed (%s), accessing array elements one by one", func,
+              info.message ? info.message : "no message");
+    value_array_supported = false;
+    return false;
+}
+
+bool VpiArrayObjHdl::is_whole_array() {
+    // Pseudo-handles to a dimension of a multi-dimensional array share the
+    // handle of the whole array, which must not be accessed with their indices
+    const char *hdl_name =
+        vpi_get_str(vpiName, GpiObjHdl::get_handle<vpiHandle>());
+    return hdl_name && strlen(hdl_name) == strlen(m_name);
+}
+
+bool VpiArrayObjHdl::get_array_values(int32_t first, int count,
+                                      gpi_vecval_t *buf) {
+    if (!value_array_supported || !VPI_HAS_VALUE_ARRAY() || !is_whole_array()) {
+        return false;
+    }
+
+    s_vpi_arrayvalue value;
+    value.format = vpiVectorVal;
+    value.flags = vpiUserAllocFlag;
+    value.value.vectors = reinterpret_cast<p_vpi_vecval>(buf);
+    PLI_INT32 index = first;
+
+    vpi_get_value_array(GpiObjHdl::get_handle<vpiHandle>(), &value, &index,
+                        static_cast<PLI_UINT32>(count));
+    return check_value_array_error("vpi_get_value_array");
+}
+
+bool VpiArrayObjHdl::set_array_values(int32_t first, int count,
+                                      const gpi_vecval_t *buf,
+                                      gpi_set_action_t action) {
+    // Values are put without a delay, so only match writes without one
+    if (action != GPI_NO_DELAY || !value_array_supported ||
+        !VPI_HAS_VALUE_ARRAY() || !is_whole_array()) {
+        return false;
+    }
+
+    s_vpi_arrayvalue value;
+    value.format = vpiVectorVal;
+    value.flags = 0;
+    // vpi_put_value_array only reads the vectors
+    value.value.vectors =
+        reinterpret_cast<p_vpi_vecval>(const_cast<gpi_vecval_t *>(buf));
+    PLI_INT32 index = first;
+
+    vpi_put_value_array(GpiObjHdl::get_handle<vpiHandle>(), &value, &index,
+                        static_cast<PLI_UINT32>(count));
+    return check_value_array_error("vpi_put_value_array");
+}
+
 int VpiArrayObjHdl::initialise(const std::string &name,
                                const std::string &fq_name) {
     vpiHandle hdl = GpiObjHdl::get_handle<vpiHandle>();
@@ -116,23 +190,19 @@ int VpiArrayObjHdl::initialise(const std::string &name,
 }
 
 const char *VpiObjHdl::get_definition_name() {
-    if (m_definition_name.empty()) {
+    if (!m_definition_name) {
         auto hdl = get_handle<vpiHandle>();
         auto *str = vpi_get_str(vpiDefName, hdl);
-        if (str != NULL) {
-            m_definition_name = str;
-        }
+        m_definition_name = gpi_intern_string(str != NULL ? str : "");
     }
-    return m_definition_name.c_str();
+    return m_definition_name;
 }
 
 const char *VpiObjHdl::get_definition_file() {
-    if (m_definition_file.empty()) {
+    if (!m_definition_file) {
         auto hdl = GpiObjHdl::get_handle<vpiHandle>();
         auto *str = vpi_get_str(vpiDefFile, hdl);
-        if (str != NULL) {
-            m_definition_file = str;
-        }
+        m_definition_file = gpi_intern_string(str != NULL ? str : "");
     }
-    return m_definition_file.c_str();
+    return m_definition_file;
 }
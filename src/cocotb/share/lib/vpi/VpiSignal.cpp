@@ -29,6 +29,7 @@
 
 #include <assert.h>
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "VpiImpl.h"
@@ -37,6 +38,7 @@
 int VpiSignalObjHdl::initialise(const std::string &name,
                                 const std::string &fq_name) {
     int32_t type = vpi_get(vpiType, GpiObjHdl::get_handle<vpiHandle>());
+    m_length = vpi_get(vpiSize, GpiObjHdl::get_handle<vpiHandle>());
     if ((vpiIntVar == type) || (vpiIntegerVar == type) ||
         (vpiIntegerNet == type) || (vpiRealNet == type)) {
         m_num_elems = 1;
@@ -119,7 +121,163 @@ int VpiSignalObjHdl::initialise(const std::string &name,
     return GpiObjHdl::initialise(name, fq_name);
 }
 
+#ifdef VERILATOR
+/* Direct access to the signals of a Verilator model
+ *
+ * VerilatedVpi decodes the handle and the value format on each access, and
+ * queues deposits until doInertialPuts(). The harness of the model, which is
+ * built with the Verilator headers, can instead give the storage of the
+ * public variables found through the symbol table of the model, so values
+ * are read and written in place. Values are 2-state, in 1, 2, 4 or 8 byte
+ * words for up to 64 bits, or in 32-bit words for wider ones, with the bits
+ * above the size of the signal always 0.
+ *
+ * Deposits are written when the harness applies the VPI inertial puts, so
+ * they take effect at the same point.
+ */
+
+// Returns the storage of *fq_name* and sets *n_bits*, *unit* to the size of
+// its words and *writable*, or returns NULL if it can't be accessed directly
+typedef void *(*direct_lookup_t)(const char *fq_name, int *n_bits, int *unit,
+                                 int *writable);
+
+static direct_lookup_t direct_lookup = nullptr;
+static std::vector<VpiSignalObjHdl *> direct_deposits;
+// Set when the model was written to, so the harness evaluates it again
+static bool direct_written = false;
+
+extern "C" COCOTBVPI_EXPORT void cocotbvpi_set_direct_lookup(
+    direct_lookup_t lookup) {
+    direct_lookup = lookup;
+}
+
+extern "C" COCOTBVPI_EXPORT void cocotbvpi_apply_direct_writes() {
+    for (auto signal : direct_deposits) {
+        signal->apply_direct_deposit();
+    }
+    direct_deposits.clear();
+}
+
+/* Returns whether the model was written to since the last call */
+extern "C" COCOTBVPI_EXPORT int cocotbvpi_take_direct_writes() {
+    bool written = direct_written;
+    direct_written = false;
+    return written;
+}
+
+VpiSignalObjHdl::~VpiSignalObjHdl() { cancel_direct_deposit(); }
+
+void VpiSignalObjHdl::init_direct_access(const std::string &fq_name) {
+    if (!direct_lookup || get_type() == GPI_REAL || get_type() == GPI_STRING) {
+        return;
+    }
+
+    int n_bits, unit, writable;
+    void *storage = direct_lookup(fq_name.c_str(), &n_bits, &unit, &writable);
+    // A mismatch would mean a lookup of another variable of the same name
+    if (!storage || n_bits != m_length || n_bits <= 0 ||
+        (unit != 4 && n_bits > 8 * unit)) {
+        return;
+    }
+
+    m_direct = storage;
+    m_direct_unit = unit;
+    m_direct_writable = writable && !get_const();
+    m_direct_value.resize(static_cast<size_t>((n_bits + 31) / 32));
+    LOG_DEBUG("VPI: Accessing %s directly in the model", fq_name.c_str());
+}
+
+bool VpiSignalObjHdl::can_write_direct(gpi_set_action_t action) const {
+    return m_direct_writable &&
+           (action == GPI_DEPOSIT || action == GPI_NO_DELAY);
+}
+
+uint32_t VpiSignalObjHdl::read_direct_word(size_t index) const {
+    switch (m_direct_unit) {
+        case 1:
+            return *static_cast<const uint8_t *>(m_direct);
+        case 2:
+            return *static_cast<const uint16_t *>(m_direct);
+        case 4:
+            return static_cast<const uint32_t *>(m_direct)[index];
+        default:
+            return static_cast<uint32_t>(
+                *static_cast<const uint64_t *>(m_direct) >> (32 * index));
+    }
+}
+
+void VpiSignalObjHdl::write_direct(const uint32_t *words) {
+    // The model relies on the bits above the size of the signal being 0
+    size_t last = m_direct_value.size() - 1;
+    uint32_t mask = m_length % 32 ? (1u << (m_length % 32)) - 1 : ~0u;
+
+    switch (m_direct_unit) {
+        case 1:
+            *static_cast<uint8_t *>(m_direct) =
+                static_cast<uint8_t>(words[0] & mask);
+            break;
+        case 2:
+            *static_cast<uint16_t *>(m_direct) =
+                static_cast<uint16_t>(words[0] & mask);
+            break;
+        case 4: {
+            auto storage = static_cast<uint32_t *>(m_direct);
+            memcpy(storage, words, 4 * last);
+            storage[last] = words[last] & mask;
+            break;
+        }
+        case 8: {
+            uint64_t value = words[last] & mask;
+            if (last) {
+                value = (value << 32) | words[0];
+            }
+            *static_cast<uint64_t *>(m_direct) = value;
+            break;
+        }
+    }
+    direct_written = true;
+}
+
+int VpiSignalObjHdl::set_direct_value(gpi_set_action_t action) {
+    if (action == GPI_NO_DELAY) {
+        write_direct(m_direct_value.data());
+    } else if (!m_direct_queued) {
+        m_direct_queued = true;
+        direct_deposits.push_back(this);
+    }
+    return 0;
+}
+
+void VpiSignalObjHdl::cancel_direct_deposit() {
+    if (m_direct_queued) {
+        m_direct_queued = false;
+        direct_deposits.erase(std::remove(direct_deposits.begin(),
+                                          direct_deposits.end(), this),
+                              direct_deposits.end());
+    }
+}
+
+void VpiSignalObjHdl::apply_direct_deposit() {
+    m_direct_queued = false;
+    write_direct(m_direct_value.data());
+}
+#endif
+
 const char *VpiSignalObjHdl::get_signal_value_binstr() {
+#ifdef VERILATOR
+    if (m_direct) {
+        // Valid until the next call, as for vpi_get_value()
+        static std::string binstr;
+        binstr.resize(static_cast<size_t>(m_length));
+        for (int i = 0; i < m_length; i++) {
+            int bit = m_length - 1 - i;
+            uint32_t word = read_direct_word(static_cast<size_t>(bit / 32));
+            binstr[static_cast<size_t>(i)] = (word >> (bit % 32)) & 1 ? '1'
+                                                                      : '0';
+        }
+        return binstr.c_str();
+    }
+#endif
     s_vpi_value value_s = {vpiBinStrVal, {NULL}};
 
     vpi_get_value(GpiObjHdl::get_handle<vpiHandle>(), &value_s);
@@ -128,6 +286,46 @@ const char *VpiSignalObjHdl::get_signal_value_binstr() {
     return value_s.value.str;
 }
 
+int VpiSignalObjHdl::get_signal_value_bytes(gpi_vecval_t *buf, int n_words) {
+    static_assert(sizeof(gpi_vecval_t) == sizeof(s_vpi_vecval),
+                  "gpi_vecval_t must match the layout of s_vpi_vecval");
+
+    int words = (m_length + 31) / 32;
+    if (!buf || n_words < words) {
+        return m_length;
+    }
+
+#ifdef VERILATOR
+    if (m_direct) {
+        for (int i = 0; i < words; i++) {
+            buf[i].aval = read_direct_word(static_cast<size_t>(i));
+            buf[i].bval = 0;
+        }
+        return m_length;
+    }
+#endif
+
+    s_vpi_value value_s = {vpiVectorVal, {NULL}};
+
+    vpi_get_value(GpiObjHdl::get_handle<vpiHandle>(), &value_s);
+    check_vpi_error();
+    if (!value_s.value.vector) {
+        return -1;
+    }
+
+    memcpy(buf, value_s.value.vector,
+           sizeof(gpi_vecval_t) * static_cast<size_t>(words));
+
+    // Bits above the size of the object are undefined in VPI
+    if (m_length % 32) {
+        uint32_t mask = (1u << (m_length % 32)) - 1;
+        buf[words - 1].aval &= mask;
+        buf[words - 1].bval &= mask;
+    }
+
+    return m_length;
+}
+
 const char *VpiSignalObjHdl::get_signal_value_str() {
     s_vpi_value value_s = {vpiStringVal, {NULL}};
 
@@ -147,6 +345,12 @@ double VpiSignalObjHdl::get_signal_value_real() {
 }
 
 long VpiSignalObjHdl::get_signal_value_long() {
+#ifdef VERILATOR
+    // The signedness of shorter signals is only known to VPI
+    if (m_direct && m_length == 32) {
+        return static_cast<int32_t>(read_direct_word(0));
+    }
+#endif
     s_vpi_value value_s = {vpiIntVal, {NULL}};
 
     vpi_get_value(GpiObjHdl::get_handle<vpiHandle>(), &value_s);
@@ -157,6 +361,15 @@ long VpiSignalObjHdl::get_signal_value_long() {
 
 // Value related functions
 int VpiSignalObjHdl::set_signal_value(int32_t value, gpi_set_action_t action) {
+#ifdef VERILATOR
+    if (can_write_direct(action)) {
+        // Sign extended, and truncated to the size of the signal
+        std::fill(m_direct_value.begin(), m_direct_value.end(),
+                  value < 0 ? ~0u : 0u);
+        m_direct_value[0] = static_cast<uint32_t>(value);
+        return set_direct_value(action);
+    }
+#endif
     s_vpi_value value_s;
 
     value_s.value.integer = static_cast<PLI_INT32>(value);
@@ -176,6 +389,22 @@ int VpiSignalObjHdl::set_signal_value(double value, gpi_set_action_t action) {
 
 int VpiSignalObjHdl::set_signal_value_binstr(std::string &value,
                                              gpi_set_action_t action) {
+#ifdef VERILATOR
+    // X and Z are left for VPI to map to 2-state
+    if (can_write_direct(action) &&
+        value.size() == static_cast<size_t>(m_length) &&
+        value.find_first_not_of("01") == std::string::npos) {
+        std::fill(m_direct_value.begin(), m_direct_value.end(), 0u);
+        for (int i = 0; i < m_length; i++) {
+            int bit = m_length - 1 - i;
+            if (value[static_cast<size_t>(i)] == '1') {
+                m_direct_value[static_cast<size_t>(bit / 32)] |=
+                    1u << (bit % 32);
+            }
+        }
+        return set_direct_value(action);
+    }
+#endif
     s_vpi_value value_s;
 
     std::vector<char> writable(value.begin(), value.end());
@@ -200,29 +429,55 @@ int VpiSignalObjHdl::set_signal_value_str(std::string &value,
     return set_signal_value(value_s, action);
 }
 
+int VpiSignalObjHdl::set_signal_value_vector(const gpi_vecval_t *buf,
+                                             int n_bits,
+                                             gpi_set_action_t action) {
+    if (n_bits != m_length) {
+        LOG_ERROR(
+            "VPI: Unable to set %s from a vector of %d bits, %d are needed",
+            m_name, n_bits, m_length);
+        return -1;
+    }
+
+#ifdef VERILATOR
+    if (can_write_direct(action) &&
+        std::all_of(buf, buf + m_direct_value.size(),
+                    [](const gpi_vecval_t &word) { return word.bval == 0; })) {
+        for (size_t i = 0; i < m_direct_value.size(); i++) {
+            m_direct_value[i] = buf[i].aval;
+        }
+        return set_direct_value(action);
+    }
+#endif
+
+    s_vpi_value value_s;
+
+    // vpi_put_value only reads the vector
+    value_s.value.vector =
+        reinterpret_cast<p_vpi_vecval>(const_cast<gpi_vecval_t *>(buf));
+    value_s.format = vpiVectorVal;
+
+    return set_signal_value(value_s, action);
+}
+
 int VpiSignalObjHdl::set_signal_value(s_vpi_value value_s,
                                       gpi_set_action_t action) {
     PLI_INT32 vpi_put_flag = -1;
     s_vpi_time vpi_time_s;
 
+#ifdef VERILATOR
+    // The direct writes are applied after those through VPI, so would
+    // otherwise overwrite this newer value
+    cancel_direct_deposit();
+#endif
+
     vpi_time_s.type = vpiSimTime;
     vpi_time_s.high = 0;
     vpi_time_s.low = 0;
 
     switch (action) {
         case GPI_DEPOSIT:
-#if defined(MODELSIM) || defined(IUS)
-            // Xcelium and Questa do not like setting string variables using
-            // vpiInertialDelay.
-            if (vpiStringVar ==
-                vpi_get(vpiType, GpiObjHdl::get_handle<vpiHandle>())) {
-                vpi_put_flag = vpiNoDelay;
-            } else {
-                vpi_put_flag = vpiInertialDelay;
-            }
-#else
-            vpi_put_flag = vpiInertialDelay;
-#endif
+            vpi_put_flag = m_deposit_flag;
             break;
         case GPI_FORCE:
             vpi_put_flag = vpiForceFlag;
@@ -0,0 +1,124 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Control of the shared-memory transactor bridge.
+
+The bridge is a GPI library which exchanges transactions with an external process
+through rings in shared memory, driving and sampling signals on each clock edge
+without running Python.
+It is loaded by setting :envvar:`GPI_EXTRA` to
+``$(cocotb-config --lib-dir)/libcocotbshmbridge.so:cocotbshmbridge_entry_point``
+and configured with the :envvar:`GPI_SHM_BRIDGE` environment variables.
+The layout of the shared memory is described in :file:`cocotb_shm_bridge.h`,
+in the directory given by ``cocotb-config --share``, under :file:`include`.
+
+Only the transactions the external process flags as exceptions reach Python,
+through the handler set with :func:`set_exception_handler`.
+
+.. versionadded:: 2.0
+"""
+
+import ctypes
+import logging
+from pathlib import Path
+from typing import Callable, Dict, Optional
+
+_log = logging.getLogger("cocotb.shm_bridge")
+
+_LIB_PATH = Path(__file__).parent / "libs" / "libcocotbshmbridge.so"
+
+_HANDLER_TYPE = ctypes.CFUNCTYPE(
+    ctypes.c_int,
+    ctypes.POINTER(ctypes.c_uint32),
+    ctypes.c_uint32,
+    ctypes.POINTER(ctypes.c_uint32),
+    ctypes.c_uint32,
+)
+
+
+class _Stats(ctypes.Structure):
+    _fields_ = [
+        ("driven", ctypes.c_uint64),
+        ("sampled", ctypes.c_uint64),
+        ("exceptions", ctypes.c_uint64),
+        ("full_waits", ctypes.c_uint64),
+        ("errors", ctypes.c_uint64),
+    ]
+
+
+_lib: Optional[ctypes.CDLL] = None
+# Kept alive while the bridge may call it
+_handler: Optional[Callable[..., int]] = None
+
+
+def _get_lib() -> ctypes.CDLL:
+    global _lib
+    if _lib is None:
+        # Already loaded through GPI_EXTRA, so this only gets a reference
+        _lib = ctypes.CDLL(str(_LIB_PATH))
+        _lib.cocotbshmbridge_set_exception_handler.argtypes = [_HANDLER_TYPE]
+        _lib.cocotbshmbridge_set_exception_handler.restype = None
+        _lib.cocotbshmbridge_get_stats.argtypes = [ctypes.POINTER(_Stats)]
+        _lib.cocotbshmbridge_get_stats.restype = None
+    return _lib
+
+
+def set_exception_handler(
+    handler: Optional[Callable[[bytes], Optional[bytes]]],
+) -> None:
+    """Set the function handling the exception transactions of the bridge.
+
+    *handler* is called with the payload of each transaction the external process
+    flags with ``COCOTB_SHM_TXN_EXCEPTION``,
+    in the read-write phase of the time step the bridge takes the transaction.
+    It returns the payload of the response, whose length must be a multiple of 4 bytes,
+    or ``None`` not to respond.
+    It is not a :term:`python:coroutine` and can't ``await``.
+
+    Exceptions raised by *handler* are logged, and no response is written.
+    Pass ``None`` to drop exception transactions.
+    """
+    global _handler
+
+    if handler is None:
+        _handler = None
+        _get_lib().cocotbshmbridge_set_exception_handler(_HANDLER_TYPE())
+        return
+
+    def c_handler(
+        payload: "ctypes._Pointer[ctypes.c_uint32]",
+        n_words: int,
+        response: "ctypes._Pointer[ctypes.c_uint32]",
+        max_words: int,
+    ) -> int:
+        try:
+            result = handler(ctypes.string_at(payload, 4 * n_words))
+            if result is None:
+                return -1
+            if len(result) % 4 or len(result) > 4 * max_words:
+                raise ValueError(
+                    f"Response of {len(result)} bytes is not made of at most "
+                    f"{max_words} 32-bit words"
+                )
+            ctypes.memmove(response, result, len(result))
+            return len(result) // 4
+        except Exception:
+            _log.exception("Exception handler of the shared-memory bridge failed")
+            return -1
+
+    _handler = _HANDLER_TYPE(c_handler)
+    _get_lib().cocotbshmbridge_set_exception_handler(_handler)
+
+
+def get_stats() -> Dict[str, int]:
+    """Get the numbers of transactions handled by the bridge.
+
+    The returned dictionary has the keys ``driven``, ``sampled``, ``exceptions``,
+    ``full_waits``, the number of clock edges the bridge waited for the external
+    process to make space for the samples, and ``errors``, the number of
+    transactions dropped.
+    """
+    stats = _Stats()
+    _get_lib().cocotbshmbridge_get_stats(ctypes.byref(stats))
+    return {name: getattr(stats, name) for name, _ in _Stats._fields_}
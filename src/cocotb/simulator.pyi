@@ -4,8 +4,15 @@
 
 # generated with mypy's stubgen script
 
-from typing import Any
+import os
+from typing import Any, Callable, Sequence
 
+ACCESS_BINSTR: int
+ACCESS_INT: int
+ACCESS_LOGIC: int
+ACCESS_LONG: int
+ACCESS_REAL: int
+ACCESS_STR: int
 DRIVERS: int
 ENUM: int
 GENARRAY: int
@@ -32,11 +39,13 @@ RANGE_NO_DIR: int
 
 class gpi_cb_hdl:
     def deregister(self) -> None: ...
+    def get_value_bytes(self) -> bytes | None: ...
     def __eq__(self, other: object) -> bool: ...
     def __ne__(self, other: object) -> bool: ...
     def __hash__(self) -> int: ...
 
 class gpi_iterator_hdl:
+    def next_names(self, count: int, /) -> list[tuple[str, int]]: ...
     def __eq__(self, other: object) -> bool: ...
     def __ne__(self, other: object) -> bool: ...
     def __hash__(self) -> int: ...
@@ -44,6 +53,13 @@ class gpi_iterator_hdl:
     def __next__(self) -> gpi_sim_hdl: ...
 
 class gpi_sim_hdl:
+    def get_accessor(self, format: int, /) -> GpiValueAccessor: ...
+    def dump_array_to_file(
+        self, path: str | os.PathLike[str], first: int, count: int, /
+    ) -> None: ...
+    def get_array_val_bytes_into(
+        self, first: int, count: int, buffer: bytearray | memoryview, /
+    ) -> int: ...
     def get_const(self) -> bool: ...
     def get_definition_file(self) -> str: ...
     def get_definition_name(self) -> str: ...
@@ -54,13 +70,50 @@ class gpi_sim_hdl:
     def get_num_elems(self) -> int: ...
     def get_range(self) -> tuple[int, int, int]: ...
     def get_signal_val_binstr(self) -> str: ...
+    def get_signal_val_bytes(self) -> bytes | None: ...
+    def get_signal_val_bytes_into(self, buffer: bytearray | memoryview, /) -> int: ...
     def get_signal_val_long(self) -> int: ...
     def get_signal_val_real(self) -> float: ...
     def get_signal_val_str(self) -> bytes: ...
     def get_type(self) -> int: ...
     def get_type_string(self) -> str: ...
     def iterate(self, mode: int) -> gpi_iterator_hdl: ...
+    def load_array_from_file(
+        self,
+        action: int,
+        path: str | os.PathLike[str],
+        offset: int,
+        first: int,
+        count: int,
+        /,
+    ) -> None: ...
+    def queue_signal_val_binstr(self, action: int, value: str, /) -> None: ...
+    def queue_signal_val_bytes(
+        self,
+        action: int,
+        width: int,
+        value: bytes | bytearray | memoryview | int,
+        /,
+    ) -> None: ...
+    def queue_signal_val_int(self, action: int, value: int, /) -> None: ...
+    def queue_signal_val_real(self, action: int, value: float, /) -> None: ...
+    def queue_signal_val_str(self, action: int, value: bytes, /) -> None: ...
+    def set_array_val_bytes(
+        self,
+        action: int,
+        first: int,
+        count: int,
+        values: bytes | bytearray | memoryview,
+        /,
+    ) -> None: ...
     def set_signal_val_binstr(self, action: int, value: str) -> None: ...
+    def set_signal_val_bytes(
+        self,
+        action: int,
+        width: int,
+        value: bytes | bytearray | memoryview | int,
+        /,
+    ) -> None: ...
     def set_signal_val_int(self, action: int, value: int) -> None: ...
     def set_signal_val_real(self, action: int, value: float) -> None: ...
     def set_signal_val_str(self, action: int, value: bytes) -> None: ...
@@ -68,14 +121,25 @@ class gpi_sim_hdl:
     def __ne__(self, other: object) -> bool: ...
     def __hash__(self) -> int: ...
 
+def apply_queued_writes() -> int: ...
+def clear_queued_writes() -> None: ...
+def get_cb_pool_stats() -> dict[str, int]: ...
+def get_handle_store_stats() -> dict[str, int]: ...
+def get_num_queued_writes() -> int: ...
+def get_num_worker_threads() -> int: ...
 def get_precision() -> int: ...
 def get_root_handle(name: str | None) -> gpi_sim_hdl | None: ...
+def get_sim_steps() -> int: ...
 def get_sim_time() -> tuple[int, int]: ...
 def get_simulator_product() -> str: ...
 def get_simulator_version() -> str: ...
+def get_stats() -> dict[str, Any]: ...
+def is_profile_enabled() -> bool: ...
 def is_running() -> bool: ...
 def log_level(level: int) -> None: ...
 def package_iterate() -> gpi_iterator_hdl: ...
+def profile_begin(name: str, category: str, /) -> None: ...
+def profile_end() -> None: ...
 def register_nextstep_callback(func, *args: Any) -> gpi_cb_hdl: ...
 def register_readonly_callback(func, *args: Any) -> gpi_cb_hdl: ...
 def register_rwsynch_callback(func, *args: Any) -> gpi_cb_hdl: ...
@@ -83,11 +147,64 @@ def register_timed_callback(time: int, func, *args: Any) -> gpi_cb_hdl: ...
 def register_value_change_callback(
     signal: gpi_sim_hdl, func, edge: int, *args: Any
 ) -> gpi_cb_hdl: ...
+def register_value_match_callback(
+    signal: gpi_sim_hdl,
+    edge_signal: gpi_sim_hdl | None,
+    edge: int,
+    value: bytes,
+    mask: bytes,
+    negate: bool,
+    func,
+    *args: Any,
+) -> gpi_cb_hdl: ...
+def save_checkpoint(path: str, /) -> None: ...
+def set_callback_batching(
+    function: Callable[[Any], None] | None,
+    handler: Callable[[list[Any]], None] | None,
+    /,
+) -> None: ...
+def set_cb_pool_capacity(capacity: int, /) -> None: ...
+def set_stats_enabled(enabled: bool, /) -> None: ...
+def set_trace_enabled(enabled: bool, /) -> None: ...
 def stop_simulator() -> None: ...
 
 class cpp_clock:
     def __init__(self, signal: gpi_sim_hdl) -> None: ...
-    def start(self, period_steps: int, high_steps: int, start_high: bool) -> None: ...
+    def start(
+        self, period_steps: int, high_steps: int, start_high: bool, cycles: int = 0
+    ) -> None: ...
     def stop(self) -> None: ...
 
 def clock_create(hdl: gpi_sim_hdl) -> cpp_clock: ...
+
+class GpiSignalGroup:
+    def get_num_signals(self) -> int: ...
+    def get_packed_size(self) -> int: ...
+    def read_bytes_into(self, buffer: bytearray | memoryview, /) -> None: ...
+    def read_int_into(self, buffer: Any, /) -> None: ...
+    def write_bytes(
+        self, action: int, buffer: bytes | bytearray | memoryview, /
+    ) -> None: ...
+    def write_int(self, action: int, buffer: Any, /) -> None: ...
+
+def signal_group_create(signals: Sequence[gpi_sim_hdl], /) -> GpiSignalGroup: ...
+
+class GpiValueAccessor:
+    def __call__(self) -> Any: ...
+
+class GpiRecorder:
+    def drain(self) -> tuple[bytes, bytes, bytes]: ...
+    def get_num_records(self) -> int: ...
+    def get_num_signals(self) -> int: ...
+    def get_value_words(self) -> int: ...
+    def query(self, start: int, end: int, /) -> tuple[bytes, bytes, bytes]: ...
+    def start(self) -> None: ...
+    def stop(self) -> None: ...
+
+def recorder_create(signals: Sequence[gpi_sim_hdl], /) -> GpiRecorder: ...
+
+class GpiWork:
+    def done(self) -> bool: ...
+    def result(self) -> Any: ...
+
+def submit_work(func: Callable[[], Any], /) -> GpiWork: ...
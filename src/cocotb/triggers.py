@@ -27,6 +27,7 @@
 
 """A collection of triggers which a testbench can ``await``."""
 
+import functools
 import logging
 from abc import abstractmethod
 from decimal import Decimal
@@ -437,6 +438,108 @@ class Edge(_EdgeBase):
         return signal
 
 
+class ValueMatch(GPITrigger):
+    r"""Fires when the value of *signal* matches *value*.
+
+    The value is checked on every change of *signal*, or on every *edge* if given,
+    without waking up Python until it matches.
+    This makes waiting for a handshake much cheaper than the equivalent loop:
+
+    .. code-block:: python
+
+        # instead of
+        while dut.valid.value != 1:
+            await RisingEdge(dut.clk)
+
+        # use
+        if dut.valid.value != 1:
+            await ValueMatch(dut.valid, 1, edge=RisingEdge(dut.clk))
+
+    Like awaiting *edge* in a loop, the value is not checked when the trigger is awaited,
+    only at the following changes or edges.
+
+    Args:
+        signal: The signal whose value to compare.
+        value: The value to compare against, as an unsigned integer.
+        mask: Only compare the bits set in *mask*. By default all bits are compared.
+        negate: Fire when the compared bits do not match *value* instead.
+        edge: Only check the value on this edge of a clock.
+
+    Compared bits which are ``X``, ``Z`` or any other non-``0``/``1`` state never match.
+
+    Raises:
+        TypeError: If *signal* is not a :class:`~cocotb.handle.LogicObject`.
+        ValueError: If *value* or *mask* do not fit in *signal*.
+
+    .. versionadded:: 2.0
+    """
+
+    def __init__(
+        self,
+        signal: cocotb.handle.LogicObject,
+        value: int,
+        *,
+        mask: Optional[int] = None,
+        negate: bool = False,
+        edge: Optional[_EdgeBase] = None,
+    ) -> None:
+        if not isinstance(signal, cocotb.handle.LogicObject):
+            raise TypeError(
+                f"{type(self).__qualname__} requires a LogicObject. Got {signal!r}"
+            )
+        super().__init__()
+        self.signal = signal
+        self.value = value
+        self.mask = mask
+        self.negate = negate
+        self.edge = edge
+
+        n_bits = len(signal)
+        full = (1 << n_bits) - 1
+        if mask is None:
+            mask = full
+        for name, v in (("value", value), ("mask", mask)):
+            if not 0 <= v <= full:
+                raise ValueError(
+                    f"{name} {v!r} does not fit in the {n_bits} bits of {signal!r}"
+                )
+        n_bytes = (n_bits + 7) // 8
+        self._value_bytes = value.to_bytes(n_bytes, "little")
+        self._mask_bytes = mask.to_bytes(n_bytes, "little")
+
+    def _prime(self, callback: Callable[[Trigger], None]) -> None:
+        if self._cbhdl is None:
+            if self.edge is None:
+                edge_handle = None
+                edge_type = simulator.VALUE_CHANGE
+            else:
+                edge_handle = self.edge.signal._handle
+                edge_type = type(self.edge)._edge_type
+            self._cbhdl = simulator.register_value_match_callback(
+                self.signal._handle,
+                edge_handle,
+                edge_type,
+                self._value_bytes,
+                self._mask_bytes,
+                self.negate,
+                callback,
+                self,
+            )
+            if self._cbhdl is None:
+                raise RuntimeError(f"Unable set up {str(self)} Trigger")
+        super()._prime(callback)
+
+    def __repr__(self) -> str:
+        args = [repr(self.signal), repr(self.value)]
+        if self.mask is not None:
+            args.append(f"mask={self.mask!r}")
+        if self.negate:
+            args.append("negate=True")
+        if self.edge is not None:
+            args.append(f"edge={self.edge!r}")
+        return f"{type(self).__qualname__}({', '.join(args)})"
+
+
 class _Event(Trigger):
     """Unique instance used by the Event object.
 
@@ -987,6 +1090,53 @@ class ClockCycles(Waitable["ClockCycles"]):
         return fmt.format(type(self).__qualname__, self.signal, self.num_cycles)
 
 
+class Offload(Waitable[T]):
+    r"""Call *func* with *args* and *kwargs* on a thread of the GPI worker pool.
+
+    The call starts at once and runs while the simulation continues,
+    so expensive computations, like reference models, can use other CPU cores.
+    ``await``\ ing this waits for the call to return and returns its result,
+    or raises the exception it raised.
+
+    .. code-block:: python
+
+        expected = Offload(reference_model, stimulus)
+        await drive(dut, stimulus)
+        assert dut.result.value == await expected
+
+    ``await`` always returns in the :class:`ReadWrite` phase of the current time step,
+    however long the call takes, so results are delivered at the same simulation time on every run.
+    If the call has not returned by then, the simulator waits for it.
+
+    *func* must not access the simulator.
+    The :term:`python:GIL` is released while the simulator runs, so *func* runs in parallel with it,
+    but Python code in *func* and in tasks only run in parallel on free-threaded Python builds,
+    or while *func* is in an extension which releases the GIL, like :mod:`hashlib` or NumPy.
+
+    The number of threads of the pool is set by :envvar:`GPI_WORKER_THREADS`.
+
+    Raises:
+        RuntimeError: If awaited in the :class:`ReadOnly` phase.
+
+    .. versionadded:: 2.0
+    """
+
+    def __init__(self, func: Callable[..., T], *args: Any, **kwargs: Any) -> None:
+        self.func = func
+        self._work = simulator.submit_work(functools.partial(func, *args, **kwargs))
+
+    def done(self) -> bool:
+        """Return ``True`` if the call has returned."""
+        return self._work.done()
+
+    async def _wait(self) -> T:
+        await ReadWrite()
+        return cast(T, self._work.result())
+
+    def __repr__(self) -> str:
+        return f"<{type(self).__qualname__} of {self.func!r} at {_pointer_str(self)}>"
+
+
 @overload
 async def with_timeout(
     trigger: Trigger,
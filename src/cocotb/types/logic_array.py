@@ -506,6 +506,17 @@ class LogicArray(ArrayLike[Logic]):
         self._range = Range(len(value) - 1, "downto", 0)
         return self
 
+    @classmethod
+    def _from_handle_int(cls, value: int, width: int) -> "LogicArray":
+        # Used by cocotb.handle classes to make LogicArray from packed values gotten
+        # from the simulator which are known to only hold 0s and 1s.
+        self = super().__new__(cls)
+        self._value_as_array = None
+        self._value_as_int = value
+        self._value_as_str = None
+        self._range = Range(width - 1, "downto", 0)
+        return self
+
     @property
     def range(self) -> Range:
         """:class:`Range` of the indexes of the array."""
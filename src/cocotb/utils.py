@@ -69,9 +69,7 @@ def get_sim_time(units: str = "step") -> int:
     .. versionchanged:: 1.6.0
         Support ``'step'`` as the the *units* argument to mean "simulator time step".
     """
-    timeh, timel = simulator.get_sim_time()
-
-    result = timeh << 32 | timel
+    result = simulator.get_sim_steps()
 
     if units != "step":
         result = get_time_from_sim_steps(result, units)
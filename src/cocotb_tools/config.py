@@ -95,6 +95,9 @@ def _help_vars_text() -> str:
         COCOTB_PDB_ON_EXCEPTION   Drop into the Python debugger (pdb) on exception
         COCOTB_TEST_MODULES       Module(s) to search for test functions (comma-separated)
         COCOTB_TESTCASE           Test function(s) to run (comma-separated list)
+        COCOTB_SHARD_COUNT        Number of simulations to split the tests between
+        COCOTB_SHARD_INDEX        Share of the tests run by this simulation (from 0)
+        COCOTB_SHARD_DURATIONS    Results file of an earlier run to balance the shares
         COCOTB_RESULTS_FILE       File name for xUnit XML tests results
         COCOTB_USER_COVERAGE      Collect Python user coverage (HDL for some simulators)
         COCOTB_COVERAGE_RCFILE    Configuration for user code coverage
@@ -102,11 +105,20 @@ def _help_vars_text() -> str:
         GPI
         ---
         GPI_EXTRA                       Extra libraries to load at runtime (comma-separated)
+        GPI_LOG_ASYNC                   Write native GPI log messages from a background thread
+        GPI_LOG_BINARY_FILE             Also write native GPI log messages to this binary file
+        GPI_HIERARCHY_CACHE             Cache the properties of design objects in this file
+        GPI_HIERARCHY_CACHE_KEY         Build identifier the hierarchy cache must match
+        GPI_PROFILE_FILE                Write a Chrome trace event profile to this file
+        GPI_SHM_BRIDGE                  Shared memory of the transactor bridge loaded with GPI_EXTRA
+        GPI_STATS                       Count and time the calls made through the GPI
+        GPI_WORKER_THREADS              Number of threads of the GPI worker pool
 
         Scheduler
         ---------
         COCOTB_SCHEDULER_DEBUG         Enable additional output of coroutine scheduler
         COCOTB_TRUST_INERTIAL_WRITES   Trust inertial writes rather than mock them using scheduler
+        COCOTB_BATCH_TRIGGERS          Deliver edge triggers firing together in one batch
 
         For details, see {}"""
     ).format(doclink)
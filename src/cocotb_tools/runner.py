@@ -20,6 +20,7 @@ import sys
 import tempfile
 import warnings
 from abc import ABC, abstractmethod
+from concurrent.futures import ThreadPoolExecutor
 from contextlib import suppress
 from pathlib import Path
 from typing import (
@@ -317,6 +318,7 @@ class Runner(ABC):
         timescale: Optional[Tuple[str, str]] = None,
         log_file: Optional[PathLike] = None,
         test_filter: Optional[str] = None,
+        shards: int = 1,
     ) -> Path:
         """Run the tests.
 
@@ -351,6 +353,16 @@ class Runner(ABC):
             log_file: File to write the test log to.
             test_filter: Regular expression which matches test names.
                 Only matched tests are run if this argument if given.
+            shards: Number of simulations to split the tests between, run in parallel.
+                They all run in *test_dir*, and each writes its output to
+                :file:`{log_file_stem}.{index}{log_file_suffix}` if *log_file* is given,
+                :file:`shards/shard_{index}.log` in *test_dir* otherwise.
+                The tests are balanced between the simulations using their duration
+                in the last run in *test_dir*, and the results of the simulations
+                are merged into the results XML file.
+                Can't be used with *waves* or *gui*.
+
+                .. versionadded:: 2.0
 
         Returns:
             The absolute location of the results XML file which can be
@@ -359,6 +371,13 @@ class Runner(ABC):
 
         __tracebackhide__ = True  # Hide the traceback when using pytest
 
+        if shards < 1:
+            raise ValueError(f"shards must be at least 1, got {shards}")
+        if shards > 1 and (gui or waves):
+            raise ValueError(
+                "Tests can't be run in shards with the simulator GUI or waves"
+            )
+
         if build_dir is not None:
             self.build_dir = get_abs_path(build_dir)
 
@@ -435,6 +454,12 @@ class Runner(ABC):
         else:
             results_xml_file = test_dir_path / "results.xml"
 
+        # The results of the last run are kept to balance the shards of the next
+        durations_file = test_dir_path / "shards" / "last_results.xml"
+        if shards > 1 and results_xml_file.is_file():
+            os.makedirs(durations_file.parent, exist_ok=True)
+            os.replace(results_xml_file, durations_file)
+
         with suppress(OSError):
             os.remove(results_xml_file)
 
@@ -444,12 +469,17 @@ class Runner(ABC):
 
         cmds: Sequence[_Command] = self._test_command()
         simulator_exit_code: int = 0
-        try:
-            self._execute(cmds, cwd=self.test_dir)
-        except subprocess.CalledProcessError as e:
-            # It is possible for the simulator to fail but still leave results.
-            self.log.error("Simulation failed: %d", e.returncode)
-            simulator_exit_code = e.returncode
+        if shards > 1:
+            simulator_exit_code = self._execute_shards(
+                cmds, shards, results_xml_file, durations_file
+            )
+        else:
+            try:
+                self._execute(cmds, cwd=self.test_dir)
+            except subprocess.CalledProcessError as e:
+                # It is possible for the simulator to fail but still leave results.
+                self.log.error("Simulation failed: %d", e.returncode)
+                simulator_exit_code = e.returncode
 
         # Only when running under pytest, check the results file here,
         # potentially raising an exception with failing testcases,
@@ -495,7 +525,11 @@ class Runner(ABC):
                 self._execute_cmds(cmds, cwd, f)
 
     def _execute_cmds(
-        self, cmds: Sequence[_Command], cwd: PathLike, stdout: Optional[TextIO] = None
+        self,
+        cmds: Sequence[_Command],
+        cwd: PathLike,
+        stdout: Optional[TextIO] = None,
+        env: Optional[Mapping[str, str]] = None,
     ) -> None:
         __tracebackhide__ = True  # Hide the traceback when using PyTest.
 
@@ -507,9 +541,100 @@ class Runner(ABC):
 
             stderr = None if stdout is None else subprocess.STDOUT
             subprocess.run(
-                cmd, cwd=cwd, env=self.env, check=True, stdout=stdout, stderr=stderr
+                cmd,
+                cwd=cwd,
+                env=self.env if env is None else env,
+                check=True,
+                stdout=stdout,
+                stderr=stderr,
             )
 
+    def _execute_shards(
+        self,
+        cmds: Sequence[_Command],
+        shards: int,
+        results_xml_file: Path,
+        durations_file: Path,
+    ) -> int:
+        """Run *cmds* in *shards* simulations in parallel, each running a share of the tests.
+
+        The results of the simulations are merged into *results_xml_file*.
+
+        Returns:
+            The exit code of the first simulation which failed, or 0.
+        """
+        shards_dir = Path(self.test_dir) / "shards"
+        os.makedirs(shards_dir, exist_ok=True)
+        results_files = [shards_dir / f"shard_{i}.xml" for i in range(shards)]
+        if self.log_file is None:
+            log_files = [shards_dir / f"shard_{i}.log" for i in range(shards)]
+        else:
+            log_path = Path(self.log_file)
+            log_files = [
+                log_path.with_name(f"{log_path.stem}.{i}{log_path.suffix}")
+                for i in range(shards)
+            ]
+
+        def run_shard(index: int) -> int:
+            with suppress(OSError):
+                os.remove(results_files[index])
+            env = dict(self.env)
+            env["COCOTB_SHARD_INDEX"] = str(index)
+            env["COCOTB_SHARD_COUNT"] = str(shards)
+            env["COCOTB_RESULTS_FILE"] = str(results_files[index])
+            if durations_file.is_file():
+                env["COCOTB_SHARD_DURATIONS"] = str(durations_file)
+
+            # The simulators run in parallel, the GIL is released while waiting
+            with open(log_files[index], "w") as f:
+                try:
+                    self._execute_cmds(cmds, self.test_dir, f, env)
+                except subprocess.CalledProcessError as e:
+                    return e.returncode
+            return 0
+
+        with ThreadPoolExecutor(max_workers=shards) as executor:
+            exit_codes = list(executor.map(run_shard, range(shards)))
+
+        simulator_exit_code = 0
+        merged: Optional[ET.Element] = None
+        for index in range(shards):
+            if exit_codes[index] != 0:
+                self.log.error(
+                    "Simulation of shard %d failed: %d, see %s",
+                    index,
+                    exit_codes[index],
+                    log_files[index],
+                )
+                simulator_exit_code = simulator_exit_code or exit_codes[index]
+            # It is possible for the simulator to fail but still leave results.
+            try:
+                tree = ET.parse(results_files[index])
+            except (OSError, ET.ParseError):
+                self.log.error(
+                    "Shard %d left no results, see %s", index, log_files[index]
+                )
+                simulator_exit_code = simulator_exit_code or 1
+                continue
+            if merged is None:
+                merged = tree.getroot()
+                continue
+            for ts in tree.iter("testsuite"):
+                for existing in merged.iter("testsuite"):
+                    if (existing.get("name"), existing.get("package")) == (
+                        ts.get("name"),
+                        ts.get("package"),
+                    ):
+                        # The properties are the same in every shard
+                        existing.extend(ts.iter("testcase"))
+                        break
+                else:
+                    merged.append(ts)
+
+        if merged is not None:
+            ET.ElementTree(merged).write(results_xml_file, encoding="UTF-8")
+        return simulator_exit_code
+
     def rm_build_folder(self, build_dir: Path) -> None:
         if os.path.isdir(build_dir):
             self.log.info("Removing: %s", build_dir)
@@ -1265,6 +1390,32 @@ class Verilator(Runner):
     def _get_parameter_options(parameters: Mapping[str, object]) -> _Command:
         return [f"-G{name}={value}" for name, value in parameters.items()]
 
+    def _get_threads_options(self) -> _Command:
+        # The model is verilated and run with the same number of threads
+        threads = self.env.get("VERILATOR_THREADS")
+        if not threads:
+            return []
+        return ["--threads", threads]
+
+    def _get_trace_threads_options(self) -> _Command:
+        # Traces are written from separate threads
+        trace_threads = self.env.get("VERILATOR_TRACE_THREADS")
+        if not self.waves or not trace_threads:
+            return []
+        return ["--trace-threads", trace_threads]
+
+    def _get_savable_options(self) -> _Command:
+        # The harness only saves and restores checkpoints of savable models
+        if self.env.get("VERILATOR_SAVABLE") != "1":
+            return []
+        return ["--savable", "-CFLAGS", "-DCOCOTB_VERILATOR_SAVABLE"]
+
+    def _get_restore_options(self) -> _Command:
+        restore = self.env.get("VERILATOR_RESTORE")
+        if self.env.get("VERILATOR_SAVABLE") != "1" or not restore:
+            return []
+        return ["--restore", restore]
+
     def _build_command(self) -> List[_Command]:
         self._simulator_in_path_build_only()
 
@@ -1312,6 +1463,9 @@ class Verilator(Runner):
                 f"-Wl,-rpath,{cocotb_tools.config.libs_dir} -L{cocotb_tools.config.libs_dir} -lcocotbvpi_verilator",
             ]
             + (["--trace"] if self.waves else [])
+            + self._get_trace_threads_options()
+            + self._get_threads_options()
+            + self._get_savable_options()
             + [arg for arg in self.build_args if type(arg) in (str, Verilog)]
             + self._get_define_options(self.defines)
             + self._get_include_options(self.includes)
@@ -1344,6 +1498,8 @@ class Verilator(Runner):
         return [
             [str(out_file)]
             + (["--trace"] if self.waves else [])
+            + self._get_threads_options()
+            + self._get_restore_options()
             + self.test_args
             + self.plusargs
         ]
@@ -2,9 +2,13 @@
 # Licensed under the Revised BSD License, see LICENSE for details.
 # SPDX-License-Identifier: BSD-3-Clause
 
+import json
+import shutil
 import sys
 from pathlib import Path
 
+import pytest
+
 from cocotb_tools.runner import get_runner
 
 
@@ -56,3 +60,131 @@ def test_matrix_multiplier_icarus(benchmark):
 
 def test_matrix_multiplier_nvc(benchmark):
     build_and_run_matrix_multiplier(benchmark, "nvc")
+
+
+def build_and_run_gpi_microbenchmarks(benchmark, sim, executable):
+    if shutil.which(executable) is None:
+        pytest.skip(f"{executable} is not installed")
+
+    hdl_toplevel_lang = "verilog"
+    build_args = []
+
+    if sim == "nvc":
+        build_args = ["--std=08"]
+        hdl_toplevel_lang = "vhdl"
+
+    proj_path = Path(__file__).resolve().parent / "benchmarks" / "gpi"
+    build_dir = Path("sim_build") / f"gpi_microbenchmarks_{sim}"
+    results_file = build_dir / "gpi_microbenchmarks.json"
+
+    sys.path.append(str(proj_path))
+
+    if hdl_toplevel_lang == "verilog":
+        sources = [proj_path / "gpi_bench.sv"]
+    else:
+        sources = [proj_path / "gpi_bench.vhd"]
+
+    runner = get_runner(sim)
+
+    runner.build(
+        hdl_toplevel="gpi_bench",
+        sources=sources,
+        build_args=build_args,
+        build_dir=build_dir,
+    )
+
+    def run_test():
+        runner.test(
+            hdl_toplevel="gpi_bench",
+            hdl_toplevel_lang=hdl_toplevel_lang,
+            test_module="gpi_microbenchmarks",
+            extra_env={"COCOTB_BENCHMARK_RESULTS": str(results_file.resolve())},
+        )
+
+    # The operations are timed inside the simulation, so one run is enough
+    benchmark.pedantic(run_test, rounds=1, iterations=1)
+
+    with open(results_file) as f:
+        results = json.load(f)
+    benchmark.extra_info["microbenchmarks"] = results["results"]
+    benchmark.extra_info["simulator_version"] = results["simulator_version"]
+
+
+def test_gpi_microbenchmarks_icarus(benchmark):
+    build_and_run_gpi_microbenchmarks(benchmark, "icarus", "iverilog")
+
+
+def test_gpi_microbenchmarks_verilator(benchmark):
+    build_and_run_gpi_microbenchmarks(benchmark, "verilator", "verilator")
+
+
+def test_gpi_microbenchmarks_nvc(benchmark):
+    build_and_run_gpi_microbenchmarks(benchmark, "nvc", "nvc")
+
+
+def build_and_run_hierarchy_scaling(benchmark, sim, executable, depth, fanout):
+    if shutil.which(executable) is None:
+        pytest.skip(f"{executable} is not installed")
+
+    hdl_toplevel_lang = "verilog"
+    build_args = []
+
+    if sim == "nvc":
+        build_args = ["--std=08"]
+        hdl_toplevel_lang = "vhdl"
+
+    proj_path = Path(__file__).resolve().parent / "benchmarks" / "hierarchy"
+    build_dir = Path("sim_build") / f"hierarchy_{sim}_{depth}x{fanout}"
+    results_file = build_dir / "hierarchy_scaling.json"
+
+    sys.path.append(str(proj_path))
+    import generate_design
+
+    source = generate_design.generate(build_dir, hdl_toplevel_lang, depth, fanout)
+
+    runner = get_runner(sim)
+
+    runner.build(
+        hdl_toplevel="hier_top",
+        sources=[source],
+        build_args=build_args,
+        build_dir=build_dir,
+    )
+
+    def run_test():
+        runner.test(
+            hdl_toplevel="hier_top",
+            hdl_toplevel_lang=hdl_toplevel_lang,
+            test_module="hierarchy_scaling",
+            extra_env={"COCOTB_BENCHMARK_RESULTS": str(results_file.resolve())},
+        )
+
+    # Discovery is timed inside the simulation, so one run is enough
+    benchmark.pedantic(run_test, rounds=1, iterations=1)
+
+    with open(results_file) as f:
+        results = json.load(f)
+    benchmark.extra_info.update(results)
+    benchmark.extra_info["expected_objects"] = generate_design.num_objects(
+        depth, fanout, n_signals=8, array_len=8
+    )
+
+
+HIERARCHY_SIZES = [(3, 6), (4, 8), (5, 8)]
+
+
+@pytest.mark.parametrize("depth,fanout", HIERARCHY_SIZES)
+def test_hierarchy_scaling_icarus(benchmark, depth, fanout):
+    build_and_run_hierarchy_scaling(benchmark, "icarus", "iverilog", depth, fanout)
+
+
+@pytest.mark.parametrize("depth,fanout", HIERARCHY_SIZES)
+def test_hierarchy_scaling_verilator(benchmark, depth, fanout):
+    build_and_run_hierarchy_scaling(
+        benchmark, "verilator", "verilator", depth, fanout
+    )
+
+
+@pytest.mark.parametrize("depth,fanout", HIERARCHY_SIZES)
+def test_hierarchy_scaling_nvc(benchmark, depth, fanout):
+    build_and_run_hierarchy_scaling(benchmark, "nvc", "nvc", depth, fanout)
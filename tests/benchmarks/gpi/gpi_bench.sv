@@ -0,0 +1,43 @@
+// Copyright cocotb contributors
+// Licensed under the Revised BSD License, see LICENSE for details.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Design for the GPI microbenchmarks: signals of several widths, a memory,
+// and a parameterized number of leaf instances for hierarchy discovery.
+
+`timescale 1ns/1ps
+
+module gpi_bench_leaf (
+    input  logic clk,
+    input  logic d
+);
+
+    logic q;
+
+    always_ff @(posedge clk) q <= d;
+
+endmodule
+
+module gpi_bench #(
+    parameter int N_LEAVES = 1024
+) (
+    input  logic         clk,
+    input  logic         sig1,
+    input  logic [31:0]  sig32,
+    input  logic [63:0]  sig64,
+    input  logic [127:0] sig128,
+    output logic [31:0]  count
+);
+
+    logic [31:0] mem [0:1023];
+
+    always_ff @(posedge clk) count <= count + 1;
+
+    for (genvar i = 0; i < N_LEAVES; i++) begin : g_leaf
+        gpi_bench_leaf leaf (
+            .clk(clk),
+            .d(sig32[i % 32])
+        );
+    end
+
+endmodule
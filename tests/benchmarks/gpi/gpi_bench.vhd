@@ -0,0 +1,74 @@
+-- Copyright cocotb contributors
+-- Licensed under the Revised BSD License, see LICENSE for details.
+-- SPDX-License-Identifier: BSD-3-Clause
+
+-- Design for the GPI microbenchmarks: signals of several widths, a memory,
+-- and a parameterized number of leaf instances for hierarchy discovery.
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+entity gpi_bench_leaf is
+    port (
+        clk : in std_logic;
+        d   : in std_logic
+    );
+end entity gpi_bench_leaf;
+
+architecture rtl of gpi_bench_leaf is
+    signal q : std_logic;
+begin
+
+    process (clk) is
+    begin
+        if rising_edge(clk) then
+            q <= d;
+        end if;
+    end process;
+
+end architecture rtl;
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+entity gpi_bench is
+    generic (
+        N_LEAVES : natural := 1024
+    );
+    port (
+        clk    : in  std_logic;
+        sig1   : in  std_logic;
+        sig32  : in  std_logic_vector(31 downto 0);
+        sig64  : in  std_logic_vector(63 downto 0);
+        sig128 : in  std_logic_vector(127 downto 0);
+        count  : out std_logic_vector(31 downto 0)
+    );
+end entity gpi_bench;
+
+architecture rtl of gpi_bench is
+    type mem_t is array (0 to 1023) of std_logic_vector(31 downto 0);
+
+    signal mem       : mem_t;
+    signal count_reg : unsigned(31 downto 0) := (others => '0');
+begin
+
+    process (clk) is
+    begin
+        if rising_edge(clk) then
+            count_reg <= count_reg + 1;
+        end if;
+    end process;
+
+    count <= std_logic_vector(count_reg);
+
+    g_leaf : for i in 0 to N_LEAVES - 1 generate
+        leaf : entity work.gpi_bench_leaf
+            port map (
+                clk => clk,
+                d   => sig32(i mod 32)
+            );
+    end generate g_leaf;
+
+end architecture rtl;
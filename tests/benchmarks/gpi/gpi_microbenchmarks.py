@@ -0,0 +1,178 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Microbenchmarks of the GPI and simulator module hot paths.
+
+Each test times one kind of operation in a loop and adds the wall clock time
+per operation to the JSON file named by ``COCOTB_BENCHMARK_RESULTS``, so that
+a regression can be pinned on the scheduler, the simulator module or a
+backend. ``COCOTB_BENCHMARK_ITERATIONS`` sets the number of operations timed.
+"""
+
+import json
+import os
+import time
+from typing import Any, Callable, Dict
+
+import cocotb
+from cocotb import simulator
+from cocotb.clock import Clock
+from cocotb.handle import HierarchyObjectBase, SimHandleBase, _GPISetAction
+from cocotb.triggers import RisingEdge, Timer
+
+RESULTS = os.environ.get("COCOTB_BENCHMARK_RESULTS", "gpi_microbenchmarks.json")
+ITERATIONS = int(os.environ.get("COCOTB_BENCHMARK_ITERATIONS", "10000"))
+
+WIDTHS = (1, 32, 64, 128)
+
+_results: Dict[str, Dict[str, Any]] = {}
+
+
+def record(name: str, ops: int, seconds: float) -> None:
+    """Add a result and rewrite the results file with all results so far."""
+    _results[name] = {
+        "ops": ops,
+        "seconds": seconds,
+        "ns_per_op": seconds * 1e9 / ops,
+    }
+    with open(RESULTS, "w") as f:
+        json.dump(
+            {
+                "simulator": cocotb.SIM_NAME,
+                "simulator_version": cocotb.SIM_VERSION,
+                "results": _results,
+            },
+            f,
+            indent=2,
+            sort_keys=True,
+        )
+
+
+def time_calls(name: str, func: Callable[[], object], ops: int = ITERATIONS) -> None:
+    start = time.perf_counter()
+    for _ in range(ops):
+        func()
+    record(name, ops, time.perf_counter() - start)
+
+
+@cocotb.test()
+async def bench_handle_lookup(dut) -> None:
+    root = dut._handle
+    time_calls("lookup_by_name", lambda: root.get_handle_by_name("sig32"))
+
+    mem = root.get_handle_by_name("mem")
+    low = min(mem.get_range()[:2])
+    n_elems = mem.get_num_elems()
+    indices = iter(range(ITERATIONS))
+    time_calls(
+        "lookup_by_index",
+        lambda: mem.get_handle_by_index(low + next(indices) % n_elems),
+    )
+
+
+@cocotb.test()
+async def bench_value_get(dut) -> None:
+    for width in WIDTHS:
+        sig = getattr(dut, f"sig{width}")
+        sig.value = 0
+    await Timer(1, "ns")
+
+    for width in WIDTHS:
+        sig = getattr(dut, f"sig{width}")
+        hdl = sig._handle
+        time_calls(f"get_value_{width}", lambda sig=sig: sig.value)
+        time_calls(f"get_binstr_{width}", hdl.get_signal_val_binstr)
+        time_calls(f"get_bytes_{width}", hdl.get_signal_val_bytes)
+        time_calls(f"get_long_{width}", hdl.get_signal_val_long)
+        time_calls(
+            f"get_accessor_int_{width}", hdl.get_accessor(simulator.ACCESS_INT)
+        )
+
+
+@cocotb.test()
+async def bench_value_set(dut) -> None:
+    action = _GPISetAction.DEPOSIT
+    for width in WIDTHS:
+        sig = getattr(dut, f"sig{width}")
+        hdl = sig._handle
+        n_bytes = (width + 7) // 8
+        binstr = "1" * width
+        packed = b"\xff" * n_bytes + bytes(n_bytes)
+
+        if width <= 32:
+            time_calls(
+                f"set_int_{width}", lambda hdl=hdl: hdl.set_signal_val_int(action, 1)
+            )
+        time_calls(
+            f"set_binstr_{width}",
+            lambda hdl=hdl, binstr=binstr: hdl.set_signal_val_binstr(action, binstr),
+        )
+        time_calls(
+            f"set_bytes_{width}",
+            lambda hdl=hdl, width=width, packed=packed: hdl.set_signal_val_bytes(
+                action, width, packed
+            ),
+        )
+
+        # Through the handle and the write scheduler
+        def set_value(sig: SimHandleBase = sig) -> None:
+            sig.value = 1
+
+        time_calls(f"set_value_{width}", set_value)
+        await Timer(1, "ns")
+
+
+@cocotb.test()
+async def bench_rising_edge(dut) -> None:
+    cocotb.start_soon(Clock(dut.clk, 10, "ns", impl="gpi").start())
+    edge = RisingEdge(dut.clk)
+    await edge
+
+    start = time.perf_counter()
+    for _ in range(ITERATIONS):
+        await edge
+    record("rising_edge", ITERATIONS, time.perf_counter() - start)
+
+
+@cocotb.test()
+async def bench_timer(dut) -> None:
+    def unused() -> None:
+        pass  # pragma: no cover
+
+    time_calls(
+        "timer_register",
+        lambda: simulator.register_timed_callback(1, unused).deregister(),
+    )
+
+    timer = Timer(1, "step")
+    start = time.perf_counter()
+    for _ in range(ITERATIONS):
+        await timer
+    record("timer_await", ITERATIONS, time.perf_counter() - start)
+
+
+@cocotb.test()
+async def bench_gpi_clock(dut) -> None:
+    cocotb.start_soon(Clock(dut.clk, 10, "ns", impl="gpi").start())
+    await Timer(1, "ns")
+
+    # The clock toggles with no Python code running in between
+    start = time.perf_counter()
+    await Timer(10 * ITERATIONS, "ns")
+    record("gpi_clock_edge", 2 * ITERATIONS, time.perf_counter() - start)
+
+
+@cocotb.test()
+async def bench_hierarchy_discovery(dut) -> None:
+    def walk(handle: SimHandleBase) -> int:
+        n = 1
+        if isinstance(handle, HierarchyObjectBase):
+            for child in handle:
+                n += walk(child)
+        return n
+
+    # Handles are cached once discovered, so only the first walk is timed
+    start = time.perf_counter()
+    n_handles = walk(dut)
+    record("hierarchy_discovery", n_handles, time.perf_counter() - start)
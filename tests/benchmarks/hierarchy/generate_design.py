@@ -0,0 +1,179 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Generator of large designs for the hierarchy scaling benchmark.
+
+The design is a tree of *depth* levels below the ``hier_top`` toplevel.
+Every node holds *n_signals* 8-bit signals and an unpacked array of
+*array_len* 8-bit elements, and nodes above the leaves instantiate *fanout*
+children of the next level from a generate loop named ``g_child``.
+
+Run as a script to write a design, e.g.::
+
+    python generate_design.py --lang vhdl --depth 4 --fanout 10 out_dir
+"""
+
+import argparse
+from pathlib import Path
+from typing import List
+
+
+def num_instances(depth: int, fanout: int) -> int:
+    """Number of node instances in a design."""
+    return sum(fanout**level for level in range(depth))
+
+
+def num_objects(depth: int, fanout: int, n_signals: int, array_len: int) -> int:
+    """Number of simulator objects below the toplevel of a design.
+
+    Counts every node, its signals, its array and array elements, and the
+    generate blocks of the nodes above the leaves.
+    """
+    per_node = 1 + n_signals + 1 + array_len
+    # Each node above the leaves has a generate loop and a block per child
+    per_parent = 1 + fanout
+    return (
+        num_instances(depth, fanout) * per_node
+        + num_instances(depth - 1, fanout) * per_parent
+    )
+
+
+def _verilog(depth: int, fanout: int, n_signals: int, array_len: int) -> str:
+    lines: List[str] = [
+        "// Generated by generate_design.py, do not edit",
+        "",
+        "`timescale 1ns/1ps",
+        "",
+    ]
+    for level in reversed(range(depth)):
+        lines.append(f"module node_{level} (input logic clk);")
+        lines.extend(f"    logic [7:0] sig_{i};" for i in range(n_signals))
+        lines.append(f"    logic [7:0] arr [0:{array_len - 1}];")
+        if level < depth - 1:
+            lines += [
+                f"    for (genvar i = 0; i < {fanout}; i++) begin : g_child",
+                f"        node_{level + 1} child (.clk(clk));",
+                "    end",
+            ]
+        lines += ["endmodule", ""]
+    lines += [
+        "module hier_top (input logic clk);",
+        "    node_0 root (.clk(clk));",
+        "endmodule",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def _vhdl(depth: int, fanout: int, n_signals: int, array_len: int) -> str:
+    lines: List[str] = [
+        "-- Generated by generate_design.py, do not edit",
+        "",
+        "library ieee;",
+        "use ieee.std_logic_1164.all;",
+        "",
+        "package hier_pkg is",
+        "    type byte_array is array (natural range <>) of std_logic_vector(7 downto 0);",
+        "end package hier_pkg;",
+        "",
+    ]
+    for level in reversed(range(depth)):
+        lines += [
+            "library ieee;",
+            "use ieee.std_logic_1164.all;",
+            "use work.hier_pkg.all;",
+            "",
+            f"entity node_{level} is",
+            "    port (clk : in std_logic);",
+            f"end entity node_{level};",
+            "",
+            f"architecture rtl of node_{level} is",
+        ]
+        lines.extend(
+            f"    signal sig_{i} : std_logic_vector(7 downto 0);"
+            for i in range(n_signals)
+        )
+        lines += [
+            f"    signal arr : byte_array(0 to {array_len - 1});",
+            "begin",
+        ]
+        if level < depth - 1:
+            lines += [
+                f"    g_child : for i in 0 to {fanout - 1} generate",
+                f"        child : entity work.node_{level + 1}",
+                "            port map (clk => clk);",
+                "    end generate g_child;",
+            ]
+        lines += ["end architecture rtl;", ""]
+    lines += [
+        "library ieee;",
+        "use ieee.std_logic_1164.all;",
+        "",
+        "entity hier_top is",
+        "    port (clk : in std_logic);",
+        "end entity hier_top;",
+        "",
+        "architecture rtl of hier_top is",
+        "begin",
+        "    root : entity work.node_0",
+        "        port map (clk => clk);",
+        "end architecture rtl;",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def generate(
+    out_dir: Path,
+    lang: str,
+    depth: int,
+    fanout: int,
+    n_signals: int = 8,
+    array_len: int = 8,
+) -> Path:
+    """Write a design to *out_dir* and return the path of its source file.
+
+    Args:
+        out_dir: Directory to write the source file to, created if needed.
+        lang: ``"verilog"`` or ``"vhdl"``.
+        depth: Number of levels of nodes.
+        fanout: Number of children of each node above the leaves.
+        n_signals: Number of signals of each node.
+        array_len: Number of elements of the array of each node.
+    """
+    if depth < 1 or fanout < 1 or n_signals < 0 or array_len < 1:
+        raise ValueError(
+            "depth, fanout and array_len must be positive, n_signals non-negative"
+        )
+    out_dir.mkdir(parents=True, exist_ok=True)
+    if lang == "verilog":
+        path = out_dir / "hier_top.sv"
+        path.write_text(_verilog(depth, fanout, n_signals, array_len))
+    elif lang == "vhdl":
+        path = out_dir / "hier_top.vhd"
+        path.write_text(_vhdl(depth, fanout, n_signals, array_len))
+    else:
+        raise ValueError(f"Unknown language {lang!r}")
+    return path
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("out_dir", type=Path)
+    parser.add_argument("--lang", choices=["verilog", "vhdl"], default="verilog")
+    parser.add_argument("--depth", type=int, default=4)
+    parser.add_argument("--fanout", type=int, default=8)
+    parser.add_argument("--signals", type=int, default=8)
+    parser.add_argument("--array-len", type=int, default=8)
+    args = parser.parse_args()
+
+    path = generate(
+        args.out_dir, args.lang, args.depth, args.fanout, args.signals, args.array_len
+    )
+    n_objects = num_objects(args.depth, args.fanout, args.signals, args.array_len)
+    print(f"Wrote {path} with about {n_objects} objects")
+
+
+if __name__ == "__main__":
+    main()
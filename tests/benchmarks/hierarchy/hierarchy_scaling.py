@@ -0,0 +1,72 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Discovery of the whole hierarchy of a design written by generate_design.py.
+
+Writes the discovery time, the number of handles, the increase of the peak
+resident set size and the statistics of the GPI handle store to the JSON file
+named by ``COCOTB_BENCHMARK_RESULTS``.
+"""
+
+import json
+import os
+import sys
+import time
+from typing import Dict
+
+import cocotb
+from cocotb import simulator
+from cocotb.handle import ArrayObject, HierarchyObjectBase, SimHandleBase
+
+RESULTS = os.environ.get("COCOTB_BENCHMARK_RESULTS", "hierarchy_scaling.json")
+
+
+def peak_rss_kib() -> int:
+    """Peak resident set size of this process in KiB, or 0 if unknown."""
+    try:
+        import resource
+    except ImportError:  # pragma: no cover
+        return 0
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # macOS reports bytes, other platforms KiB
+    return peak // 1024 if sys.platform == "darwin" else peak
+
+
+def walk(handle: SimHandleBase, counts: Dict[str, int]) -> None:
+    kind = type(handle).__name__
+    counts[kind] = counts.get(kind, 0) + 1
+    if isinstance(handle, (HierarchyObjectBase, ArrayObject)):
+        for child in handle:
+            walk(child, counts)
+
+
+@cocotb.test()
+async def discover_hierarchy(dut) -> None:
+    rss_before = peak_rss_kib()
+    counts: Dict[str, int] = {}
+
+    start = time.perf_counter()
+    walk(dut, counts)
+    seconds = time.perf_counter() - start
+
+    n_handles = sum(counts.values())
+    results = {
+        "simulator": cocotb.SIM_NAME,
+        "simulator_version": cocotb.SIM_VERSION,
+        "handles": n_handles,
+        "handles_by_type": counts,
+        "seconds": seconds,
+        "us_per_handle": seconds * 1e6 / n_handles,
+        "peak_rss_kib": peak_rss_kib(),
+        "peak_rss_increase_kib": peak_rss_kib() - rss_before,
+        "handle_store": simulator.get_handle_store_stats(),
+    }
+    with open(RESULTS, "w") as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+    dut._log.info(
+        "Discovered %d handles in %.3f s, peak RSS %d KiB",
+        n_handles,
+        seconds,
+        results["peak_rss_kib"],
+    )
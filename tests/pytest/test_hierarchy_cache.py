@@ -0,0 +1,132 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+import os
+import struct
+import sys
+
+import pytest
+from test_cocotb import (
+    compile_args,
+    gpi_interfaces,
+    hdl_toplevel,
+    hdl_toplevel_lang,
+    sim,
+    sim_args,
+    sources,
+    tests_dir,
+)
+
+import cocotb
+from cocotb_tools.runner import get_results, get_runner
+
+pytestmark = [
+    pytest.mark.simulator_required,
+    pytest.mark.skipif(
+        gpi_interfaces != ["vpi"], reason="Only the VPI uses the hierarchy cache"
+    ),
+]
+sys.path.insert(0, os.path.join(tests_dir, "pytest"))
+
+sim_build = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)), "sim_build", "test_hierarchy_cache"
+)
+
+# Layout of an entry of the cache file, see GpiHierarchyCache in GpiCommon.cpp
+_PROPS = struct.Struct("=8i")
+_U32 = struct.Struct("=I")
+
+
+@cocotb.test
+async def cached_length(dut):
+    """The handle has the length the cache test expects."""
+    assert len(dut.stream_in_data) == int(os.environ["EXPECTED_LENGTH"])
+
+
+def read_cache(path):
+    """Get the key and the entries of the cache file at *path*."""
+    with open(path, "rb") as f:
+        data = f.read()
+    assert data[:8] == b"GPIHIER1"
+    pos = 8
+
+    def read_bytes():
+        nonlocal pos
+        (size,) = _U32.unpack_from(data, pos)
+        pos += _U32.size + size
+        return data[pos - size : pos]
+
+    key = read_bytes()
+    (count,) = _U32.unpack_from(data, pos)
+    pos += _U32.size
+    entries = {}
+    for _ in range(count):
+        props = list(_PROPS.unpack_from(data, pos))
+        pos += _PROPS.size
+        entries[read_bytes().decode()] = props
+    assert pos == len(data)
+    return key, entries
+
+
+def write_cache(path, key, entries):
+    with open(path, "wb") as f:
+        f.write(b"GPIHIER1" + _U32.pack(len(key)) + key + _U32.pack(len(entries)))
+        for name, props in entries.items():
+            encoded = name.encode()
+            f.write(_PROPS.pack(*props) + _U32.pack(len(encoded)) + encoded)
+
+
+def run(cache_path, expected_length, cache_key="build1"):
+    runner = get_runner(sim)
+    results_file = runner.test(
+        hdl_toplevel_lang=hdl_toplevel_lang,
+        hdl_toplevel=hdl_toplevel,
+        gpi_interfaces=gpi_interfaces,
+        test_module="test_hierarchy_cache",
+        test_args=sim_args,
+        build_dir=sim_build,
+        extra_env={
+            "GPI_HIERARCHY_CACHE": cache_path,
+            "GPI_HIERARCHY_CACHE_KEY": cache_key,
+            "EXPECTED_LENGTH": str(expected_length),
+        },
+    )
+    num_tests, num_failed = get_results(results_file)
+    assert (num_tests, num_failed) == (1, 0)
+
+
+def test_hierarchy_cache():
+    runner = get_runner(sim)
+    runner.build(
+        always=True,
+        sources=sources,
+        hdl_toplevel=hdl_toplevel,
+        build_dir=sim_build,
+        build_args=compile_args,
+    )
+
+    cache_path = os.path.join(sim_build, "hierarchy.cache")
+    if os.path.exists(cache_path):
+        os.remove(cache_path)
+
+    # The first run creates the cache with the objects it found
+    run(cache_path, 8)
+    key, entries = read_cache(cache_path)
+    assert key.startswith(b"build1\0")
+    (name,) = (name for name in entries if name.endswith(".stream_in_data"))
+    props = entries[name]
+    assert props[2] == 8 and props[7] == 8  # num_elems and length
+
+    # Later runs take the properties from the cache instead of the simulator
+    props[2] = props[7] = 16
+    props[4], props[5] = 15, 0  # range_left and range_right
+    write_cache(cache_path, key, entries)
+    run(cache_path, 16)
+    assert read_cache(cache_path)[1][name] == props
+
+    # The cache of another build is ignored and rebuilt
+    run(cache_path, 8, cache_key="build2")
+    key, entries = read_cache(cache_path)
+    assert key.startswith(b"build2\0")
+    assert entries[name][2] == 8
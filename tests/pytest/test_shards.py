@@ -0,0 +1,177 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+import os
+import sys
+import xml.etree.ElementTree as ET
+from collections import Counter
+from pathlib import Path
+
+import pytest
+from test_cocotb import (
+    compile_args,
+    gpi_interfaces,
+    hdl_toplevel,
+    hdl_toplevel_lang,
+    sim,
+    sim_args,
+    sources,
+    tests_dir,
+)
+
+import cocotb
+from cocotb.regression import RegressionManager, Test
+from cocotb.triggers import Timer
+from cocotb_tools.runner import get_runner
+
+pytestmark = pytest.mark.simulator_required
+sys.path.insert(0, os.path.join(tests_dir, "pytest"))
+
+sim_build = Path(__file__).parent / "sim_build" / "test_shards"
+
+num_shards = 3
+shard_test_times = [10 * (i + 1) for i in range(7)]
+
+
+# Tests of different lengths for the shards to balance
+@cocotb.test
+@cocotb.parametrize(duration=shard_test_times)
+async def shard_test(dut, duration):
+    await Timer(duration, "ns")
+
+
+async def dummy(dut):
+    pass
+
+
+def split(names, durations, count, excluded=()):
+    """Get the tests of *names* each of *count* shards runs."""
+    shards = []
+    for index in range(count):
+        manager = RegressionManager()
+        for name in names:
+            manager.register_test(Test(func=dummy, name=name, module="split"))
+        manager._included = [name not in excluded for name in names]
+        manager.set_shard(index, count, durations)
+        in_shard = manager._split_shards()
+        shards.append([name for name, run in zip(names, in_shard) if run])
+    return shards
+
+
+@cocotb.test
+async def test_split_balances_durations(dut):
+    """Tests are split longest first onto the shard with the least work."""
+    names = ["a", "b", "c", "d"]
+    durations = {"split.a": 5.0, "split.b": 3.0, "split.c": 2.0, "split.d": 2.0}
+    assert split(names, durations, 2) == [["a", "d"], ["b", "c"]]
+
+    # Tests without a duration take the average of the others
+    durations = {"split.a": 6.0, "split.b": 2.0}
+    assert split(names, durations, 2) == [["a", "b"], ["c", "d"]]
+
+    # Without durations all tests take as long, so are dealt out in order
+    assert split(names, {}, 3) == [["a", "d"], ["b"], ["c"]]
+
+
+@cocotb.test
+async def test_split_is_identical_across_shards(dut):
+    """Each test is run by exactly one shard, whichever shard computes the split."""
+    names = [f"t{i}" for i in range(20)]
+    durations = {f"split.t{i}": float((i * 7) % 5) for i in range(0, 20, 2)}
+    for count in (1, 2, 3, 8, 25):
+        shards = split(names, durations, count)
+        assert sorted(sum(shards, [])) == sorted(names)
+        assert split(names, durations, count) == shards
+
+
+@cocotb.test
+async def test_split_records_excluded_in_shard_0(dut):
+    """Tests excluded by the filters are only recorded once, by shard 0."""
+    names = ["a", "b", "c", "d"]
+    shards = split(names, {}, 2, excluded=("b",))
+    assert shards == [["a", "b", "d"], ["c"]]
+
+
+@cocotb.test
+async def test_set_shard_errors(dut):
+    """The index must be one of the shards."""
+    manager = RegressionManager()
+    for index, count in ((0, 0), (-1, 2), (2, 2)):
+        with pytest.raises(ValueError, match="is not one of"):
+            manager.set_shard(index, count)
+
+
+def testcase_names(results_file):
+    tree = ET.parse(results_file)
+    return [
+        (testcase.get("name"), testcase.find("skipped") is not None)
+        for testcase in tree.iter("testcase")
+    ]
+
+
+@pytest.mark.compile
+def test_shards_compile():
+    runner = get_runner(sim)
+
+    runner.build(
+        always=True,
+        sources=sources,
+        hdl_toplevel=hdl_toplevel,
+        build_dir=sim_build,
+        build_args=compile_args,
+    )
+
+
+def test_shards():
+    runner = get_runner(sim)
+
+    runner.build_args = compile_args
+    runner.sources = sources
+    runner.verilog_sources = []
+    runner.vhdl_sources = []
+
+    run_tests = sorted(
+        [f"shard_test/duration={duration}" for duration in shard_test_times[:-1]]
+        + [
+            "test_split_balances_durations",
+            "test_split_is_identical_across_shards",
+            "test_split_records_excluded_in_shard_0",
+            "test_set_shard_errors",
+        ]
+    )
+    excluded_test = f"shard_test/duration={shard_test_times[-1]}"
+
+    # The second run is balanced with the durations of the first
+    for run in range(2):
+        results_file = runner.test(
+            hdl_toplevel_lang=hdl_toplevel_lang,
+            hdl_toplevel=hdl_toplevel,
+            gpi_interfaces=gpi_interfaces,
+            test_module="test_shards",
+            test_args=sim_args,
+            build_dir=sim_build,
+            test_filter=f"^test_shards\\.(?!{excluded_test}$)",
+            shards=num_shards,
+        )
+
+        # The merged results have each test once
+        names = testcase_names(results_file)
+        assert sorted(name for name, skipped in names if not skipped) == run_tests
+        assert [name for name, skipped in names if skipped] == [excluded_test]
+        assert len(ET.parse(results_file).findall("testsuite")) == 1
+
+        # The shards ran disjoint sets of the tests
+        counts = Counter()
+        for index in range(num_shards):
+            shard_file = sim_build / "shards" / f"shard_{index}.xml"
+            shard_names = testcase_names(shard_file)
+            counts.update(name for name, skipped in shard_names if not skipped)
+            assert any(not skipped for _, skipped in shard_names)
+            if index != 0:
+                assert excluded_test not in {name for name, _ in shard_names}
+        assert sorted(counts) == run_tests
+        assert set(counts.values()) == {1}
+
+        if run == 1:
+            assert (sim_build / "shards" / "last_results.xml").is_file()
@@ -0,0 +1,74 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests reading and writing slices of arrays in bulk."""
+
+import pytest
+
+import cocotb
+from cocotb.handle import _GPISetAction
+from cocotb.triggers import Timer
+
+# GHDL unable to put values on nested array types (gh-2588)
+ghdl_error = Exception if cocotb.SIM_NAME.lower().startswith("ghdl") else ()
+
+
+def pack(values):
+    """Pack 8-bit element values with no X or Z bits."""
+    return b"".join(bytes([v, 0]) for v in values)
+
+
+@cocotb.test(expect_error=ghdl_error)
+async def test_set_slice(dut):
+    """The elements of a slice are written from the lowest index up."""
+    arr = dut.array_7_downto_4
+    arr.value = [0, 0, 0, 0]
+    await Timer(1, "ns")
+
+    arr._handle.set_array_val_bytes(_GPISetAction.DEPOSIT, 5, 2, pack([0x11, 0x22]))
+    await Timer(1, "ns")
+    assert [arr[i].value for i in range(4, 8)] == [0, 0x11, 0x22, 0]
+
+
+@cocotb.test(expect_error=ghdl_error)
+async def test_get_slice(dut):
+    """Reading a slice returns the element width, and fills in each element."""
+    arr = dut.array_0_to_3
+    arr.value = [0x30, 0x20, 0x10, 0x00]
+    await Timer(1, "ns")
+
+    buf = bytearray(8)
+    assert arr._handle.get_array_val_bytes_into(0, 4, buf) == 8
+    assert buf == pack([0x30, 0x20, 0x10, 0x00])
+
+    buf = bytearray(6)
+    assert arr._handle.get_array_val_bytes_into(1, 2, buf) == 8
+    assert buf == pack([0x20, 0x10]) + bytes(2)
+
+
+@cocotb.test(expect_error=ghdl_error)
+async def test_slice_round_trip(dut):
+    """Slices read back as written, for ascending and descending arrays."""
+    for arr in (dut.array_3_downto_0, dut.array_0_to_3):
+        values = pack([0xA1, 0xB2, 0xC3, 0xD4])
+        arr._handle.set_array_val_bytes(_GPISetAction.DEPOSIT, 0, 4, values)
+        await Timer(1, "ns")
+        buf = bytearray(len(values))
+        arr._handle.get_array_val_bytes_into(0, 4, buf)
+        assert buf == values
+
+
+@cocotb.test
+async def test_slice_errors(dut):
+    """Slices out of range, and values or buffers of the wrong size are rejected."""
+    hdl = dut.array_7_downto_4._handle
+
+    with pytest.raises(ValueError):
+        hdl.set_array_val_bytes(_GPISetAction.DEPOSIT, 6, 3, pack([1, 2, 3]))
+    with pytest.raises(ValueError):
+        hdl.set_array_val_bytes(_GPISetAction.DEPOSIT, 4, 2, pack([1]))
+    with pytest.raises(ValueError):
+        hdl.get_array_val_bytes_into(4, 4, bytearray(7))
+    # Slices which can't be read report -1 rather than raising
+    assert hdl.get_array_val_bytes_into(3, 2, bytearray(4)) == -1
@@ -0,0 +1,73 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests loading and dumping arrays from and to raw files."""
+
+from pathlib import Path
+
+import pytest
+
+import cocotb
+from cocotb.handle import _GPISetAction
+from cocotb.triggers import Timer
+
+# GHDL unable to put values on nested array types (gh-2588)
+ghdl_error = Exception if cocotb.SIM_NAME.lower().startswith("ghdl") else ()
+
+
+def image_path(name):
+    """Path of an image in the simulator's working directory."""
+    work_dir = Path("array_images")
+    work_dir.mkdir(exist_ok=True)
+    return work_dir / name
+
+
+@cocotb.test(expect_error=ghdl_error)
+async def test_load_from_file(dut):
+    """An image is loaded at an offset into the file, one byte per element."""
+    image = image_path("load.bin")
+    image.write_bytes(b"\xee\xee" + bytes([0x01, 0x02, 0x03]) + b"\xee")
+
+    arr = dut.array_0_to_3
+    arr.value = [0, 0, 0, 0]
+    await Timer(1, "ns")
+    arr._handle.load_array_from_file(_GPISetAction.DEPOSIT, image, 2, 1, 3)
+    await Timer(1, "ns")
+    assert [arr[i].value for i in range(4)] == [0, 0x01, 0x02, 0x03]
+
+
+@cocotb.test(expect_error=ghdl_error)
+async def test_dump_to_file(dut):
+    """A dump holds the elements from the first index up, and loads back."""
+    image = image_path("dump.bin")
+
+    arr = dut.array_7_downto_4
+    arr.value = [0xF0, 0xE0, 0xD0, 0xC0]
+    await Timer(1, "ns")
+    arr._handle.dump_array_to_file(image, 4, 4)
+    assert image.read_bytes() == bytes([0xC0, 0xD0, 0xE0, 0xF0])
+
+    other = dut.array_3_downto_0
+    other._handle.load_array_from_file(_GPISetAction.DEPOSIT, str(image), 0, 0, 4)
+    await Timer(1, "ns")
+    assert other.value == [0xF0, 0xE0, 0xD0, 0xC0]
+
+
+@cocotb.test
+async def test_file_errors(dut):
+    """Missing and short files, and slices out of range, raise RuntimeError."""
+    short = image_path("short.bin")
+    short.write_bytes(bytes(3))
+    hdl = dut.array_0_to_3._handle
+
+    with pytest.raises(RuntimeError):
+        hdl.load_array_from_file(_GPISetAction.DEPOSIT, image_path("none"), 0, 0, 4)
+    with pytest.raises(RuntimeError):
+        hdl.load_array_from_file(_GPISetAction.DEPOSIT, short, 0, 0, 4)
+    with pytest.raises(RuntimeError):
+        hdl.load_array_from_file(_GPISetAction.DEPOSIT, short, 1, 0, 3)
+    with pytest.raises(RuntimeError):
+        hdl.dump_array_to_file(image_path("out.bin"), 2, 3)
+    with pytest.raises(RuntimeError):
+        hdl.dump_array_to_file(image_path("none") / "out.bin", 0, 4)
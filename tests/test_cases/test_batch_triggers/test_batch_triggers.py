@@ -0,0 +1,94 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests edge triggers firing together, see COCOTB_BATCH_TRIGGERS."""
+
+import cocotb
+from cocotb.triggers import Edge, FallingEdge, RisingEdge, Timer
+from cocotb.utils import get_sim_time
+
+
+async def wait_and_record(trigger, name, woken):
+    await trigger
+    woken.append((name, get_sim_time()))
+
+
+@cocotb.test
+async def test_simultaneous_edges(dut):
+    """All tasks waiting on edges caused by the same writes are resumed."""
+    dut.stream_in_data.value = 0
+    dut.stream_in_data_dword.value = 0
+    dut.stream_in_valid.value = 0
+    await Timer(1, "ns")
+
+    woken = []
+    cocotb.start_soon(wait_and_record(Edge(dut.stream_in_data), "data", woken))
+    cocotb.start_soon(wait_and_record(Edge(dut.stream_in_data_dword), "dword", woken))
+    cocotb.start_soon(wait_and_record(RisingEdge(dut.stream_in_valid), "valid", woken))
+    cocotb.start_soon(wait_and_record(FallingEdge(dut.stream_in_valid), "fall", woken))
+    await Timer(1, "ns")
+
+    dut.stream_in_data.value = 0x12
+    dut.stream_in_data_dword.value = 0x3456
+    dut.stream_in_valid.value = 1
+    write_time = get_sim_time()
+    await Timer(1, "ns")
+
+    assert sorted(name for name, _ in woken) == ["data", "dword", "valid"]
+    assert all(time == write_time for _, time in woken)
+
+
+@cocotb.test
+async def test_waiters_resume_in_order(dut):
+    """Tasks waiting on the same trigger resume in the order they waited."""
+    dut.stream_in_data.value = 0
+    await Timer(1, "ns")
+
+    woken = []
+    for i in range(4):
+        cocotb.start_soon(wait_and_record(Edge(dut.stream_in_data), i, woken))
+    await Timer(1, "ns")
+
+    dut.stream_in_data.value = 0xFF
+    await Timer(1, "ns")
+    assert [name for name, _ in woken] == [0, 1, 2, 3]
+
+
+@cocotb.test
+async def test_repeated_edges(dut):
+    """Triggers that fired are primed again for the next write."""
+    count = 0
+
+    async def count_edges():
+        nonlocal count
+        while True:
+            await Edge(dut.stream_in_data_dword)
+            count += 1
+
+    task = cocotb.start_soon(count_edges())
+    for i in range(1, 6):
+        dut.stream_in_data_dword.value = i
+        await Timer(1, "ns")
+    task.kill()
+    assert count == 5
+
+
+@cocotb.test(expect_error=ValueError)
+async def test_error_in_batched_task(dut):
+    """An exception raised by a resumed task fails the test."""
+
+    async def fail_on_edge():
+        await Edge(dut.stream_in_data)
+        raise ValueError("expected")
+
+    dut.stream_in_data.value = 0
+    dut.stream_in_valid.value = 0
+    await Timer(1, "ns")
+    cocotb.start_soon(fail_on_edge())
+    cocotb.start_soon(wait_and_record(Edge(dut.stream_in_valid), "valid", []))
+    await Timer(1, "ns")
+
+    dut.stream_in_data.value = 1
+    dut.stream_in_valid.value = 1
+    await Timer(10, "ns")
@@ -0,0 +1,119 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests the values delivered with value change callbacks."""
+
+import os
+
+import cocotb
+from cocotb import simulator
+from cocotb.triggers import Edge, FallingEdge, RisingEdge, Timer
+from cocotb.types import LogicArray
+from cocotb.utils import get_sim_time
+
+SIM_NAME = cocotb.SIM_NAME.lower()
+LANGUAGE = os.environ["TOPLEVEL_LANG"].lower().strip()
+if LANGUAGE == "verilog" or SIM_NAME.startswith("ghdl"):
+    intf = "vpi"
+elif SIM_NAME.startswith("modelsim"):
+    intf = os.environ.get("VHDL_GPI_INTERFACE", "fli").strip()
+else:
+    intf = "vhpi"
+
+# Only VHPI delivers the value with the callback
+delivers_value = intf == "vhpi"
+
+
+def register_recording_callback(signal, edge, seen):
+    """Register a one-shot callback recording the delivered and read values."""
+    cb = []
+
+    def callback():
+        seen.append((cb[0].get_value_bytes(), signal._handle.get_signal_val_bytes()))
+
+    cb.append(simulator.register_value_change_callback(signal._handle, callback, edge))
+    return cb[0]
+
+
+@cocotb.test
+async def test_delivered_value(dut):
+    """The value delivered with a change is the new value of the signal."""
+    dut.stream_in_valid.value = 0
+    await Timer(1, "ns")
+
+    for value in (1, 0, 1):
+        seen = []
+        register_recording_callback(dut.stream_in_valid, simulator.VALUE_CHANGE, seen)
+        dut.stream_in_valid.value = value
+        await Timer(1, "ns")
+
+        assert len(seen) == 1
+        delivered, read = seen[0]
+        assert read == bytes([value, 0])
+        if delivers_value:
+            assert delivered == read
+        else:
+            assert delivered is None
+
+
+@cocotb.test
+async def test_no_value_outside_callback(dut):
+    """There is no delivered value before the callback runs."""
+    cb = register_recording_callback(dut.stream_in_valid, simulator.VALUE_CHANGE, [])
+    assert cb.get_value_bytes() is None
+    cb.deregister()
+
+
+@cocotb.test
+async def test_edges_filtered_on_value(dut):
+    """Edge triggers fire on the changes to their level, and only those."""
+    dut.stream_in_valid.value = 0
+    await Timer(1, "ns")
+
+    rising = []
+    falling = []
+    changes = []
+
+    async def record(trigger, times):
+        while True:
+            await trigger
+            times.append(get_sim_time("ns"))
+
+    tasks = [
+        cocotb.start_soon(record(RisingEdge(dut.stream_in_valid), rising)),
+        cocotb.start_soon(record(FallingEdge(dut.stream_in_valid), falling)),
+        cocotb.start_soon(record(Edge(dut.stream_in_valid), changes)),
+    ]
+    start = get_sim_time("ns")
+    for value in (1, 1, 0, 1, 0):
+        await Timer(1, "ns")
+        dut.stream_in_valid.value = value
+    await Timer(1, "ns")
+    for task in tasks:
+        task.kill()
+
+    assert rising == [start + 1, start + 4]
+    assert falling == [start + 3, start + 5]
+    assert changes == [start + 1, start + 3, start + 4, start + 5]
+
+
+@cocotb.test(skip=SIM_NAME.startswith("verilator"))
+async def test_delivered_unresolved(dut):
+    """X and Z values are delivered like they are read."""
+    dut.stream_in_valid.value = 0
+    await Timer(1, "ns")
+
+    for value, packed in (("X", bytes([1, 1])), ("Z", bytes([0, 1]))):
+        seen = []
+        register_recording_callback(dut.stream_in_valid, simulator.VALUE_CHANGE, seen)
+        dut.stream_in_valid.value = LogicArray(value)
+        await Timer(1, "ns")
+
+        assert len(seen) == 1
+        delivered, read = seen[0]
+        assert read == packed
+        if delivers_value:
+            assert delivered == packed
+        else:
+            assert delivered is None
@@ -16,7 +16,7 @@ import cocotb
 from cocotb.clock import Clock
 from cocotb.simulator import clock_create, get_precision
 from cocotb.triggers import RisingEdge, Timer
-from cocotb.utils import get_sim_time
+from cocotb.utils import get_sim_steps, get_sim_time
 
 LANGUAGE = os.environ["TOPLEVEL_LANG"].lower().strip()
 
@@ -132,3 +132,64 @@ async def test_clocks_with_other_number_types(dut):
     await Timer(10, "ns")
     with pytest.warns(FutureWarning, match="cause a CancelledError to be thrown"):
         clk2.cancel()
+
+
+async def record_rising_edges(signal, times):
+    while True:
+        await RisingEdge(signal)
+        times.append(get_sim_time(units="ns"))
+
+
+@cocotb.test()
+async def test_gpi_clock_cycles(dut):
+    """A GPI clock started for a number of cycles stops back at its start value."""
+    edges = []
+    recorder = cocotb.start_soon(record_rising_edges(dut.clk, edges))
+
+    dut.clk.value = 0
+    await Timer(1, "ns")
+    start_ns = get_sim_time(units="ns")
+    clk = clock_create(dut.clk._handle)
+    clk.start(get_sim_steps(10, "ns"), get_sim_steps(5, "ns"), False, 3)
+
+    await Timer(100, "ns")
+    recorder.kill()
+    assert edges == [start_ns + 5, start_ns + 15, start_ns + 25]
+    assert dut.clk.value == 0
+
+    # A finished clock can be started again, and is busy until it finishes
+    clk.start(get_sim_steps(10, "ns"), get_sim_steps(5, "ns"), True, 1)
+    with pytest.raises(RuntimeError):
+        clk.start(get_sim_steps(10, "ns"), get_sim_steps(5, "ns"), True)
+    await Timer(20, "ns")
+    assert dut.clk.value == 1
+
+
+@cocotb.test()
+async def test_gpi_clocks_share_schedule(dut):
+    """Clocks of different periods keep their timing when one of them stops."""
+    fast_edges = []
+    slow_edges = []
+    fast_recorder = cocotb.start_soon(record_rising_edges(dut.clk, fast_edges))
+    slow_recorder = cocotb.start_soon(
+        record_rising_edges(dut.stream_in_valid, slow_edges)
+    )
+
+    dut.clk.value = 0
+    dut.stream_in_valid.value = 0
+    await Timer(1, "ns")
+    start_ns = get_sim_time(units="ns")
+    fast = clock_create(dut.clk._handle)
+    slow = clock_create(dut.stream_in_valid._handle)
+    fast.start(get_sim_steps(4, "ns"), get_sim_steps(2, "ns"), False)
+    slow.start(get_sim_steps(10, "ns"), get_sim_steps(3, "ns"), False)
+
+    await Timer(20, "ns")
+    slow.stop()
+    await Timer(20, "ns")
+    fast.stop()
+    fast_recorder.kill()
+    slow_recorder.kill()
+
+    assert fast_edges == [start_ns + t for t in range(2, 40, 4)]
+    assert slow_edges == [start_ns + 7, start_ns + 17]
@@ -88,3 +88,53 @@ async def test_custom_logging_levels(dut):
     logger = logging.getLogger("name")
     logger.setLevel(5)
     logger.log(5, "SUPER DEBUG MESSAGE!")
+
+
+class RecordList(logging.Handler):
+    def __init__(self):
+        super().__init__()
+        self.messages = []
+
+    def emit(self, record):
+        self.messages.append(record.getMessage())
+
+
+@cocotb.test()
+async def test_gpi_log_level_follows_config(dut):
+    """GPI messages are dropped natively only while the gpi logger is disabled."""
+    gpi_log = logging.getLogger("gpi")
+    root_log = logging.getLogger()
+    gpi_level_prev = gpi_log.level
+    root_level_prev = root_log.level
+    records = RecordList()
+    gpi_log.addHandler(records)
+    lookups = 0
+
+    def gpi_debug_logged():
+        # Looking up a name logs it at DEBUG level
+        nonlocal lookups
+        lookups += 1
+        name = f"no_such_signal_{lookups}"
+        dut._handle.get_handle_by_name(name)
+        return any(name in message for message in records.messages)
+
+    try:
+        # Inherited from the root logger
+        gpi_log.setLevel(logging.NOTSET)
+        root_log.setLevel(logging.INFO)
+        assert not gpi_debug_logged()
+        root_log.setLevel(logging.DEBUG)
+        assert gpi_debug_logged()
+
+        logging.disable(logging.DEBUG)
+        assert not gpi_debug_logged()
+        logging.disable(logging.NOTSET)
+        assert gpi_debug_logged()
+
+        gpi_log.setLevel(logging.INFO)
+        assert not gpi_debug_logged()
+    finally:
+        logging.disable(logging.NOTSET)
+        gpi_log.removeHandler(records)
+        root_log.setLevel(root_level_prev)
+        gpi_log.setLevel(gpi_level_prev)
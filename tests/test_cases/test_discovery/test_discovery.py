@@ -516,3 +516,20 @@ async def discover_all_in_component_vhdl(dut):
         assert total_count == 10
     else:
         assert total_count == 9
+
+
+@cocotb.test
+async def test_lazy_key_discovery(dut):
+    """Listing the keys of a scope does not create the handles of its children."""
+    # Not dut itself, as other tests may have discovered its children
+    scope = HierarchyObject(dut._handle, dut._path)
+    keys = set(scope._keys())
+    assert {"clk", "stream_in_data", "stream_out_data_comb"} <= keys
+    assert scope._sub_handles == {}
+
+    # Handles are created as the children are accessed
+    assert scope.stream_in_data._path == dut.stream_in_data._path
+    assert list(scope._sub_handles) == ["stream_in_data"]
+
+    # The same keys as discovering the children with their handles
+    assert keys == {key for key, _ in dut._items()}
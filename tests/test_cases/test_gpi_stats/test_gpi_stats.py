@@ -0,0 +1,88 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests the statistics of the calls made through the GPI."""
+
+from contextlib import contextmanager
+
+import cocotb
+from cocotb import simulator
+from cocotb.handle import _GPISetAction
+from cocotb.triggers import Timer
+
+
+@contextmanager
+def counting():
+    """Count the statistics from zero within the block."""
+    was_enabled = simulator.get_stats()["enabled"]
+    simulator.set_stats_enabled(False)
+    simulator.set_stats_enabled(True)
+    try:
+        yield
+    finally:
+        simulator.set_stats_enabled(was_enabled)
+
+
+@cocotb.test
+async def test_enable_resets_and_disable_freezes(dut):
+    """Enabling starts the counts from zero, and disabling stops them."""
+    hdl = dut.stream_in_data._handle
+    with counting():
+        assert simulator.get_stats()["enabled"]
+        assert simulator.get_stats()["value_gets"] == 0
+        hdl.get_signal_val_long()
+        assert simulator.get_stats()["value_gets"] == 1
+
+        simulator.set_stats_enabled(False)
+        hdl.get_signal_val_long()
+        stats = simulator.get_stats()
+        assert not stats["enabled"]
+        assert stats["value_gets"] == 1
+
+        simulator.set_stats_enabled(True)
+        assert simulator.get_stats()["value_gets"] == 0
+
+
+@cocotb.test
+async def test_value_gets_and_sets(dut):
+    """Each read and write of a value is counted once."""
+    hdl = dut.stream_in_data._handle
+    with counting():
+        hdl.set_signal_val_int(_GPISetAction.DEPOSIT, 5)
+        hdl.set_signal_val_binstr(_GPISetAction.DEPOSIT, "00000110")
+        await Timer(1, "ns")
+        before = simulator.get_stats()
+        assert hdl.get_signal_val_long() == 6
+        hdl.get_signal_val_binstr()
+        after = simulator.get_stats()
+    assert before["value_sets"] == 2
+    assert after["value_gets"] - before["value_gets"] == 2
+    assert after["value_sets"] == 2
+
+
+@cocotb.test
+async def test_lookups_and_iterations(dut):
+    """Handle lookups are counted, and iterations once per call to next."""
+    with counting():
+        assert dut._handle.get_handle_by_name("stream_in_ready") is not None
+        assert dut._handle.get_handle_by_name("not_a_signal") is None
+        assert simulator.get_stats()["handle_lookups"] == 2
+
+        children = list(dut._handle.iterate(simulator.OBJECTS))
+        # The last call finds the end of the iteration
+        assert simulator.get_stats()["iterations"] == len(children) + 1
+
+
+@cocotb.test
+async def test_callbacks(dut):
+    """Callbacks are counted and timed, as is the simulator in between."""
+    with counting():
+        for _ in range(10):
+            await Timer(1, "ns")
+        stats = simulator.get_stats()
+    assert stats["cb_registrations"] >= 10
+    assert stats["cb_runs"] >= 10
+    assert sum(stats["cb_latency"]) >= 10
+    assert stats["user_ns"] > 0
+    assert stats["simulator_ns"] > 0
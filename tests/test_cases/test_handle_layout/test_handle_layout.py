@@ -0,0 +1,60 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests the names and values of handles, which share their storage.
+
+A handle's name points into its full name, its definition name and file are shared
+between instances, and the VHPI signals share one buffer for binary string reads.
+"""
+
+import os
+
+import cocotb
+from cocotb.triggers import Timer
+
+LANGUAGE = os.environ["TOPLEVEL_LANG"].lower().strip()
+
+
+@cocotb.test
+async def test_names(dut):
+    """Handles created by name and by index have the name of their object."""
+    assert dut.stream_in_data._handle.get_name_string() == "stream_in_data"
+    assert dut.array_7_downto_4._handle.get_name_string() == "array_7_downto_4"
+
+    # The parent's name is not changed by creating its children
+    names = {dut.array_7_downto_4[i]._handle.get_name_string() for i in range(4, 8)}
+    assert names in (
+        {f"array_7_downto_4[{i}]" for i in range(4, 8)},
+        {f"array_7_downto_4({i})" for i in range(4, 8)},
+    )
+    assert dut.array_7_downto_4._handle.get_name_string() == "array_7_downto_4"
+
+
+@cocotb.test(skip=LANGUAGE != "verilog")
+async def test_instances_share_definition(dut):
+    """Instances of the same module have the same name and definition."""
+    first = dut.arr[1].arr_sub._handle
+    second = dut.arr[2].arr_sub._handle
+    assert first != second
+    assert first.get_name_string() == second.get_name_string() == "arr_sub"
+    assert first.get_definition_name() == second.get_definition_name()
+    assert first.get_definition_file() == second.get_definition_file()
+
+
+@cocotb.test
+async def test_binstr_reads_of_different_widths(dut):
+    """Reading a value as a string is not affected by reading wider values."""
+    values = [
+        (dut.stream_in_data, 0xA5),
+        (dut.stream_in_data_dqword, (0x0123456789ABCDEF << 64) | 0xFEDCBA9876543210),
+        (dut.stream_in_data_wide, 0xFEDCBA9876543210),
+    ]
+    for signal, value in values:
+        signal.value = value
+    await Timer(1, "ns")
+
+    for _ in range(2):
+        for signal, value in values:
+            binstr = signal._handle.get_signal_val_binstr()
+            assert binstr == format(value, f"0{len(signal)}b")
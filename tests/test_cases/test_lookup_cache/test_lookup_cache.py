@@ -0,0 +1,68 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests the cache of the results of looking up handles by name."""
+
+import cocotb
+from cocotb import simulator
+
+# The number of misses remembered by the cache
+MAX_MISSES = 4096
+
+
+def native_lookups():
+    return simulator.get_stats()["native_lookups"]
+
+
+@cocotb.test
+async def test_found_name_is_cached(dut):
+    """A name which was found is not looked up in the simulator again."""
+    simulator.set_stats_enabled(True)
+    try:
+        before = native_lookups()
+        hdl = dut._handle.get_handle_by_name("stream_in_ready")
+        assert hdl is not None
+        after = native_lookups()
+        assert after > before
+
+        assert dut._handle.get_handle_by_name("stream_in_ready") == hdl
+        assert native_lookups() == after
+    finally:
+        simulator.set_stats_enabled(False)
+
+
+@cocotb.test
+async def test_miss_is_cached(dut):
+    """A name which no implementation found is not looked up again."""
+    simulator.set_stats_enabled(True)
+    try:
+        before = native_lookups()
+        assert dut._handle.get_handle_by_name("not_a_signal") is None
+        after = native_lookups()
+        assert after > before
+
+        for _ in range(3):
+            assert dut._handle.get_handle_by_name("not_a_signal") is None
+        assert native_lookups() == after
+    finally:
+        simulator.set_stats_enabled(False)
+
+
+@cocotb.test
+async def test_oldest_misses_are_forgotten(dut):
+    """Only the last misses are remembered, so probing doesn't grow the cache."""
+    simulator.set_stats_enabled(True)
+    try:
+        assert dut._handle.get_handle_by_name("first_missing") is None
+        for i in range(MAX_MISSES):
+            assert dut._handle.get_handle_by_name(f"missing_{i}") is None
+
+        # The last miss is still remembered, the first one was forgotten
+        before = native_lookups()
+        assert dut._handle.get_handle_by_name(f"missing_{MAX_MISSES - 1}") is None
+        assert native_lookups() == before
+        assert dut._handle.get_handle_by_name("first_missing") is None
+        assert native_lookups() > before
+    finally:
+        simulator.set_stats_enabled(False)
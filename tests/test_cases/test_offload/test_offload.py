@@ -0,0 +1,104 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests calls offloaded to the GPI worker pool."""
+
+import threading
+
+import pytest
+
+import cocotb
+from cocotb import simulator
+from cocotb.triggers import Offload, ReadOnly, Timer
+from cocotb.utils import get_sim_time
+
+
+def add(a, b, *, scale=1):
+    return (a + b) * scale
+
+
+def fail(message):
+    raise ValueError(message)
+
+
+@cocotb.test
+async def test_offload_result(dut):
+    """The result is returned in the ReadWrite phase of the awaiting step."""
+    await Timer(1, "ns")
+    start = get_sim_time("step")
+
+    call = Offload(add, 2, 3, scale=4)
+    assert await call == 20
+    assert get_sim_time("step") == start
+    assert cocotb.sim_phase is cocotb.SimPhase.READ_WRITE
+
+    # The result can be awaited again
+    assert await call == 20
+    assert call.done()
+    assert repr(call).startswith(f"<Offload of {add!r} at ")
+
+
+@cocotb.test
+async def test_offload_results_in_order(dut):
+    """Each call returns its own result, whatever order they finish in."""
+    calls = [Offload(add, i, i) for i in range(16)]
+    await Timer(1, "ns")
+    assert [await call for call in calls] == [2 * i for i in range(16)]
+    assert simulator.get_num_worker_threads() == 2
+
+
+@cocotb.test
+async def test_offload_runs_in_parallel(dut):
+    """Calls run on the two threads of the pool at the same time."""
+    barrier = threading.Barrier(2, timeout=10)
+
+    def meet(i):
+        barrier.wait()
+        return i
+
+    first = Offload(meet, 1)
+    second = Offload(meet, 2)
+    assert await first == 1
+    assert await second == 2
+
+
+@cocotb.test
+async def test_offload_while_simulating(dut):
+    """The simulation continues while the call runs."""
+    release = threading.Event()
+
+    def wait_for_release():
+        return release.wait(timeout=10)
+
+    call = Offload(wait_for_release)
+    await Timer(10, "ns")
+    assert not call.done()
+
+    release.set()
+    assert await call is True
+    assert call.done()
+
+
+@cocotb.test
+async def test_offload_exception(dut):
+    """The exception raised by the call is raised by ``await``."""
+    call = Offload(fail, "from the worker")
+    with pytest.raises(ValueError, match="from the worker"):
+        await call
+    assert call.done()
+
+    with pytest.raises(TypeError):
+        simulator.submit_work(1)
+
+
+@cocotb.test
+async def test_offload_in_read_only(dut):
+    """``await`` raises in the ReadOnly phase, where the result can't be delivered."""
+    await ReadOnly()
+    call = Offload(add, 1, 1)
+    with pytest.raises(RuntimeError):
+        await call
+
+    await Timer(1, "ns")
+    assert await call == 2
@@ -0,0 +1,63 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Checks the profile written while running test_profiler.py."""
+
+import json
+import sys
+
+
+def main(profile_path, marks_path):
+    with open(profile_path) as f:
+        profile = json.load(f)
+    with open(marks_path) as f:
+        marks = json.load(f)
+
+    assert profile["displayTimeUnit"] == "ns"
+    assert isinstance(profile["otherData"]["sim_time_precision"], int)
+
+    events = profile["traceEvents"]
+    metadata = [event["name"] for event in events if event["ph"] == "M"]
+    assert metadata == ["thread_name", "process_name"]
+
+    stack = []
+    categories = set()
+    last_ts = 0.0
+    sim_time = None
+    found_marks = []
+    for event in events:
+        if event["ph"] == "M":
+            continue
+        assert event["ts"] >= last_ts
+        last_ts = event["ts"]
+
+        if event["ph"] == "C":
+            assert event["name"] == "sim_time"
+            assert sim_time is None or event["args"]["value"] > sim_time
+            sim_time = event["args"]["value"]
+        elif event["ph"] == "B":
+            categories.add(event["cat"])
+            if event["cat"] == "callback":
+                assert event["args"]["sim_time"] == sim_time
+            if event["name"].startswith("mark"):
+                callback = next(e for e in stack if e["cat"] == "callback")
+                task = stack[-1]
+                assert task["cat"] == "task"
+                assert "test_profile_slices" in task["name"]
+                found_marks.append((event["name"], callback["args"]["sim_time"]))
+            if event["name"] == "write":
+                assert stack[-1]["name"].startswith("mark")
+            stack.append(event)
+        else:
+            assert event["ph"] == "E"
+            stack.pop()
+
+    # The profiler closes the slices still open at the end of the simulation
+    assert stack == []
+    assert {"simulator", "callback", "python", "task", "trigger", "gpi"} <= categories
+    assert found_marks == [(f'mark "{i}"', mark) for i, mark in enumerate(marks)]
+
+
+if __name__ == "__main__":
+    main(*sys.argv[1:])
@@ -0,0 +1,31 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Adds slices to the profile of the simulation, checked by check_profile.py."""
+
+import json
+
+import cocotb
+from cocotb import simulator
+from cocotb.triggers import Timer
+from cocotb.utils import get_sim_time
+
+
+@cocotb.test
+async def test_profile_slices(dut):
+    """Slices begun by the user are nested in the task running them."""
+    assert simulator.is_profile_enabled()
+
+    marks = []
+    for i in range(3):
+        await Timer(10, "ns")
+        marks.append(get_sim_time("step"))
+        simulator.profile_begin(f'mark "{i}"', "test")
+        simulator.profile_begin("write", "test")
+        dut.stream_in_data.value = i
+        simulator.profile_end()
+        simulator.profile_end()
+
+    with open("marks.json", "w") as f:
+        json.dump(marks, f)
@@ -0,0 +1,164 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests the writes queued in the GPI until the ReadWrite phase."""
+
+from collections import OrderedDict
+
+import pytest
+
+import cocotb
+from cocotb import simulator
+from cocotb.handle import _GPISetAction
+from cocotb.triggers import ReadOnly, ReadWrite, Timer
+from cocotb.types import LogicArray
+
+SIM_NAME = cocotb.SIM_NAME.lower()
+
+
+def scheduler_order(writes):
+    """The order the old Python write scheduler applied *writes* in.
+
+    Writing to a handle again moved it to the end of an ``OrderedDict``, which
+    was applied oldest to newest.
+    """
+    pending = OrderedDict()
+    for name, value in writes:
+        if name in pending:
+            del pending[name]
+        pending[name] = value
+    return list(pending.items())
+
+
+@cocotb.test
+async def test_writes_are_coalesced(dut):
+    """Only the last write to each handle is queued and applied."""
+    await Timer(1, "ns")
+
+    dut.stream_in_data.value = 1
+    dut.stream_in_data.value = 2
+    dut.stream_in_valid.value = 1
+    assert simulator.get_num_queued_writes() == 2
+
+    await ReadWrite()
+    assert simulator.get_num_queued_writes() == 0
+    await ReadOnly()
+    assert dut.stream_in_data.value == 2
+    assert dut.stream_in_valid.value == 1
+
+
+@cocotb.test
+async def test_last_write_wins_across_kinds(dut):
+    """A write supersedes a queued write of another kind to the same handle."""
+    await Timer(1, "ns")
+
+    dut.stream_in_data.value = 5
+    dut.stream_in_data.value = LogicArray("00001100")
+    dut.stream_in_data_wide.value = 1 << 40
+    dut.stream_in_data_wide.value = 7
+    assert simulator.get_num_queued_writes() == 2
+
+    await ReadOnly()
+    assert dut.stream_in_data.value == 12
+    assert dut.stream_in_data_wide.value == 7
+
+
+@cocotb.test
+async def test_apply_and_clear_counts(dut):
+    """Applying returns the writes performed, clearing drops them."""
+    data = dut.stream_in_data._handle
+    valid = dut.stream_in_valid._handle
+    dut.stream_in_data.value = 0
+    dut.stream_in_valid.value = 0
+    await Timer(1, "ns")
+
+    assert simulator.apply_queued_writes() == 0
+
+    data.queue_signal_val_int(_GPISetAction.DEPOSIT, 3)
+    data.queue_signal_val_int(_GPISetAction.DEPOSIT, 4)
+    valid.queue_signal_val_int(_GPISetAction.DEPOSIT, 1)
+    assert simulator.get_num_queued_writes() == 2
+    assert simulator.apply_queued_writes() == 2
+    assert simulator.get_num_queued_writes() == 0
+    assert simulator.apply_queued_writes() == 0
+
+    await ReadOnly()
+    assert dut.stream_in_data.value == 4
+    assert dut.stream_in_valid.value == 1
+    await Timer(1, "ns")
+
+    data.queue_signal_val_int(_GPISetAction.DEPOSIT, 9)
+    valid.queue_signal_val_binstr(_GPISetAction.DEPOSIT, "0")
+    simulator.clear_queued_writes()
+    assert simulator.get_num_queued_writes() == 0
+    assert simulator.apply_queued_writes() == 0
+
+    await Timer(1, "ns")
+    assert dut.stream_in_data.value == 4
+    assert dut.stream_in_valid.value == 1
+
+
+# Verilator runs value change callbacks in the order they were registered
+@cocotb.test(skip=SIM_NAME.startswith("verilator"))
+async def test_write_order(dut):
+    """Queued writes are applied in the order of the old Python scheduler."""
+    signals = {
+        "stream_in_data": dut.stream_in_data,
+        "stream_in_valid": dut.stream_in_valid,
+        "stream_in_data_dword": dut.stream_in_data_dword,
+    }
+    for signal in signals.values():
+        signal.value = 0
+    await Timer(1, "ns")
+
+    writes = [
+        ("stream_in_data", 1),
+        ("stream_in_valid", 1),
+        ("stream_in_data_dword", 1),
+        ("stream_in_data", 2),
+        ("stream_in_valid", 0),
+        ("stream_in_valid", 1),
+    ]
+    expected = scheduler_order(writes)
+    assert [name for name, _ in expected] == [
+        "stream_in_data_dword",
+        "stream_in_data",
+        "stream_in_valid",
+    ]
+
+    changes = []
+    for name in reversed(list(signals)):
+        simulator.register_value_change_callback(
+            signals[name]._handle, changes.append, simulator.VALUE_CHANGE, name
+        )
+    for name, value in writes:
+        signals[name].value = value
+
+    await ReadOnly()
+    assert changes == [name for name, _ in expected]
+    for name, value in expected:
+        assert signals[name].value == value
+
+
+@cocotb.test
+async def test_write_in_read_write_is_not_queued(dut):
+    """Writes made in the ReadWrite phase are performed immediately."""
+    await ReadWrite()
+    dut.stream_in_data.value = 6
+    assert simulator.get_num_queued_writes() == 0
+    await ReadOnly()
+    assert dut.stream_in_data.value == 6
+
+
+@cocotb.test
+async def test_write_in_read_only_raises(dut):
+    """Writes cannot be scheduled in the ReadOnly phase."""
+    dut.stream_in_data.value = 1
+    await ReadOnly()
+    with pytest.raises(Exception, match="read-only sync phase"):
+        dut.stream_in_data.value = 2
+    assert simulator.get_num_queued_writes() == 0
+
+    await Timer(1, "ns")
+    assert dut.stream_in_data.value == 1
@@ -0,0 +1,140 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests recording value changes with a GpiRecorder."""
+
+import struct
+
+import pytest
+
+import cocotb
+from cocotb import simulator
+from cocotb.triggers import Timer
+from cocotb.types import LogicArray
+from cocotb.utils import get_sim_time
+
+# Verilator is 2-state, so X bits can't be recorded
+two_state = cocotb.SIM_NAME.lower().startswith("verilator")
+
+
+def decode(recorder, records):
+    """Turn the columns of records into a list of (time, index, (aval, bval))."""
+    # The columns are in native byte order
+    times, ids, values = records
+    n = len(ids) // 4
+    stride = recorder.get_value_words()
+    times = struct.unpack(f"={n}Q", times)
+    ids = struct.unpack(f"={n}I", ids)
+    words = struct.unpack(f"={2 * n * stride}I", values)
+    result = []
+    for i in range(n):
+        value = words[2 * stride * i : 2 * stride * (i + 1)]
+        aval = sum(w << (32 * j) for j, w in enumerate(value[0::2]))
+        bval = sum(w << (32 * j) for j, w in enumerate(value[1::2]))
+        result.append((times[i], ids[i], (aval, bval)))
+    return result
+
+
+@cocotb.test
+async def test_record_changes(dut):
+    """The initial values, then every change, are recorded in time order."""
+    dut.stream_in_data.value = 0
+    dut.stream_in_data_wide.value = 1
+    await Timer(1, "ns")
+
+    recorder = simulator.recorder_create(
+        [dut.stream_in_data._handle, dut.stream_in_data_wide._handle]
+    )
+    assert recorder.get_num_signals() == 2
+    # Padded to the 2 words of the widest signal
+    assert recorder.get_value_words() == 2
+
+    recorder.start()
+    write_times = [get_sim_time()] * 2
+    for signal, value in (
+        (dut.stream_in_data, 5),
+        (dut.stream_in_data_wide, (1 << 40) | 3),
+        (dut.stream_in_data, 6),
+    ):
+        await Timer(1, "ns")
+        # Recorded when the write is applied, in the same time step
+        write_times.append(get_sim_time())
+        signal.value = value
+    await Timer(1, "ns")
+    recorder.stop()
+    dut.stream_in_data.value = 7
+    await Timer(1, "ns")
+
+    assert recorder.get_num_records() == 5
+    records = decode(recorder, recorder.drain())
+    assert records == [
+        (write_times[0], 0, (0, 0)),
+        (write_times[1], 1, (1, 0)),
+        (write_times[2], 0, (5, 0)),
+        (write_times[3], 1, ((1 << 40) | 3, 0)),
+        (write_times[4], 0, (6, 0)),
+    ]
+    assert recorder.get_num_records() == 0
+
+
+@cocotb.test
+async def test_query_window(dut):
+    """A query returns the records in [start, end) and keeps them."""
+    dut.stream_in_data.value = 0
+    await Timer(1, "ns")
+
+    recorder = simulator.recorder_create([dut.stream_in_data._handle])
+    recorder.start()
+    times = [get_sim_time()]
+    for value in range(1, 5):
+        await Timer(1, "ns")
+        times.append(get_sim_time())
+        dut.stream_in_data.value = value
+    await Timer(1, "ns")
+    recorder.stop()
+
+    records = decode(recorder, recorder.query(times[1], times[3]))
+    assert [v for _, _, (v, _) in records] == [1, 2]
+    assert decode(recorder, recorder.query(times[3], times[1])) == []
+    assert recorder.get_num_records() == 5
+
+
+@cocotb.test(skip=two_state)
+async def test_record_unresolved(dut):
+    """X and Z bits are recorded in the mask."""
+    dut.stream_in_data.value = 0
+    await Timer(1, "ns")
+
+    recorder = simulator.recorder_create([dut.stream_in_data._handle])
+    recorder.start()
+    dut.stream_in_data.value = LogicArray("XXXXZZZZ")
+    await Timer(1, "ns")
+    recorder.stop()
+
+    records = decode(recorder, recorder.drain())
+    assert [v for _, _, v in records] == [(0, 0), (0xF0, 0xFF)]
+
+
+@cocotb.test
+async def test_recorder_errors(dut):
+    """Only logic signals can be recorded, and starting twice is harmless."""
+    with pytest.raises(TypeError):
+        simulator.recorder_create([dut.stream_in_data._handle, None])
+
+    recorder = simulator.recorder_create([dut.stream_in_data._handle])
+    recorder.start()
+    recorder.start()
+    recorder.stop()
+    recorder.stop()
+    assert recorder.get_num_records() == 1
+
+
+# Icarus and GHDL are unable to find real signals (gh-2589, gh-2590)
+@cocotb.test(skip=cocotb.SIM_NAME.lower().startswith(("icarus", "ghdl")))
+async def test_recorder_rejects_real(dut):
+    """Signals without a packed value can't be recorded."""
+    with pytest.raises(TypeError, match="logic signal"):
+        simulator.recorder_create(
+            [dut.stream_in_data._handle, dut.stream_in_real._handle]
+        )
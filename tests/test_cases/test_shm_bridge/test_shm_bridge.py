@@ -0,0 +1,224 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests the shared-memory transactor bridge, acting as its external process.
+
+The layout of the shared memory is that of ``cocotb_shm_bridge.h``.
+"""
+
+import mmap
+import os
+import struct
+
+import cocotb
+from cocotb import shm_bridge
+from cocotb.clock import Clock
+from cocotb.triggers import ReadOnly, RisingEdge, Timer
+from cocotb.utils import get_sim_time
+
+MAGIC = 0x676469726268736D
+TXN_EXCEPTION = 1
+
+# Offsets in the header
+TO_SIM_HEAD = 64
+TO_SIM_TAIL = 128
+FROM_SIM_HEAD = 192
+FROM_SIM_TAIL = 256
+HEADER_SIZE = 320
+SLOT_HEADER = struct.Struct("<QII")
+
+
+class Peer:
+    """The external process side of the bridge."""
+
+    def __init__(self, name):
+        fd = os.open("/dev/shm" + name, os.O_RDWR)
+        try:
+            self.mem = mmap.mmap(fd, os.fstat(fd).st_size)
+        finally:
+            os.close(fd)
+        (
+            self.magic,
+            self.version,
+            self.num_slots,
+            self.slot_size,
+            self.ready,
+            self.sim_pid,
+        ) = struct.unpack_from("<QIIIII", self.mem, 0)
+        struct.pack_into("<I", self.mem, 28, os.getpid())
+
+    def _index(self, offset):
+        return struct.unpack_from("<Q", self.mem, offset)[0]
+
+    def _slot(self, ring, index):
+        offset = HEADER_SIZE + (index % self.num_slots) * self.slot_size
+        if ring == "from_sim":
+            offset += self.num_slots * self.slot_size
+        return offset
+
+    @property
+    def max_words(self):
+        return (self.slot_size - SLOT_HEADER.size) // 4
+
+    def send(self, words, flags=0, n_words=None):
+        """Send *words*, claiming there are *n_words* of them if given."""
+        head = self._index(TO_SIM_HEAD)
+        assert head - self._index(TO_SIM_TAIL) < self.num_slots
+        offset = self._slot("to_sim", head)
+        if n_words is None:
+            n_words = len(words)
+        SLOT_HEADER.pack_into(self.mem, offset, 0, flags, n_words)
+        struct.pack_into(f"<{len(words)}I", self.mem, offset + 16, *words)
+        struct.pack_into("<Q", self.mem, TO_SIM_HEAD, head + 1)
+
+    def pending(self):
+        return self._index(TO_SIM_HEAD) - self._index(TO_SIM_TAIL)
+
+    def receive(self):
+        """Get the (time, flags, words) of all the transactions from the bridge."""
+        txns = []
+        tail = self._index(FROM_SIM_TAIL)
+        head = self._index(FROM_SIM_HEAD)
+        for index in range(tail, head):
+            offset = self._slot("from_sim", index)
+            time, flags, n_words = SLOT_HEADER.unpack_from(self.mem, offset)
+            words = struct.unpack_from(f"<{n_words}I", self.mem, offset + 16)
+            txns.append((time, flags, list(words)))
+        struct.pack_into("<Q", self.mem, FROM_SIM_TAIL, head)
+        return txns
+
+
+peer = Peer(os.environ["GPI_SHM_BRIDGE"])
+
+
+def stats_delta(before):
+    after = shm_bridge.get_stats()
+    return {name: after[name] - before[name] for name in after}
+
+
+async def run_edges(dut, n):
+    """Clock the design for *n* rising edges.
+
+    Returns the time of each edge and the value driven onto ``stream_in_data`` by then.
+    """
+    clock = cocotb.start_soon(Clock(dut.clk, 10, "ns").start(start_high=False))
+    edges = []
+    for _ in range(n):
+        await RisingEdge(dut.clk)
+        time = get_sim_time("step")
+        await ReadOnly()
+        edges.append((time, int(dut.stream_in_data.value)))
+    clock.kill()
+    await Timer(1, "ns")
+    return edges
+
+
+@cocotb.test
+async def test_header(dut):
+    """The bridge initializes the shared memory before the tests start."""
+    assert peer.magic == MAGIC
+    assert peer.version == 1
+    assert peer.ready == 1
+    assert peer.sim_pid == os.getpid()
+    assert peer.num_slots == 16
+    assert peer.slot_size >= 256
+    assert peer.slot_size % 8 == 0
+    assert peer.pending() == 0
+    assert peer.receive() == []
+
+
+@cocotb.test
+async def test_drive_and_sample(dut):
+    """One transaction is taken per edge, and samples are taken before it is driven."""
+    dut.stream_in_data.value = 0
+    await Timer(1, "ns")
+    before = shm_bridge.get_stats()
+    shm_bridge.set_exception_handler(lambda payload: payload + bytes([3, 0, 0, 0]))
+
+    peer.send([0x11, 0])
+    peer.send([0x22, 0])
+    peer.send([1, 2], flags=TXN_EXCEPTION)
+    # Of the wrong size, so dropped
+    peer.send([0x44, 0, 0, 0])
+    peer.send([0x33, 0])
+
+    edges = await run_edges(dut, 6)
+    assert [value for _, value in edges] == [0x11, 0x22, 0x22, 0x22, 0x33, 0x33]
+    assert peer.pending() == 0
+
+    times = [time for time, _ in edges]
+    assert peer.receive() == [
+        (times[0], 0, [0x00, 0]),
+        (times[1], 0, [0x11, 0]),
+        (times[2], 0, [0x22, 0]),
+        (times[2], TXN_EXCEPTION, [1, 2, 3]),
+        (times[3], 0, [0x22, 0]),
+        (times[4], 0, [0x22, 0]),
+        (times[5], 0, [0x33, 0]),
+    ]
+    assert stats_delta(before) == {
+        "driven": 3,
+        "sampled": 6,
+        "exceptions": 1,
+        "full_waits": 0,
+        "errors": 1,
+    }
+
+
+@cocotb.test
+async def test_exception_handler_failures(dut):
+    """Exceptions get no response if the handler fails or none is set."""
+
+    def raise_error(payload):
+        raise ValueError("handler failed")
+
+    before = shm_bridge.get_stats()
+    handlers = [raise_error, lambda payload: b"abc", lambda payload: None, None]
+    for handler in handlers:
+        shm_bridge.set_exception_handler(handler)
+        peer.send([4], flags=TXN_EXCEPTION)
+        edges = await run_edges(dut, 1)
+        assert peer.pending() == 0
+        assert peer.receive() == [(edges[0][0], 0, [0x33, 0])]
+
+    assert stats_delta(before) == {
+        "driven": 0,
+        "sampled": 4,
+        "exceptions": 4,
+        "full_waits": 0,
+        "errors": 1,
+    }
+
+
+@cocotb.test
+async def test_exception_oversized(dut):
+    """Exceptions and responses larger than a slot are dropped."""
+    before = shm_bridge.get_stats()
+    handled = []
+
+    def handler(payload):
+        handled.append(payload)
+        return bytes(4 * (peer.max_words + 1))
+
+    shm_bridge.set_exception_handler(handler)
+    # Claims to continue past the end of its slot
+    peer.send([5], flags=TXN_EXCEPTION, n_words=peer.max_words + 1)
+    edges = await run_edges(dut, 1)
+    assert peer.receive() == [(edges[0][0], 0, [0x33, 0])]
+    assert handled == []
+
+    # The response does not fit in a slot
+    peer.send([6], flags=TXN_EXCEPTION)
+    edges = await run_edges(dut, 1)
+    assert peer.receive() == [(edges[0][0], 0, [0x33, 0])]
+    assert handled == [bytes([6, 0, 0, 0])]
+    assert peer.pending() == 0
+
+    assert stats_delta(before) == {
+        "driven": 0,
+        "sampled": 2,
+        "exceptions": 2,
+        "full_waits": 0,
+        "errors": 1,
+    }
@@ -0,0 +1,84 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests reading and writing the signals of a GpiSignalGroup at once."""
+
+from array import array
+
+import pytest
+
+import cocotb
+from cocotb import simulator
+from cocotb.handle import _GPISetAction
+from cocotb.triggers import Timer
+
+
+def make_group(dut):
+    signals = [dut.stream_in_data, dut.stream_in_data_dword, dut.stream_in_valid]
+    return simulator.signal_group_create([s._handle for s in signals])
+
+
+@cocotb.test
+async def test_group_sizes(dut):
+    """The group reports its members and the size of their packed values."""
+    group = make_group(dut)
+    assert group.get_num_signals() == 3
+    # 1, 4 and 1 bytes of value, each followed by as many bytes of mask
+    assert group.get_packed_size() == 2 * (1 + 4 + 1)
+
+
+@cocotb.test
+async def test_group_int(dut):
+    """Ints are written to and read from the members in order."""
+    group = make_group(dut)
+    group.write_int(_GPISetAction.DEPOSIT, array("q", [0x5A, 0x1234_5678, 1]))
+    await Timer(1, "ns")
+
+    assert dut.stream_in_data.value == 0x5A
+    assert dut.stream_in_data_dword.value == 0x1234_5678
+    assert dut.stream_in_valid.value == 1
+
+    dut.stream_in_data.value = 0xA5
+    dut.stream_in_data_dword.value = 7
+    dut.stream_in_valid.value = 0
+    await Timer(1, "ns")
+
+    values = array("q", [-1, -1, -1])
+    group.read_int_into(values)
+    assert list(values) == [0xA5, 7, 0]
+
+
+@cocotb.test
+async def test_group_bytes(dut):
+    """Packed values are laid out per member, each value before its mask."""
+    group = make_group(dut)
+    packed = bytes([0x3C, 0]) + (0xCAFE_F00D).to_bytes(4, "little") + bytes(4)
+    packed += bytes([1, 0])
+    group.write_bytes(_GPISetAction.DEPOSIT, packed)
+    await Timer(1, "ns")
+
+    assert dut.stream_in_data.value == 0x3C
+    assert dut.stream_in_data_dword.value == 0xCAFE_F00D
+    assert dut.stream_in_valid.value == 1
+
+    buf = bytearray(group.get_packed_size())
+    group.read_bytes_into(buf)
+    assert buf == packed
+
+
+@cocotb.test
+async def test_group_errors(dut):
+    """Members must be handles, and buffers and values must fit."""
+    with pytest.raises(TypeError):
+        simulator.signal_group_create([dut.stream_in_data._handle, 1])
+
+    group = make_group(dut)
+    with pytest.raises(ValueError):
+        group.read_int_into(array("q", [0, 0]))
+    with pytest.raises(ValueError):
+        group.read_bytes_into(bytearray(group.get_packed_size() - 1))
+    with pytest.raises(ValueError):
+        group.write_bytes(_GPISetAction.DEPOSIT, bytes(3))
+    with pytest.raises(OverflowError):
+        group.write_int(_GPISetAction.DEPOSIT, array("q", [0, 1 << 40, 0]))
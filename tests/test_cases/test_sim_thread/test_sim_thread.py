@@ -0,0 +1,60 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests the simulator can only be accessed from the thread running cocotb."""
+
+import threading
+
+import cocotb
+from cocotb import simulator
+
+
+def call_in_thread(func, *args):
+    """Call *func* in another thread, returning the exception it raised."""
+    errors = []
+
+    def run():
+        try:
+            func(*args)
+        except BaseException as e:
+            errors.append(e)
+
+    thread = threading.Thread(target=run)
+    thread.start()
+    thread.join()
+    return errors[0] if errors else None
+
+
+@cocotb.test
+async def test_calls_off_sim_thread(dut):
+    """Calls reaching the GPI raise RuntimeError from other threads."""
+    handle = dut._handle
+    calls = [
+        (simulator.get_precision,),
+        (simulator.get_sim_time,),
+        (simulator.get_simulator_product,),
+        (simulator.clear_queued_writes,),
+        (simulator.get_stats,),
+        (simulator.set_stats_enabled, False),
+        (handle.get_name_string,),
+        (handle.get_handle_by_name, "clk"),
+    ]
+    for call in calls:
+        error = call_in_thread(*call)
+        assert isinstance(error, RuntimeError), call[0]
+        assert "thread running cocotb" in str(error)
+
+    # Still usable from the thread running cocotb
+    assert handle.get_name_string() == dut._name
+    assert isinstance(simulator.get_precision(), int)
+
+
+@cocotb.test
+async def test_handle_compare_off_sim_thread(dut):
+    """Handles can be compared from other threads."""
+    handle = dut.clk._handle
+    results = []
+    call_in_thread(lambda: results.append(handle == dut.clk._handle))
+    assert results == [True]
+    assert isinstance(call_in_thread(handle.get_type), RuntimeError)
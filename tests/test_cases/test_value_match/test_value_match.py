@@ -0,0 +1,126 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests the ValueMatch trigger."""
+
+import pytest
+
+import cocotb
+from cocotb.clock import Clock
+from cocotb.triggers import (
+    FallingEdge,
+    RisingEdge,
+    SimTimeoutError,
+    Timer,
+    ValueMatch,
+    with_timeout,
+)
+from cocotb.types import LogicArray
+from cocotb.utils import get_sim_time
+
+# Verilator is 2-state, so X bits read back as 0
+two_state = cocotb.SIM_NAME.lower().startswith("verilator")
+
+
+async def write_sequence(signal, values, write_times):
+    for value in values:
+        await Timer(1, "ns")
+        write_times.append(get_sim_time())
+        signal.value = value
+
+
+@cocotb.test
+async def test_match_on_change(dut):
+    """The trigger fires at the first change to the value."""
+    dut.stream_in_data.value = 0
+    await Timer(1, "ns")
+
+    write_times = []
+    cocotb.start_soon(write_sequence(dut.stream_in_data, [1, 2, 3, 4], write_times))
+    await ValueMatch(dut.stream_in_data, 3)
+    assert get_sim_time() == write_times[2]
+    assert dut.stream_in_data.value == 3
+
+
+@cocotb.test
+async def test_match_mask_and_negate(dut):
+    """Only the bits in the mask are compared, and negate inverts the match."""
+    dut.stream_in_data.value = 0
+    await Timer(1, "ns")
+
+    write_times = []
+    values = [0x01, 0x7F, 0x81, 0x00, 0x02]
+    cocotb.start_soon(write_sequence(dut.stream_in_data, values, write_times))
+
+    await ValueMatch(dut.stream_in_data, 0x80, mask=0x80)
+    assert get_sim_time() == write_times[2]
+    await ValueMatch(dut.stream_in_data, 0, mask=0x0F)
+    assert get_sim_time() == write_times[3]
+    await ValueMatch(dut.stream_in_data, 0, negate=True)
+    assert get_sim_time() == write_times[4]
+
+
+@cocotb.test
+async def test_match_on_edge(dut):
+    """With an edge, the value is only compared on that edge of the clock."""
+    dut.stream_in_data.value = 0
+    cocotb.start_soon(Clock(dut.clk, 10, "ns").start())
+    await FallingEdge(dut.clk)
+
+    async def write_between_edges():
+        await Timer(2, "ns")
+        dut.stream_in_data.value = 5
+        await Timer(2, "ns")
+        dut.stream_in_data.value = 6
+        await RisingEdge(dut.clk)
+        await Timer(2, "ns")
+        dut.stream_in_data.value = 5
+
+    cocotb.start_soon(write_between_edges())
+    start = get_sim_time("ns")
+    await ValueMatch(dut.stream_in_data, 5, edge=RisingEdge(dut.clk))
+    # Not at the write 2ns after the falling edge, nor at the first rising edge
+    assert get_sim_time("ns") == start + 15
+    assert dut.clk.value == 1
+
+
+@cocotb.test
+async def test_match_not_checked_when_awaited(dut):
+    """A value which already matches only fires at the next matching change."""
+    dut.stream_in_data.value = 3
+    await Timer(1, "ns")
+
+    with pytest.raises(SimTimeoutError):
+        await with_timeout(ValueMatch(dut.stream_in_data, 3), 10, "ns")
+
+    cocotb.start_soon(write_sequence(dut.stream_in_data, [4, 3], []))
+    await with_timeout(ValueMatch(dut.stream_in_data, 3), 10, "ns")
+
+
+@cocotb.test(skip=two_state)
+async def test_match_unresolved(dut):
+    """Compared bits which are X or Z never match, bits masked out are ignored."""
+    dut.stream_in_data.value = 0xFF
+    await Timer(1, "ns")
+
+    write_times = []
+    values = [LogicArray("0000XXXX"), LogicArray("ZZZZ0000"), LogicArray("00000000")]
+    cocotb.start_soon(write_sequence(dut.stream_in_data, values, write_times))
+    await ValueMatch(dut.stream_in_data, 0, mask=0x0F)
+    assert get_sim_time() == write_times[1]
+
+
+@cocotb.test
+async def test_match_errors(dut):
+    """The signal must be a logic object, and the value and mask fit it."""
+    with pytest.raises(TypeError):
+        ValueMatch(dut, 0)
+    with pytest.raises(ValueError):
+        ValueMatch(dut.stream_in_data, 0x100)
+    with pytest.raises(ValueError):
+        ValueMatch(dut.stream_in_data, 0, mask=-1)
+
+    trigger = ValueMatch(dut.stream_in_data, 1, mask=3, negate=True)
+    expected = f"ValueMatch({dut.stream_in_data!r}, 1, mask=3, negate=True)"
+    assert repr(trigger) == expected
@@ -0,0 +1,57 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests saving a checkpoint of the design and starting a simulation from it.
+
+On Verilator, ``save_after_reset`` and ``start_from_checkpoint`` are run
+in two simulations, the second restoring the checkpoint saved by the first.
+"""
+
+import os
+
+import pytest
+
+import cocotb
+from cocotb import simulator
+from cocotb.triggers import Timer
+from cocotb.utils import get_sim_time
+
+
+async def clock_in(dut, value):
+    """Register *value* on a rising edge of the clock."""
+    dut.stream_in_data.value = value
+    dut.clk.value = 0
+    await Timer(5, "ns")
+    dut.clk.value = 1
+    await Timer(5, "ns")
+
+
+@cocotb.test
+async def save_after_reset(dut):
+    """The state of the design is saved at the end of the time step."""
+    await clock_in(dut, 0xA5)
+    assert dut.stream_out_data_registered.value == 0xA5
+    simulator.save_checkpoint(os.environ["CHECKPOINT"])
+    await Timer(1, "ns")
+    assert os.path.isfile(os.environ["CHECKPOINT"])
+
+
+@cocotb.test
+async def start_from_checkpoint(dut):
+    """The simulation starts with the state and at the time of the checkpoint."""
+    assert get_sim_time("ns") == 10
+    assert dut.stream_in_data.value == 0xA5
+    assert dut.stream_out_data_registered.value == 0xA5
+
+    # The restored design runs on from there
+    await clock_in(dut, 0x5A)
+    assert dut.stream_out_data_registered.value == 0x5A
+
+
+@cocotb.test
+async def save_unsupported(dut):
+    """Simulators which can't save checkpoints raise an error."""
+    with pytest.raises(RuntimeError, match="cannot save checkpoints"):
+        simulator.save_checkpoint(os.environ["CHECKPOINT"])
+    assert not os.path.exists(os.environ["CHECKPOINT"])
@@ -0,0 +1,109 @@
+# Copyright cocotb contributors
+# Licensed under the Revised BSD License, see LICENSE for details.
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""Tests accessing Verilator signals in place in the model.
+
+Run with and without ``--no-direct-access``, which should give the same results.
+"""
+
+import cocotb
+from cocotb.handle import _GPISetAction
+from cocotb.triggers import ReadOnly, ReadWrite, Timer
+
+
+def packed(aval, bval, n_bytes):
+    """The bytes of a value with the *aval* and *bval* words of a 4-state value."""
+    return aval.to_bytes(n_bytes, "little") + bval.to_bytes(n_bytes, "little")
+
+
+@cocotb.test
+async def test_widths(dut):
+    """Values of each storage size of the model are written and read back."""
+    values = [
+        (dut.stream_in_data, 0xA5),
+        (dut.stream_in_data_dword, 0xDEADBEEF),
+        (dut.stream_in_data_39bit, (1 << 38) | 0x123456789),
+        (dut.stream_in_data_wide, 0xFEDCBA9876543210),
+        (dut.stream_in_data_dqword, (0x0123456789ABCDEF << 64) | 0xFEDCBA9876543210),
+    ]
+    for signal, value in values:
+        signal.value = value
+    await ReadOnly()
+    for signal, value in values:
+        assert signal.value == value
+
+    # The model is evaluated after the write
+    assert dut.stream_out_data_comb.value == 0xA5
+    await Timer(1, "ns")
+
+    for signal, _ in values:
+        signal.value = 0
+    await ReadOnly()
+    for signal, _ in values:
+        assert signal.value == 0
+        assert signal._handle.get_signal_val_binstr() == "0" * len(signal)
+
+
+@cocotb.test
+async def test_int_writes_are_truncated(dut):
+    """Integers are sign extended and truncated to the size of the signal."""
+    hdl = dut.stream_in_data._handle
+    hdl.set_signal_val_int(_GPISetAction.DEPOSIT, -1)
+    await ReadOnly()
+    assert dut.stream_in_data.value == 0xFF
+    await Timer(1, "ns")
+
+    hdl.set_signal_val_int(_GPISetAction.DEPOSIT, 0x1234)
+    await ReadOnly()
+    assert dut.stream_in_data.value == 0x34
+
+
+@cocotb.test
+async def test_binstr_writes(dut):
+    """Binary strings are written most significant bit first."""
+    dut.stream_in_data_39bit._handle.set_signal_val_binstr(
+        _GPISetAction.DEPOSIT, "1" + "0" * 37 + "1"
+    )
+    await ReadOnly()
+    assert dut.stream_in_data_39bit.value == (1 << 38) | 1
+
+
+@cocotb.test
+async def test_no_delay_writes(dut):
+    """Writes with no delay are seen at once."""
+    await ReadWrite()
+    dut.stream_in_data_dword._handle.set_signal_val_int(
+        _GPISetAction.NO_DELAY, 0x600D
+    )
+    assert dut.stream_in_data_dword.value == 0x600D
+
+
+@cocotb.test
+async def test_last_write_wins(dut):
+    """Writes of a time step through VPI and directly are applied in order.
+
+    Values with X or Z bits go through VPI, which only writes their aval bits.
+    """
+    hdl = dut.stream_in_data._handle
+    await Timer(1, "ns")
+
+    await ReadWrite()
+    hdl.set_signal_val_int(_GPISetAction.DEPOSIT, 0x12)
+    hdl.set_signal_val_bytes(_GPISetAction.DEPOSIT, 8, packed(0x1F, 0x0F, 1))
+    await ReadOnly()
+    assert dut.stream_in_data.value == 0x1F
+    await Timer(1, "ns")
+
+    await ReadWrite()
+    hdl.set_signal_val_bytes(_GPISetAction.DEPOSIT, 8, packed(0x2F, 0x0F, 1))
+    hdl.set_signal_val_int(_GPISetAction.DEPOSIT, 0x21)
+    await ReadOnly()
+    assert dut.stream_in_data.value == 0x21
+    await Timer(1, "ns")
+
+    await ReadWrite()
+    hdl.set_signal_val_int(_GPISetAction.DEPOSIT, 0x31)
+    hdl.set_signal_val_int(_GPISetAction.DEPOSIT, 0x32)
+    await ReadOnly()
+    assert dut.stream_in_data.value == 0x32